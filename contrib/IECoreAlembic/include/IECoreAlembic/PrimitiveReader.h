@@ -50,6 +50,10 @@ class PrimitiveReader : public ObjectReader
 	protected :
 
 		void readArbGeomParams( const Alembic::Abc::ICompoundProperty &params, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive ) const;
+		/// As above, but outputs to a PrimitiveVariableMap, so that the params
+		/// may be read before the primitive itself has been constructed. The
+		/// individual params are read in parallel.
+		void readArbGeomParams( const Alembic::Abc::ICompoundProperty &params, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::PrimitiveVariableMap &variables ) const;
 
 		template<typename T>
 		void readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive ) const;
@@ -57,8 +61,17 @@ class PrimitiveReader : public ObjectReader
 		template<typename T>
 		void readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive, const std::string &primitiveVariableName ) const;
 
+		/// Returns a PrimitiveVariable with null data if the param
+		/// can not be converted.
+		template<typename T>
+		IECoreScene::PrimitiveVariable readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector ) const;
+
 		IECoreScene::PrimitiveVariable::Interpolation interpolation( Alembic::AbcGeom::GeometryScope scope ) const;
 
+	private :
+
+		IECoreScene::PrimitiveVariable readArbGeomParam( const Alembic::Abc::ICompoundProperty &params, const Alembic::AbcCoreAbstract::PropertyHeader &header, const Alembic::Abc::ISampleSelector &sampleSelector ) const;
+
 };
 
 } // namespace IECoreAlembic
@@ -94,7 +94,16 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 template<typename T>
 void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive, const std::string &primitiveVariableName ) const
 {
+	IECoreScene::PrimitiveVariable pv = readGeomParam( param, sampleSelector );
+	if( pv.data )
+	{
+		primitive->variables[primitiveVariableName] = pv;
+	}
+}
 
+template<typename T>
+IECoreScene::PrimitiveVariable PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISampleSelector &sampleSelector ) const
+{
 	typedef typename T::prop_type::sample_ptr_type SamplePtr;
 	typedef typename IGeomParamTraits<T>::DataType DataType;
 	typedef typename T::sample_type GeomParamSample;
@@ -102,7 +111,7 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 	if( param.getArrayExtent() > 1 )
 	{
 		IECore::msg( IECore::Msg::Warning, "FromAlembicGeomBaseConverter::convertArbGeomParam", boost::format( "Param \"%s\" has unsupported array extent" ) % param.getHeader().getName() );
-		return;
+		return IECoreScene::PrimitiveVariable();
 	}
 
 	SamplePtr sample;
@@ -137,7 +146,7 @@ void PrimitiveReader::readGeomParam( const T &param, const Alembic::Abc::ISample
 		pv.indices = indexData;
 	}
 
-	primitive->variables[primitiveVariableName] = pv;
+	return pv;
 }
 
 } // namespace IECoreAlembic
@@ -60,7 +60,9 @@
 
 #include "boost/tokenizer.hpp"
 
+#include "tbb/parallel_invoke.h"
 #include "tbb/spin_mutex.h"
+#include "tbb/tbb_thread.h"
 
 #include <memory>
 #include <unordered_map>
@@ -97,6 +99,17 @@ bool isAnimated( ICompoundProperty &compoundProperty )
 	return false;
 }
 
+size_t defaultOgawaNumStreams()
+{
+	if( const char *v = getenv( "IECOREALEMBIC_OGAWANUMSTREAMS" ) )
+	{
+		return std::max( 1, atoi( v ) );
+	}
+	return std::max( 4u, std::min( tbb::tbb_thread::hardware_concurrency(), 8u ) );
+}
+
+const size_t g_ogawaNumStreams = defaultOgawaNumStreams();
+
 //! Alembic uses the "interpretation" metadata key to store the semantic of a given type.
 GeometricData::Interpretation convertInterpretation( const std::string &interpretation )
 {
@@ -154,15 +167,17 @@ class AlembicScene::AlembicReader : public AlembicIO
 			// Increasing the number of streams gives better
 			// multithreaded performance, because Ogawa locks
 			// around the stream. But each stream consumes an
-			// additional file handle, so we choose a fairly
-			// conservative number of streams, rather than simply
-			// matching the core count.
+			// additional file handle, so by default we choose a
+			// fairly conservative number of streams, rather than
+			// simply matching the core count. The
+			// `IECOREALEMBIC_OGAWANUMSTREAMS` environment variable
+			// may be used to override this.
 			//
 			// I believe that Alembic 1.7.2 removes the locking
 			// entirely at which point the number of streams is
 			// irrelevant - see https://github.com/alembic/alembic/issues/124
 			// for more details.
-			factory.setOgawaNumStreams( 4 );
+			factory.setOgawaNumStreams( g_ogawaNumStreams );
 			m_archive = std::make_shared<IArchive>( factory.getArchive( fileName ) );
 			if( !m_archive->valid() )
 			{
@@ -221,19 +236,36 @@ class AlembicScene::AlembicReader : public AlembicIO
 
 		AlembicIOPtr child( const IECoreScene::SceneInterface::Name &name, SceneInterface::MissingBehaviour missingBehaviour ) override
 		{
-			ChildMapMutex::scoped_lock lock( m_childrenMutex );
+			AlembicReaderPtr result;
+			bool found = false;
+			{
+				ChildMapMutex::scoped_lock lock( m_childrenMutex );
+				ChildMap::const_iterator it = m_children.find( name );
+				if( it != m_children.end() )
+				{
+					result = it->second;
+					found = true;
+				}
+			}
 
-			const std::pair<ChildMap::iterator, bool> insertion = m_children.insert( ChildMap::value_type( name, nullptr ) );
-			if( insertion.second )
+			if( !found )
 			{
+				// Opening the child reads from the archive, so we do it
+				// without holding the lock, to avoid serialising parallel
+				// traversals. If another thread beats us to it, we use
+				// its reader and discard ours.
 				IObject c = m_xform ? m_xform.getChild( name ) : m_archive->getTop().getChild( name );
 				if( c && IXform::matches( c.getMetaData() ) )
 				{
-					insertion.first->second = new AlembicReader( m_archive, IXform( c, kWrapExisting ) );
+					result = new AlembicReader( m_archive, IXform( c, kWrapExisting ) );
 				}
+
+				ChildMapMutex::scoped_lock lock( m_childrenMutex );
+				const std::pair<ChildMap::iterator, bool> insertion = m_children.insert( ChildMap::value_type( name, result ) );
+				result = insertion.first->second;
 			}
 
-			if( !insertion.first->second )
+			if( !result )
 			{
 				switch( missingBehaviour )
 				{
@@ -246,7 +278,7 @@ class AlembicScene::AlembicReader : public AlembicIO
 				}
 			}
 
-			return insertion.first->second;
+			return result;
 		}
 
 		ConstAlembicIOPtr child( const IECoreScene::SceneInterface::Name &name, SceneInterface::MissingBehaviour missingBehaviour ) const
@@ -951,9 +983,13 @@ class AlembicScene::AlembicReader : public AlembicIO
 			}
 
 			XformSample sample0;
-			schema.get( sample0, ISampleSelector( (index_t)index0 ) );
 			XformSample sample1;
-			schema.get( sample1, ISampleSelector( (index_t)index1 ) );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_invoke(
+				[&] { schema.get( sample0, ISampleSelector( (index_t)index0 ) ); },
+				[&] { schema.get( sample1, ISampleSelector( (index_t)index1 ) ); },
+				taskGroupContext
+			);
 
 			if( sample0.getNumOps() != sample1.getNumOps() ||
 				sample0.getNumOpChannels() != sample1.getNumOpChannels()
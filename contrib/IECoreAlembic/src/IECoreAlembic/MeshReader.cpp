@@ -38,9 +38,13 @@
 #include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/MeshPrimitive.h"
 
+#include "IECore/DeferredMessageHandler.h"
+
 #include "Alembic/AbcGeom/IPolyMesh.h"
 #include "Alembic/AbcGeom/ISubD.h"
 
+#include "tbb/parallel_invoke.h"
+
 using namespace IECore;
 using namespace IECoreScene;
 using namespace IECoreAlembic;
@@ -49,6 +53,17 @@ using namespace Alembic::AbcGeom;
 namespace
 {
 
+IN3fGeomParam normalsParam( const IPolyMeshSchema &schema )
+{
+	return schema.getNormalsParam();
+}
+
+IN3fGeomParam normalsParam( const ISubDSchema & )
+{
+	// SubDs don't store normals.
+	return IN3fGeomParam();
+}
+
 class MeshReader : public PrimitiveReader
 {
 
@@ -57,64 +72,130 @@ class MeshReader : public PrimitiveReader
 		template<typename Schema>
 		IECoreScene::MeshPrimitivePtr readTypedSample( const Schema &schema, const Alembic::Abc::ISampleSelector &sampleSelector ) const
 		{
-			Abc::Int32ArraySamplePtr faceCountsSample;
-			schema.getFaceCountsProperty().get( faceCountsSample, sampleSelector );
-
-			IntVectorDataPtr verticesPerFace = new IntVectorData();
-			verticesPerFace->writable().insert(
-				verticesPerFace->writable().begin(),
-				faceCountsSample->get(),
-				faceCountsSample->get() + faceCountsSample->size()
-			);
+			// All the arrays for a sample are independent, so we fetch
+			// and convert them concurrently, making a single pass over the
+			// sample rather than reading each property in turn. This
+			// allows the reads to be spread across the archive's Ogawa
+			// streams.
+
+			IntVectorDataPtr verticesPerFace;
+			IntVectorDataPtr vertexIds;
+			V3fVectorDataPtr points;
+			PrimitiveVariableMap variables;
+			PrimitiveVariable uvVariable;
+			PrimitiveVariable normalsVariable;
+			V3fVectorDataPtr velocityData;
+
+			const IN3fGeomParam normals = normalsParam( schema );
+
+			// Collects warnings from the parallel reads, so that we can
+			// output them on this thread.
+			DeferredMessageHandlerPtr messageHandler = new DeferredMessageHandler;
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_invoke(
+
+				[&] {
+					Abc::Int32ArraySamplePtr faceCountsSample;
+					schema.getFaceCountsProperty().get( faceCountsSample, sampleSelector );
+
+					verticesPerFace = new IntVectorData();
+					verticesPerFace->writable().insert(
+						verticesPerFace->writable().begin(),
+						faceCountsSample->get(),
+						faceCountsSample->get() + faceCountsSample->size()
+					);
+				},
 
-			Abc::Int32ArraySamplePtr faceIndicesSample;
-			schema.getFaceIndicesProperty().get( faceIndicesSample, sampleSelector );
+				[&] {
+					Abc::Int32ArraySamplePtr faceIndicesSample;
+					schema.getFaceIndicesProperty().get( faceIndicesSample, sampleSelector );
 
-			IntVectorDataPtr vertexIds = new IntVectorData();
-			vertexIds->writable().insert(
-				vertexIds->writable().begin(),
-				faceIndicesSample->get(),
-				faceIndicesSample->get() + faceIndicesSample->size()
-			);
+					vertexIds = new IntVectorData();
+					vertexIds->writable().insert(
+						vertexIds->writable().begin(),
+						faceIndicesSample->get(),
+						faceIndicesSample->get() + faceIndicesSample->size()
+					);
+				},
+
+				[&] {
+					Abc::P3fArraySamplePtr positionsSample;
+					schema.getPositionsProperty().get( positionsSample, sampleSelector );
+
+					points = new V3fVectorData();
+					points->writable().resize( positionsSample->size() );
+					memcpy( &(points->writable()[0]), positionsSample->get(), positionsSample->size() * sizeof( Imath::V3f ) );
+				},
+
+				[&] {
+					if( schema.getVelocitiesProperty().valid() )
+					{
+						Abc::V3fArraySamplePtr velocitySample;
+						schema.getVelocitiesProperty().get( velocitySample, sampleSelector );
+
+						velocityData = new V3fVectorData();
+						velocityData->writable().resize( velocitySample->size() );
+						memcpy( &(velocityData->writable()[0]), velocitySample->get(), velocitySample->size() * sizeof( Imath::V3f ) );
+						velocityData->setInterpretation( GeometricData::Vector );
+					}
+				},
+
+				[&] {
+					uvVariable = readUVs( schema.getUVsParam(), sampleSelector );
+				},
+
+				[&] {
+					MessageHandler::Scope messageScope( messageHandler.get() );
+					if( normals.valid() )
+					{
+						normalsVariable = readGeomParam( normals, sampleSelector );
+					}
+				},
+
+				[&] {
+					MessageHandler::Scope messageScope( messageHandler.get() );
+					readArbGeomParams( schema.getArbGeomParams(), sampleSelector, variables );
+				},
+
+				taskGroupContext
 
-			Abc::P3fArraySamplePtr positionsSample;
-			schema.getPositionsProperty().get( positionsSample, sampleSelector );
+			);
 
-			V3fVectorDataPtr points = new V3fVectorData();
-			points->writable().resize( positionsSample->size() );
-			memcpy( &(points->writable()[0]), positionsSample->get(), positionsSample->size() * sizeof( Imath::V3f ) );
+			messageHandler->flush();
 
 			MeshPrimitivePtr result = new IECoreScene::MeshPrimitive( verticesPerFace, vertexIds, "linear", points );
 
-			Alembic::AbcGeom::IV2fGeomParam uvs = schema.getUVsParam();
-			readUVs( uvs, sampleSelector, result.get() );
-
-			if( schema.getVelocitiesProperty().valid() )
+			if( uvVariable.data )
 			{
-				Abc::V3fArraySamplePtr velocitySample;
-				schema.getVelocitiesProperty().get( velocitySample, sampleSelector );
-
-				V3fVectorDataPtr velocityData = new V3fVectorData();
-				velocityData->writable().resize( velocitySample->size() );
-				memcpy( &(velocityData->writable()[0]), velocitySample->get(), velocitySample->size() * sizeof( Imath::V3f ) );
+				result->variables["uv"] = uvVariable;
+			}
 
-				velocityData->setInterpretation( GeometricData::Vector );
+			if( velocityData )
+			{
 				result->variables["velocity"] = PrimitiveVariable( PrimitiveVariable::Vertex, velocityData );
 			}
 
-			ICompoundProperty arbGeomParams = schema.getArbGeomParams();
-			readArbGeomParams( arbGeomParams, sampleSelector, result.get() );
+			for( const auto &variable : variables )
+			{
+				result->variables[variable.first] = variable.second;
+			}
+
+			if( normalsVariable.data )
+			{
+				result->variables[normals.getHeader().getName()] = normalsVariable;
+			}
 
 			return result;
 		}
 
 	private :
 
-		void readUVs( const Alembic::AbcGeom::IV2fGeomParam &uvs, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive ) const
+		IECoreScene::PrimitiveVariable readUVs( const Alembic::AbcGeom::IV2fGeomParam &uvs, const Alembic::Abc::ISampleSelector &sampleSelector ) const
 		{
 			if( !uvs.valid() )
 			{
-				return;
+				return PrimitiveVariable();
 			}
 
 			typedef IV2fArrayProperty::sample_ptr_type SamplePtr;
@@ -145,7 +226,7 @@ class MeshReader : public PrimitiveReader
 			}
 
 			PrimitiveVariable::Interpolation interpolation = PrimitiveReader::interpolation( uvs.getScope() );
-			primitive->variables["uv"] = PrimitiveVariable( interpolation, uvData, indexData );
+			return PrimitiveVariable( interpolation, uvData, indexData );
 		}
 
 };
@@ -185,12 +266,6 @@ class PolyMeshReader : public MeshReader
 			const IPolyMeshSchema &schema = m_polyMesh.getSchema();
 			MeshPrimitivePtr result = readTypedSample( schema, sampleSelector );
 
-			IN3fGeomParam normals = schema.getNormalsParam();
-			if( normals.valid() )
-			{
-				readGeomParam( normals, sampleSelector, result.get() );
-			}
-
 			IECoreScene::MeshAlgo::reverseWinding( result.get() );
 			return result;
 		}
@@ -37,8 +37,12 @@
 
 #include "IECoreAlembic/IGeomParamTraits.h"
 
+#include "IECore/DeferredMessageHandler.h"
 #include "IECore/MessageHandler.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 using namespace Alembic::Abc;
 using namespace Alembic::AbcGeom;
 using namespace IECore;
@@ -46,94 +50,49 @@ using namespace IECoreScene;
 using namespace IECoreAlembic;
 
 void PrimitiveReader::readArbGeomParams( const Alembic::Abc::ICompoundProperty &params, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::Primitive *primitive ) const
+{
+	readArbGeomParams( params, sampleSelector, primitive->variables );
+}
+
+void PrimitiveReader::readArbGeomParams( const Alembic::Abc::ICompoundProperty &params, const Alembic::Abc::ISampleSelector &sampleSelector, IECoreScene::PrimitiveVariableMap &variables ) const
 {
 	if( !params.valid() )
 	{
 		return;
 	}
 
-	for( size_t i = 0; i < params.getNumProperties(); ++i )
-	{
-		const PropertyHeader &header = params.getPropertyHeader( i );
+	// Each param is stored in its own Ogawa data block, so we can
+	// read and convert them concurrently, with the reads spread over
+	// the archive's streams.
+	const size_t numParams = params.getNumProperties();
+	std::vector<PrimitiveVariable> paramVariables( numParams );
 
-		if( IFloatGeomParam::matches( header ) )
-		{
-			IFloatGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IDoubleGeomParam::matches( header ) )
-		{
-			IDoubleGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IV3dGeomParam::matches( header ) )
-		{
-			IV3dGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IInt32GeomParam::matches( header ) )
-		{
-			IInt32GeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IStringGeomParam::matches( header ) )
-		{
-			IStringGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IV2fGeomParam::matches( header ) )
-		{
-			IV2fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IV3fGeomParam::matches( header ) )
-		{
-			IV3fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IC3fGeomParam::matches( header ) )
-		{
-			IC3fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IC4fGeomParam::matches( header ) )
-		{
-			IC4fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IN3fGeomParam::matches( header ) )
-		{
-			IN3fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IP3fGeomParam::matches( header ) )
-		{
-			IP3fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IM44fGeomParam::matches( header ) )
-		{
-			IM44fGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IBoolGeomParam::matches( header ) )
-		{
-			IBoolGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if( IQuatfGeomParam::matches( header) )
-		{
-			IQuatfGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else if ( IQuatdGeomParam::matches( header ) )
-		{
-			IQuatdGeomParam p( params, header.getName() );
-			readGeomParam( p, sampleSelector, primitive );
-		}
-		else
+	// Message handlers are per thread, so we collect any warnings
+	// about unsupported params and output them on this thread once
+	// the reads are complete.
+	DeferredMessageHandlerPtr messageHandler = new DeferredMessageHandler;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numParams ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			MessageHandler::Scope messageScope( messageHandler.get() );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				paramVariables[i] = readArbGeomParam( params, params.getPropertyHeader( i ), sampleSelector );
+			}
+		},
+		taskGroupContext
+	);
+
+	messageHandler->flush();
+
+	for( size_t i = 0; i < numParams; ++i )
+	{
+		if( paramVariables[i].data )
 		{
-			msg( Msg::Warning, "FromAlembicGeomBaseConverter::convertArbGeomParams", boost::format( "Param \"%s\" has unsupported type" ) % header.getName() );
+			variables[params.getPropertyHeader( i ).getName()] = paramVariables[i];
 		}
 	}
 }
@@ -156,3 +115,87 @@ IECoreScene::PrimitiveVariable::Interpolation PrimitiveReader::interpolation( Al
 			return PrimitiveVariable::Invalid;
 	}
 }
+
+IECoreScene::PrimitiveVariable PrimitiveReader::readArbGeomParam( const Alembic::Abc::ICompoundProperty &params, const Alembic::AbcCoreAbstract::PropertyHeader &header, const Alembic::Abc::ISampleSelector &sampleSelector ) const
+{
+	if( IFloatGeomParam::matches( header ) )
+	{
+		IFloatGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IDoubleGeomParam::matches( header ) )
+	{
+		IDoubleGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IV3dGeomParam::matches( header ) )
+	{
+		IV3dGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IInt32GeomParam::matches( header ) )
+	{
+		IInt32GeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IStringGeomParam::matches( header ) )
+	{
+		IStringGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IV2fGeomParam::matches( header ) )
+	{
+		IV2fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IV3fGeomParam::matches( header ) )
+	{
+		IV3fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IC3fGeomParam::matches( header ) )
+	{
+		IC3fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IC4fGeomParam::matches( header ) )
+	{
+		IC4fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IN3fGeomParam::matches( header ) )
+	{
+		IN3fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IP3fGeomParam::matches( header ) )
+	{
+		IP3fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IM44fGeomParam::matches( header ) )
+	{
+		IM44fGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IBoolGeomParam::matches( header ) )
+	{
+		IBoolGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if( IQuatfGeomParam::matches( header) )
+	{
+		IQuatfGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else if ( IQuatdGeomParam::matches( header ) )
+	{
+		IQuatdGeomParam p( params, header.getName() );
+		return readGeomParam( p, sampleSelector );
+	}
+	else
+	{
+		msg( Msg::Warning, "FromAlembicGeomBaseConverter::convertArbGeomParams", boost::format( "Param \"%s\" has unsupported type" ) % header.getName() );
+		return PrimitiveVariable();
+	}
+}
@@ -155,4 +155,35 @@ class AlembicPerformanceTest( unittest.TestCase ) :
 
 			print( times )
 
+	@unittest.skipUnless( os.environ.get("IE_PERFORMANCE_TEST", False), "'IE_PERFORMANCE_TEST' env var not set" )
+	def testParallelReadObjects( self ) :
+
+		with tempfile.NamedTemporaryFile( suffix = ".abc" ) as tf:
+			fileName = tf.name
+
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+		numPoints = mesh.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+		for i in range( 0, 10 ) :
+			mesh["primVar%d" % i] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.FloatVectorData( [ float( i ) ] * numPoints )
+			)
+
+		with Timer( "write file with meshes, filename: '{0}'".format( fileName ) ) :
+			root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Write )
+			for i in range( 0, 1000 ) :
+				root.createChild( str( i ) ).writeObject( mesh, 0.0 )
+			del root
+
+		self.filesCreated.append( fileName )
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+
+		times = []
+		for testRun in range( 5 ) :
+			t = IECore.Timer( True, IECore.Timer.WallClock )
+			IECoreScene.SceneAlgo.parallelReadAll( root, 0, 0, 24.0, IECoreScene.SceneAlgo.Objects )
+			times.append( t.stop() )
+
+		print( times )
 
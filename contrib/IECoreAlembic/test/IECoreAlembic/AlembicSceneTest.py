@@ -1354,6 +1354,50 @@ class AlembicSceneTest( unittest.TestCase ) :
 		self.assertEqual( object["test"].data, IECore.FloatVectorData( [1] ) )
 		self.assertEqual( object["test"].indices, IECore.IntVectorData( [0, 0, 0, 0] ) )
 
+	def testReadManyPrimitiveVariables( self ) :
+
+		# Primitive variables are read in parallel, so check that
+		# they all make it back intact.
+
+		plane = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		numPoints = plane.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+
+		plane["N"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( 0, 0, 1 ) ] * numPoints, IECore.GeometricData.Interpretation.Normal )
+		)
+		plane["velocity"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ imath.V3f( i, 0, 0 ) for i in range( numPoints ) ], IECore.GeometricData.Interpretation.Vector )
+		)
+		for i in range( 0, 20 ) :
+			plane["float%d" % i] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.FloatVectorData( [ i * j for j in range( numPoints ) ] )
+			)
+			plane["int%d" % i] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+				IECore.IntVectorData( [ i + j for j in range( plane.numFaces() ) ] )
+			)
+
+		root = IECoreAlembic.AlembicScene( "/tmp/test.abc", IECore.IndexedIO.OpenMode.Write )
+		root.createChild( "plane" ).writeObject( plane, 0 )
+		del root
+
+		root = IECoreAlembic.AlembicScene( "/tmp/test.abc", IECore.IndexedIO.OpenMode.Read )
+		plane2 = root.child( "plane" ).readObjectAtSample( 0 )
+
+		self.assertEqual( plane2.verticesPerFace, plane.verticesPerFace )
+		self.assertEqual( plane2.vertexIds, plane.vertexIds )
+		self.assertEqual( plane2["P"].data, plane["P"].data )
+		self.assertEqual( list( plane2["N"].data ), list( plane["N"].data ) )
+		self.assertEqual( list( plane2["velocity"].data ), list( plane["velocity"].data ) )
+
+		for i in range( 0, 20 ) :
+			for name in ( "float%d" % i, "int%d" % i ) :
+				self.assertEqual( plane2[name].interpolation, plane[name].interpolation )
+				self.assertEqual( plane2[name].data, plane[name].data )
+
 	def testSets( self ):
 		# Based on IECoreScene/SceneCacheTest.py & IECoreUSD/USDSceneWriterTest.py
 		# A
@@ -34,6 +34,8 @@
 
 #include "IECoreUSD/DataAlgo.h"
 
+#include "USDVersion.h"
+
 #include "IECore/DataAlgo.h"
 #include "IECore/MessageHandler.h"
 
@@ -298,6 +300,42 @@ IECore::DataPtr IECoreUSD::DataAlgo::fromUSD( const pxr::UsdAttribute &attribute
 namespace
 {
 
+#if USD_VERSION >= 2008
+
+// Allows a VtArray to reference the memory of a Cortex VectorData
+// without copying it. We hold a copy of the data, so that the
+// copy-on-write semantics of TypedData protect the VtArray from any
+// subsequent edits to the original. VtArray itself always copies
+// foreign data before modifying it.
+template<typename T>
+class DataForeignSource : public Vt_ArrayForeignDataSource
+{
+
+	public :
+
+		DataForeignSource( const IECore::TypedData<vector<T>> *data )
+			:	Vt_ArrayForeignDataSource( detached ), m_data( data->copy() )
+		{
+		}
+
+		const vector<T> &readable() const
+		{
+			return m_data->readable();
+		}
+
+	private :
+
+		static void detached( Vt_ArrayForeignDataSource *self )
+		{
+			delete static_cast<DataForeignSource *>( self );
+		}
+
+		typename IECore::TypedData<vector<T>>::ConstPtr m_data;
+
+};
+
+#endif
+
 struct VtValueFromData
 {
 
@@ -306,12 +344,28 @@ struct VtValueFromData
 	{
 		using USDType = typename CortexTypeTraits<T>::USDType;
 		using ArrayType = VtArray<USDType>;
+		const auto &readable = data->readable();
+		if( readable.empty() )
+		{
+			return VtValue( ArrayType() );
+		}
+#if USD_VERSION >= 2008
+		auto source = new DataForeignSource<T>( data );
+		return VtValue(
+			ArrayType(
+				source,
+				const_cast<USDType *>( reinterpret_cast<const USDType *>( source->readable().data() ) ),
+				readable.size()
+			)
+		);
+#else
 		ArrayType array;
 		array.assign(
-			reinterpret_cast<const USDType *>( data->readable().data() ),
-			reinterpret_cast<const USDType *>( data->readable().data() + data->readable().size() )
+			reinterpret_cast<const USDType *>( readable.data() ),
+			reinterpret_cast<const USDType *>( readable.data() + readable.size() )
 		);
 		return VtValue( array );
+#endif
 	}
 
 	template<typename T>
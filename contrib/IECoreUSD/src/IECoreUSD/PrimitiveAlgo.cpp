@@ -36,6 +36,8 @@
 
 #include "IECoreUSD/DataAlgo.h"
 
+#include "USDVersion.h"
+
 #include "IECore/DataAlgo.h"
 #include "IECore/MessageHandler.h"
 
@@ -46,11 +48,6 @@ IECORE_PUSH_DEFAULT_VISIBILITY
 #include "pxr/base/gf/matrix4d.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
-/// \todo Use the standard PXR_VERSION instead. We can't do that until
-/// everyone is using USD 19.11 though, because prior to that PXR_VERSION
-/// was malformed (octal, and not comparable in any way).
-#define USD_VERSION ( PXR_MAJOR_VERSION * 10000 + PXR_MINOR_VERSION * 100 + PXR_PATCH_VERSION )
-
 using namespace std;
 using namespace pxr;
 using namespace IECore;
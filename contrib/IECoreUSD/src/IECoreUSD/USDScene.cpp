@@ -33,10 +33,12 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "USDScene.h"
+#include "USDVersion.h"
 
 #include "IECoreUSD/DataAlgo.h"
 #include "IECoreUSD/ObjectAlgo.h"
 
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/VectorTypedData.h"
@@ -64,17 +66,16 @@ IECORE_POP_DEFAULT_VISIBILITY
 #include "boost/format.hpp"
 #include "boost/functional/hash.hpp"
 
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/task_arena.h"
+
 #include <iostream>
+#include <mutex>
 
 using namespace IECore;
 using namespace IECoreScene;
 using namespace IECoreUSD;
 
-/// \todo Use the standard PXR_VERSION instead. We can't do that until
-/// everyone is using USD 19.11 though, because prior to that PXR_VERSION
-/// was malformed (octal, and not comparable in any way).
-#define USD_VERSION ( PXR_MAJOR_VERSION * 10000 + PXR_MINOR_VERSION * 100 + PXR_PATCH_VERSION )
-
 #if USD_VERSION < 1903
 #define HasAuthoredValue HasAuthoredValueOpinion
 #endif
@@ -82,6 +83,19 @@ using namespace IECoreUSD;
 namespace
 {
 
+// The purposes included in computed bounds. Guides are excluded, because
+// they aren't rendered and shouldn't inflate the bounds of renderable
+// geometry.
+const pxr::TfTokenVector &boundPurposes()
+{
+	static const pxr::TfTokenVector g_purposes = {
+		pxr::UsdGeomTokens->default_,
+		pxr::UsdGeomTokens->render,
+		pxr::UsdGeomTokens->proxy
+	};
+	return g_purposes;
+}
+
 void append( const pxr::SdfPath &path, IECore::MurmurHash &h )
 {
 	h.append( (uint64_t)pxr::SdfPath::Hash()( path ) );
@@ -342,7 +356,14 @@ class USDScene::IO : public RefCounted
 	public :
 
 		IO( const std::string &fileName, IndexedIO::OpenMode openMode )
-			: m_fileName( fileName ), m_openMode( openMode )
+			: m_fileName( fileName ), m_openMode( openMode ),
+				m_timeCaches(
+					[this]( const double &timeSeconds, size_t &cost ) {
+						cost = 1;
+						return std::make_shared<TimeCaches>( getTime( timeSeconds ) );
+					},
+					/* maxCost = */ 10
+				)
 		{
 			switch( m_openMode )
 			{
@@ -428,14 +449,106 @@ class USDScene::IO : public RefCounted
 			return m_allTags;
 		}
 
+		// Transform and bound caches
+		// ==========================
+		//
+		// UsdGeomXformCache and UsdGeomBBoxCache amortise the cost of
+		// xform op queries and bound computations across locations, so
+		// we share a pair of them between all locations for each time.
+		// The USD caches aren't threadsafe, so each is guarded by a mutex.
+		// They can't be used in Write mode because the stage is changing.
+
+		struct TimeCaches
+		{
+			TimeCaches( pxr::UsdTimeCode time )
+				:	xformCache( time ),
+					bboxCache( time, boundPurposes(), /* useExtentsHint = */ true )
+			{
+			}
+
+			std::mutex xformMutex;
+			pxr::UsdGeomXformCache xformCache;
+			std::mutex bboxMutex;
+			pxr::UsdGeomBBoxCache bboxCache;
+		};
+
+		using TimeCachesPtr = std::shared_ptr<TimeCaches>;
+
+		TimeCachesPtr timeCaches( double timeSeconds )
+		{
+			if( m_openMode != IndexedIO::Read )
+			{
+				return nullptr;
+			}
+			return m_timeCaches.get( timeSeconds );
+		}
+
+		// Child names
+		// ===========
+		//
+		// Filtering the children of a prim is relatively expensive, and
+		// traversals may ask for the child names of each location many
+		// times. The hierarchy can't change in Read mode, so we cache them.
+
+		void childNames( const pxr::UsdPrim &prim, SceneInterface::NameList &childNames )
+		{
+			if( m_openMode != IndexedIO::Read )
+			{
+				childNamesInternal( prim, childNames );
+				return;
+			}
+
+			ChildNamesMap::const_accessor readAccessor;
+			if( !m_childNames.find( readAccessor, prim.GetPath() ) )
+			{
+				ChildNamesMap::accessor writeAccessor;
+				if( m_childNames.insert( writeAccessor, prim.GetPath() ) )
+				{
+					childNamesInternal( prim, writeAccessor->second );
+				}
+				childNames.insert( childNames.end(), writeAccessor->second.begin(), writeAccessor->second.end() );
+				return;
+			}
+			childNames.insert( childNames.end(), readAccessor->second.begin(), readAccessor->second.end() );
+		}
+
 	private :
 
+		static void childNamesInternal( const pxr::UsdPrim &prim, SceneInterface::NameList &childNames )
+		{
+			for( const auto &childPrim : prim.GetFilteredChildren( pxr::UsdTraverseInstanceProxies() ) )
+			{
+				if( isSceneChild( childPrim ) )
+				{
+					childNames.push_back( IECore::InternedString( childPrim.GetName() ) );
+				}
+			}
+		}
+
 		std::string m_fileName;
 		IndexedIO::OpenMode m_openMode;
 		pxr::UsdStageRefPtr m_stage;
 		pxr::UsdPrim m_rootPrim;
 		double m_timeCodesPerSecond;
 
+		IECore::LRUCache<double, TimeCachesPtr> m_timeCaches;
+
+		struct SdfPathHashCompare
+		{
+			static size_t hash( const pxr::SdfPath &path )
+			{
+				return pxr::SdfPath::Hash()( path );
+			}
+
+			static bool equal( const pxr::SdfPath &a, const pxr::SdfPath &b )
+			{
+				return a == b;
+			}
+		};
+
+		using ChildNamesMap = tbb::concurrent_hash_map<pxr::SdfPath, SceneInterface::NameList, SdfPathHashCompare>;
+		ChildNamesMap m_childNames;
+
 		std::once_flag m_allTagsFlag;
 		SceneInterface::NameList m_allTags;
 
@@ -476,7 +589,10 @@ Imath::Box3d USDScene::readBound( double time ) const
 	}
 
 	pxr::VtArray<pxr::GfVec3f> extents;
-	attr.Get<pxr::VtArray<pxr::GfVec3f> >( &extents, m_root->getTime( time ) );
+	if( attr.HasAuthoredValue() )
+	{
+		attr.Get<pxr::VtArray<pxr::GfVec3f> >( &extents, m_root->getTime( time ) );
+	}
 
 	if( extents.size() == 2 )
 	{
@@ -486,7 +602,45 @@ Imath::Box3d USDScene::readBound( double time ) const
 		);
 	}
 
-	return Imath::Box3d();
+	// No authored extent, so we must compute one. As for transforms, we
+	// use the shared cache if we can, but don't wait for other threads to
+	// finish with it.
+
+	pxr::GfRange3d range;
+	IO::TimeCachesPtr timeCaches = m_root->timeCaches( time );
+	std::unique_lock<std::mutex> lock;
+	if( timeCaches )
+	{
+		lock = std::unique_lock<std::mutex>( timeCaches->bboxMutex, std::try_to_lock );
+	}
+
+	if( lock.owns_lock() )
+	{
+		// UsdGeomBBoxCache performs parallel work of its own. Isolation
+		// prevents this thread from picking up unrelated tasks while it
+		// holds the lock, as they could need the same lock.
+		tbb::this_task_arena::isolate(
+			[&] {
+				range = timeCaches->bboxCache.ComputeUntransformedBound( m_location->prim ).ComputeAlignedRange();
+			}
+		);
+		lock.unlock();
+	}
+	else
+	{
+		pxr::UsdGeomBBoxCache bboxCache( m_root->getTime( time ), boundPurposes(), /* useExtentsHint = */ true );
+		range = bboxCache.ComputeUntransformedBound( m_location->prim ).ComputeAlignedRange();
+	}
+
+	if( range.IsEmpty() )
+	{
+		return Imath::Box3d();
+	}
+
+	return Imath::Box3d(
+		DataAlgo::fromUSD( range.GetMin() ),
+		DataAlgo::fromUSD( range.GetMax() )
+	);
 }
 
 ConstDataPtr USDScene::readTransform( double time ) const
@@ -507,7 +661,26 @@ Imath::M44d USDScene::readTransformAsMatrix( double time ) const
 	pxr::GfMatrix4d transform;
 	bool reset = false;
 
-	transformable.GetLocalTransformation( &transform, &reset, m_root->getTime( time ) );
+	// Use the shared cache if we can, but don't wait for other threads
+	// to finish with it, because the uncached query is cheaper than
+	// serialising all transform queries.
+	IO::TimeCachesPtr timeCaches = m_root->timeCaches( time );
+	std::unique_lock<std::mutex> lock;
+	if( timeCaches )
+	{
+		lock = std::unique_lock<std::mutex>( timeCaches->xformMutex, std::try_to_lock );
+	}
+
+	if( lock.owns_lock() )
+	{
+		transform = timeCaches->xformCache.GetLocalTransformation( m_location->prim, &reset );
+		lock.unlock();
+	}
+	else
+	{
+		transformable.GetLocalTransformation( &transform, &reset, m_root->getTime( time ) );
+	}
+
 	Imath::M44d returnValue = DataAlgo::fromUSD( transform );
 
 	if ( zUp )
@@ -778,13 +951,7 @@ bool USDScene::hasChild( const SceneInterface::Name &name ) const
 
 void USDScene::childNames( SceneInterface::NameList &childNames ) const
 {
-	for( const auto &prim : m_location->prim.GetFilteredChildren( pxr::UsdTraverseInstanceProxies() ) )
-	{
-		if( isSceneChild( prim ) )
-		{
-			childNames.push_back( IECore::InternedString( prim.GetName() ) );
-		}
-	}
+	m_root->childNames( m_location->prim, childNames );
 }
 
 SceneInterfacePtr USDScene::child( const SceneInterface::Name &name, SceneInterface::MissingBehaviour missingBehaviour )
@@ -890,7 +1057,9 @@ void USDScene::boundHash( double time, IECore::MurmurHash &h ) const
 	{
 		h.append( m_root->fileName() );
 		appendPrimOrMasterPath( m_location->prim, h );
-		if( boundable.GetExtentAttr().ValueMightBeTimeVarying() )
+		pxr::UsdAttribute extentAttr = boundable.GetExtentAttr();
+		// Computed bounds may vary with time even though the extent doesn't.
+		if( !extentAttr.HasAuthoredValue() || extentAttr.ValueMightBeTimeVarying() )
 		{
 			h.append( time );
 		}
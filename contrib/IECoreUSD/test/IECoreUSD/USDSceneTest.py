@@ -252,6 +252,26 @@ class USDSceneTest( unittest.TestCase ) :
 
 		self.assertEqual( bound, imath.Box3d( imath.V3d( -0.5 ), imath.V3d( 0.5 ) ) )
 
+	def testComputedBound( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "test.usda" )
+
+		stage = pxr.Usd.Stage.CreateNew( fileName )
+		mesh = pxr.UsdGeom.Mesh.Define( stage, "/mesh" )
+		mesh.CreatePointsAttr().Set( [ pxr.Gf.Vec3f( 0 ), pxr.Gf.Vec3f( 1, 2, 3 ) ], 0 )
+		mesh.CreatePointsAttr().Set( [ pxr.Gf.Vec3f( 0 ), pxr.Gf.Vec3f( 2, 4, 6 ) ], 24 )
+		stage.GetRootLayer().Save()
+		del stage
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+		mesh = root.child( "mesh" )
+
+		# There is no authored extent, so the bound must be computed.
+		self.assertTrue( mesh.hasBound() )
+		self.assertEqual( mesh.readBound( 0 ), imath.Box3d( imath.V3d( 0 ), imath.V3d( 1, 2, 3 ) ) )
+		self.assertEqual( mesh.readBound( 1 ), imath.Box3d( imath.V3d( 0 ), imath.V3d( 2, 4, 6 ) ) )
+		self.assertNotEqual( mesh.hash( mesh.HashType.BoundHash, 0 ), mesh.hash( mesh.HashType.BoundHash, 1 ) )
+
 	def testTransform ( self ) :
 
 		root = IECoreScene.SceneInterface.create( os.path.dirname( __file__ ) + "/data/hierarchy.usda", IECore.IndexedIO.OpenMode.Read )
@@ -1321,6 +1341,32 @@ class USDSceneTest( unittest.TestCase ) :
 			refCounts
 		)
 
+	def testEditsAfterWriteAreNotWritten( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "test.usda" )
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Write )
+		child = root.createChild( "test" )
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 10 ) ] ) )
+		points["test"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( range( 0, 10 ) )
+		)
+		child.writeObject( points, 0 )
+
+		# Edit the data in place before the file is closed. The USD
+		# arrays may share memory with the Cortex data, but must not
+		# see the edits.
+		points["P"].data[0] = imath.V3f( 100 )
+		points["test"].data[0] = 100
+		del root, child
+
+		stage = pxr.Usd.Stage.Open( fileName )
+		usdPoints = pxr.UsdGeom.Points( stage.GetPrimAtPath( "/test" ) )
+		self.assertEqual( usdPoints.GetPointsAttr().Get( 0 )[0], pxr.Gf.Vec3f( 0 ) )
+		primvarsAPI = pxr.UsdGeom.PrimvarsAPI( stage.GetPrimAtPath( "/test" ) )
+		self.assertEqual( primvarsAPI.GetPrimvar( "test" ).Get( 0 ), pxr.Vt.FloatArray( range( 0, 10 ) ) )
+
 	def testWriteUVs( self ) :
 
 		fileName = os.path.join( self.temporaryDirectory(), "test.usda" )
@@ -2079,5 +2125,35 @@ class USDSceneTest( unittest.TestCase ) :
 			cube["N"]
 		)
 
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testTraversalPerformance( self ) :
+
+		# 100 groups of 100 meshes, none of which have authored extents.
+
+		fileName = os.path.join( self.temporaryDirectory(), "test.usdc" )
+		stage = pxr.Usd.Stage.CreateNew( fileName )
+		for i in range( 0, 100 ) :
+			group = pxr.UsdGeom.Xform.Define( stage, "/group%d" % i )
+			group.AddTranslateOp().Set( pxr.Gf.Vec3d( i, 0, 0 ) )
+			for j in range( 0, 100 ) :
+				mesh = pxr.UsdGeom.Mesh.Define( stage, "/group%d/mesh%d" % ( i, j ) )
+				mesh.AddTranslateOp().Set( pxr.Gf.Vec3d( 0, j, 0 ) )
+				mesh.CreatePointsAttr().Set( [ pxr.Gf.Vec3f( 0 ), pxr.Gf.Vec3f( 1 ) ] )
+		stage.GetRootLayer().Save()
+		del stage
+
+		root = IECoreScene.SceneInterface.create( fileName, IECore.IndexedIO.OpenMode.Read )
+
+		def traverse( scene ) :
+			scene.readTransformAsMatrix( 0 )
+			scene.readBound( 0 )
+			for name in scene.childNames() :
+				traverse( scene.child( name ) )
+
+		t = IECore.Timer()
+		for i in range( 0, 10 ) :
+			traverse( root )
+		print( "traversal time: {0}s".format( t.stop() ) )
+
 if __name__ == "__main__":
 	unittest.main()
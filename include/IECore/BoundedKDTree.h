@@ -74,6 +74,9 @@ class BoundedKDTree
 		/// Builds the tree for the specified bounds - the iterator range
 		/// must remain valid and unchanged as long as the tree is in use.
 		/// This method can be called again to rebuild the tree at any time.
+		/// Large trees are built using multiple threads, and a copy of each
+		/// bound is stored within the tree so that searches don't need to
+		/// dereference the iterators.
 		/// \threading This can't be called while other threads are
 		/// making queries.
 		void init( BoundIterator first, BoundIterator last, int maxLeafSize=4 );
@@ -93,6 +96,12 @@ class BoundedKDTree
 		/// Returns the index for the root node
 		NodeIndex rootIndex() const;
 
+		/// Returns the start of the permutation of the bounds used by the tree.
+		/// Leaf nodes reference contiguous ranges within it, so
+		/// `node.permFirst() - permutation()` gives the position of a leaf's
+		/// first bound, which may be used to index data stored in tree order.
+		inline const BoundIterator *permutation() const;
+
 		/// Retrieve the index of the "low" child node
 		static NodeIndex lowChildIndex( NodeIndex index );
 
@@ -103,18 +112,37 @@ class BoundedKDTree
 
 		typedef std::vector<BoundIterator> Permutation;
 		typedef typename Permutation::iterator PermutationIterator;
-		typedef typename Permutation::const_iterator PermutationConstIterator;
+
+		/// Used during construction, so that partitioning can operate on
+		/// contiguous data and precomputed centres rather than dereferencing
+		/// iterators.
+		struct BuildEntry
+		{
+			Bound bound;
+			BaseType center;
+			BoundIterator iterator;
+		};
+		typedef std::vector<BuildEntry> BuildEntries;
+		typedef typename BuildEntries::iterator BuildIterator;
 
 		class AxisSort;
 
-		unsigned char majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast );
-		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast );
-		void bound( NodeIndex nodeIndex );
+		unsigned char majorAxis( BuildIterator first, BuildIterator last );
+		/// Builds the subtree for the entries in the range [first, last), including
+		/// the bounds of all its nodes. The range maps to the same range in m_perm.
+		void build( NodeIndex nodeIndex, BuildEntries &entries, size_t first, size_t last );
+		/// Returns the stored copies of the bounds referenced by a leaf node.
+		inline const Bound *leafBounds( const Node &node ) const;
 
 		template<typename S>
 		void intersectingBoundsWalk( NodeIndex nodeIndex, const S &p, std::vector<BoundIterator> &bounds ) const;
 
+		/// Subtrees with at least this many bounds are built in parallel.
+		static const size_t m_minParallelBuildSize = 10000;
+
 		Permutation m_perm;
+		/// Copies of the bounds, in the same order as m_perm.
+		std::vector<Bound> m_bounds;
 		NodeVector m_nodes;
 		int m_maxLeafSize;
 		BoundIterator m_lastBound;
@@ -36,6 +36,11 @@
 #include "IECore/VectorOps.h"
 #include "IECore/VectorTraits.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/task_group.h"
+
 #include <algorithm>
 #include <cassert>
 
@@ -50,10 +55,10 @@ class BoundedKDTree<BoundIterator>::AxisSort
 		{
 		}
 
-		bool operator() ( BoundIterator i, BoundIterator j )
+		bool operator() ( const BuildEntry &i, const BuildEntry &j ) const
 		{
-			return VectorTraits< BaseType >::get( boxCenter(*i), m_axis)
-				< VectorTraits< BaseType >::get( boxCenter(*j), m_axis);
+			return VectorTraits< BaseType >::get( i.center, m_axis)
+				< VectorTraits< BaseType >::get( j.center, m_axis);
 		}
 
 	private :
@@ -132,15 +137,15 @@ const typename BoundedKDTree<BoundIterator>::Bound &BoundedKDTree<BoundIterator>
 }
 
 template<class BoundIterator>
-unsigned char BoundedKDTree<BoundIterator>::majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast )
+unsigned char BoundedKDTree<BoundIterator>::majorAxis( BuildIterator first, BuildIterator last )
 {
 	BaseType min, max;
 	vecSetAll( min, Imath::limits<typename BaseType::BaseType>::max() );
 	vecSetAll( max, Imath::limits<typename BaseType::BaseType>::min() );
 
-	for( PermutationConstIterator it=permFirst; it!=permLast; it++ )
+	for( BuildIterator it=first; it!=last; it++ )
 	{
-		BaseType center = boxCenter(**it);
+		const BaseType &center = it->center;
 
 		for( unsigned char i=0; i<VectorTraits<BaseType>::dimensions(); i++ )
 		{
@@ -148,7 +153,7 @@ unsigned char BoundedKDTree<BoundIterator>::majorAxis( PermutationConstIterator
 			{
 				VectorTraits<BaseType>::set(min, i, VectorTraits<BaseType>::get(center, i) );
 			}
-			if( VectorTraits<BaseType>::get(center, i) > VectorTraits<BaseType>::get(min, i) )
+			if( VectorTraits<BaseType>::get(center, i) > VectorTraits<BaseType>::get(max, i) )
 			{
 				VectorTraits<BaseType>::set(max, i, VectorTraits<BaseType>::get(center, i) );
 			}
@@ -169,69 +174,58 @@ unsigned char BoundedKDTree<BoundIterator>::majorAxis( PermutationConstIterator
 }
 
 template<class BoundIterator>
-void BoundedKDTree<BoundIterator>::bound( NodeIndex nodeIndex  )
+void BoundedKDTree<BoundIterator>::build( NodeIndex nodeIndex, BuildEntries &entries, size_t first, size_t last )
 {
 	assert( nodeIndex < m_nodes.size() );
 
 	Node &node = m_nodes[nodeIndex];
 
-	assert( BoxTraits<Bound>::isEmpty( node.bound() ) );
-
-	if( node.isLeaf() )
+	if( last - first > (size_t)m_maxLeafSize )
 	{
-		BoundIterator *permLast = node.permLast();
-		for( BoundIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		unsigned int cutAxis = majorAxis( entries.begin() + first, entries.begin() + last );
+		size_t mid = first + (last - first)/2;
+		std::nth_element( entries.begin() + first, entries.begin() + mid, entries.begin() + last, AxisSort( cutAxis ) );
+
+		// insert node
+		node.makeBranch( cutAxis );
+
+		// The children occupy disjoint ranges of the entries and
+		// of the node array, so large subtrees can be built in parallel.
+		if( last - first >= m_minParallelBuildSize )
 		{
-			boxExtend( node.bound(), **perm );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_invoke(
+				[this, nodeIndex, &entries, first, mid] { build( lowChildIndex( nodeIndex ), entries, first, mid ); },
+				[this, nodeIndex, &entries, mid, last] { build( highChildIndex( nodeIndex ), entries, mid, last ); },
+				taskGroupContext
+			);
+		}
+		else
+		{
+			build( lowChildIndex( nodeIndex ), entries, first, mid );
+			build( highChildIndex( nodeIndex ), entries, mid, last );
 		}
-	}
-	else
-	{
-		assert( node.isBranch() );
-
-		assert( lowChildIndex( nodeIndex ) < m_nodes.size() );
-		assert( highChildIndex( nodeIndex ) < m_nodes.size() );
 
-		bound( lowChildIndex( nodeIndex ) );
-		bound( highChildIndex( nodeIndex ) );
 		boxExtend( node.bound(), m_nodes[lowChildIndex( nodeIndex )].bound() );
 		boxExtend( node.bound(), m_nodes[highChildIndex( nodeIndex )].bound() );
 	}
-}
-
-
-template<class BoundIterator>
-void BoundedKDTree<BoundIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast )
-{
-	// make room for the new node
-	if( nodeIndex>=m_nodes.size() )
-	{
-		m_nodes.resize( nodeIndex+1 );
-	}
-
-	assert( nodeIndex < m_nodes.size() );
-
-	Node &node = m_nodes[nodeIndex];
-
-	if( permLast - permFirst > m_maxLeafSize )
-	{
-		unsigned int cutAxis = majorAxis( permFirst, permLast );
-		PermutationIterator permMid = permFirst  + (permLast - permFirst)/2;
-		std::nth_element( permFirst, permMid, permLast, AxisSort( cutAxis ) );
-
-		// insert node
-		node.makeBranch( cutAxis );
-
-		build( lowChildIndex( nodeIndex ), permFirst, permMid );
-		build( highChildIndex( nodeIndex ), permMid, permLast );
-	}
 	else
 	{
 		// leaf node
-		node.makeLeaf( permFirst, permLast );
+		node.makeLeaf( m_perm.begin() + first, m_perm.begin() + last );
+		for( size_t i = first; i < last; ++i )
+		{
+			boxExtend( node.bound(), entries[i].bound );
+		}
 	}
 }
 
+template<class BoundIterator>
+inline const typename BoundedKDTree<BoundIterator>::Bound *BoundedKDTree<BoundIterator>::leafBounds( const Node &node ) const
+{
+	return m_bounds.data() + ( node.permFirst() - m_perm.data() );
+}
+
 template<class BoundIterator>
 BoundedKDTree<BoundIterator>::BoundedKDTree()
 {
@@ -249,16 +243,55 @@ void BoundedKDTree<BoundIterator>::init( BoundIterator first, BoundIterator last
 	m_maxLeafSize = maxLeafSize;
 	m_lastBound = last;
 
-	m_perm.resize( last - first );
-	unsigned int i=0;
-	for( BoundIterator it=first; it!=last; it++ )
+	const size_t numBounds = last - first;
+	BuildEntries entries( numBounds );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBounds ),
+		[&entries, first]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				BuildEntry &entry = entries[i];
+				entry.iterator = first + i;
+				entry.bound = *entry.iterator;
+				entry.center = boxCenter( entry.bound );
+			}
+		},
+		taskGroupContext
+	);
+
+	// Because we always split at the median, the high child of a node
+	// is never smaller than the low child, so following high children
+	// from the root leads to the node with the largest index. We can
+	// therefore allocate all the nodes up front, which allows the
+	// subtrees to be built concurrently.
+	NodeIndex lastNodeIndex = rootIndex();
+	for( size_t size = numBounds; size > (size_t)m_maxLeafSize; size -= size / 2 )
 	{
-		m_perm[i++] = it;
+		lastNodeIndex = highChildIndex( lastNodeIndex );
 	}
-
-	/// \todo Can we reserve() enough space for m_nodes before doing this?
-	build( rootIndex(), m_perm.begin(), m_perm.end() );
-	bound( rootIndex() );
+	m_nodes.clear();
+	m_nodes.resize( lastNodeIndex + 1 );
+
+	m_perm.resize( numBounds );
+	build( rootIndex(), entries, 0, numBounds );
+
+	// Now the entries are in their final order, we split them into the
+	// permutation and a copy of the bounds, so that searches can read bounds
+	// sequentially without having to dereference the iterators.
+	m_bounds.resize( numBounds );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBounds ),
+		[this, &entries]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				m_perm[i] = entries[i].iterator;
+				m_bounds[i] = entries[i].bound;
+			}
+		},
+		taskGroupContext
+	);
 }
 
 template<class BoundIterator>
@@ -282,6 +315,12 @@ typename BoundedKDTree<BoundIterator>::NodeIndex BoundedKDTree<BoundIterator>::r
 	return 1;
 }
 
+template<class BoundIterator>
+const BoundIterator *BoundedKDTree<BoundIterator>::permutation() const
+{
+	return m_perm.data();
+}
+
 template<class BoundIterator>
 typename BoundedKDTree<BoundIterator>::NodeIndex BoundedKDTree<BoundIterator>::lowChildIndex( NodeIndex index )
 {
@@ -313,9 +352,10 @@ void BoundedKDTree<BoundIterator>::intersectingBoundsWalk(  NodeIndex nodeIndex,
 	if( node.isLeaf() )
 	{
 		BoundIterator *permLast = node.permLast();
-		for( BoundIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Bound *bound = leafBounds( node );
+		for( BoundIterator *perm = node.permFirst(); perm!=permLast; perm++, bound++ )
 		{
-			const Bound &bb = **perm;
+			const Bound &bb = *bound;
 
 			if ( boxIntersects( bb, b ) )
 			{
@@ -49,6 +49,41 @@ class IECORE_API Data : public Object
 
 		IE_CORE_DECLAREOBJECT( Data, Object );
 
+		/// Algorithms used to hash the contents of array data such as
+		/// VectorTypedData.
+		enum HashVersion
+		{
+			/// Hashes all elements serially, as a single stream. This is
+			/// the default, and gives hashes which are stable between
+			/// releases, as required by persistent caches.
+			SerialHash = 0,
+			/// Splits arrays larger than a fixed-size block into blocks
+			/// which are hashed in parallel, and then combines the block
+			/// hashes. This is much faster for large arrays, but gives
+			/// them different hashes than SerialHash. Arrays smaller than
+			/// a block hash identically with both versions.
+			ChunkedHash = 1
+		};
+
+		/// Sets the algorithm used by subsequent calls to hash(). The
+		/// default may be specified using the IECORE_DATA_HASHVERSION
+		/// environment variable.
+		static void setHashVersion( HashVersion hashVersion );
+		static HashVersion getHashVersion();
+
+		/// Enables lazy loading of large arrays held by primitive variables
+		/// and CompoundObject members. When enabled, such arrays record their
+		/// location in the file during load(), and only read and decompress
+		/// their values when they are first accessed. Arrays saved while lazy
+		/// loading is enabled also store their hash, which is then available
+		/// without loading. Otherwise the file format is unchanged. Because
+		/// the file is read after load() has returned, it must not be
+		/// modified while lazily loaded data is alive. Lazy loading is only
+		/// ever used for files opened in Read mode. The default may be
+		/// specified using the IECORE_DATA_LAZYLOADING environment variable.
+		static void setLazyLoading( bool lazyLoading );
+		static bool getLazyLoading();
+
 	protected :
 
 		~Data() override;
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_DEFERREDMESSAGEHANDLER_H
+#define IECORE_DEFERREDMESSAGEHANDLER_H
+
+#include "IECore/MessageHandler.h"
+
+#include <mutex>
+#include <vector>
+
+namespace IECore
+{
+
+class DeferredMessageHandler;
+IE_CORE_DECLAREPTR( DeferredMessageHandler );
+
+/// The DeferredMessageHandler class stores messages so that they
+/// may be output later. Because message handlers are installed per
+/// thread, this is useful for collecting messages emitted by TBB
+/// tasks, which would otherwise go to the default handler, and then
+/// outputting them on the calling thread once the tasks have finished.
+/// \threading handle() may be called concurrently from multiple threads.
+/// \ingroup utilityGroup
+class IECORE_API DeferredMessageHandler : public MessageHandler
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( DeferredMessageHandler );
+
+		DeferredMessageHandler();
+		~DeferredMessageHandler() override;
+
+		void handle( Level level, const std::string &context, const std::string &message ) override;
+
+		/// Outputs all stored messages using msg(), so that they go to the
+		/// current handler for the calling thread, and then clears them.
+		void flush();
+
+	private :
+
+		struct Message
+		{
+			Level level;
+			std::string context;
+			std::string message;
+		};
+
+		std::mutex m_mutex;
+		std::vector<Message> m_messages;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_DEFERREDMESSAGEHANDLER_H
@@ -38,7 +38,9 @@
 #include "IECore/ByteOrder.h"
 #include "IECore/MessageHandler.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <vector>
 
 namespace IECore
@@ -68,13 +70,7 @@ size_t IFFFile::Chunk::read( std::vector<T> &data )
 		msg( Msg::Error, "IFFFile::Chunk::read()", boost::format( "Attempting to read '%d' pieces of data of size '%d' for a Chunk '%s' with dataSize '%d'." ) % length % sizeof(T) % m_type.name() % m_dataSize );
 	}
 
-	std::vector<T> dataBuffer( length );
-	readData( dataBuffer.data(), length );
-
-	for ( size_t i = 0; i < length; i++ )
-	{
-		data[i] = dataBuffer[i];
-	}
+	readData( data.data(), length );
 
 	return data.size();
 }
@@ -89,15 +85,9 @@ size_t IFFFile::Chunk::read( std::vector<Imath::Vec3<T> > &data )
 		msg( Msg::Error, "IFFFile::Chunk::read()", boost::format( "Attempting to read %d pieces of IMath::Vec3 data of size %d for a Chunk '%s' with dataSize %d." ) % length % sizeof(T) % m_type.name() % m_dataSize );
 	}
 
-	std::vector<T> dataBuffer( length * 3 );
-	readData( dataBuffer.data(), length * 3 );
-
-	for ( size_t i = 0; i < length ; i++ )
-	{
-		data[ i ][0] = dataBuffer[ 3*i ];
-		data[ i ][1] = dataBuffer[ 3*i + 1 ];
-		data[ i ][2] = dataBuffer[ 3*i + 2 ];
-	}
+	// Vec3 is laid out as three consecutive values, so we can read
+	// directly into the vector.
+	readData( data.empty() ? nullptr : &data[0][0], length * 3 );
 
 	return data.size();
 }
@@ -107,10 +97,12 @@ void IFFFile::Chunk::readData( T *dataBuffer, unsigned long n )
 {
 	m_file->m_iStream->seekg( m_filePosition, std::ios_base::beg );
 
-	std::vector<char> buffer( m_dataSize );
-	m_file->m_iStream->read( buffer.data(), m_dataSize );
+	// Read straight into the destination and then reorder the
+	// bytes in place, rather than going via an intermediate buffer.
+	n = std::min<unsigned long>( n, m_dataSize / sizeof( T ) );
+	m_file->m_iStream->read( (char *)dataBuffer, n * sizeof( T ) );
 
-	IFFFile::readData( buffer.data(), dataBuffer, n );
+	IFFFile::readData( (const char *)dataBuffer, dataBuffer, n );
 }
 
 template<typename T>
@@ -118,10 +110,11 @@ void IFFFile::readData( const char *dataBuffer, T *attrBuffer, unsigned long n )
 {
 	for( unsigned long i=0; i < n; i++ )
 	{
-		T *data = (T*)dataBuffer;
+		T data;
+		memcpy( &data, dataBuffer, sizeof( T ) );
 		dataBuffer += sizeof( T );
 
-		*attrBuffer = asBigEndian( *data );
+		*attrBuffer = asBigEndian( data );
 		attrBuffer++;
 	}
 }
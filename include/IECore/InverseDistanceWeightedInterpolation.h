@@ -86,7 +86,11 @@ class InverseDistanceWeightedInterpolation
 		/// reusing the same NeighbourVector than it is to call the version above, which
 		/// has to allocate a NeighbourVector each time.
 		Value operator()( const Point &p, NeighbourVector &neighbours ) const;
-
+		/// Evaluates the interpolated values for numPoints points at once, using
+		/// multiple threads, and placing the results in values, which must have
+		/// room for numPoints elements.
+		/// \threading May be called by multiple concurrent threads.
+		void operator()( const Point *points, size_t numPoints, Value *values ) const;
 
 	private :
 
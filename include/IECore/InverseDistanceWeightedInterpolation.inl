@@ -36,6 +36,10 @@
 
 #include "OpenEXR/ImathLimits.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
 
 namespace IECore
@@ -52,7 +56,7 @@ InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::InverseDista
 ) : m_firstPoint( firstPoint ), m_firstValue( firstValue ), m_numNeighbours( numNeighbours )
 {
 	assert( lastPoint-firstPoint == lastValue-firstValue );
-	m_tree = new Tree( firstPoint, lastPoint );
+	m_tree = new Tree( firstPoint, lastPoint, maxLeafSize );
 }
 
 template<typename PointIterator, typename ValueIterator>
@@ -113,5 +117,25 @@ typename InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::Val
 	return result;
 }
 
+template<typename PointIterator, typename ValueIterator>
+void InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::operator()( const Point *points, size_t numPoints, Value *values ) const
+{
+	// Reuse a NeighbourVector for all the queries on each thread,
+	// so we don't allocate per point.
+	tbb::enumerable_thread_specific<NeighbourVector> threadNeighbours;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			NeighbourVector &neighbours = threadNeighbours.local();
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				values[i] = operator()( points[i], neighbours );
+			}
+		},
+		taskGroupContext
+	);
+}
 
 } // namespace IECore
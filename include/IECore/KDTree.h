@@ -77,6 +77,9 @@ class KDTree
 		/// Builds the tree for the specified points - the iterator range
 		/// must remain valid and unchanged as long as the tree is in use.
 		/// This method can be called again to rebuild the tree at any time.
+		/// Large trees are built using multiple threads, and a copy of each
+		/// point is stored within the tree so that searches don't need to
+		/// dereference the iterators.
 		/// \threading This can't be called while other threads are
 		/// making queries.
 		void init( PointIterator first, PointIterator last, int maxLeafSize=4  );
@@ -104,6 +107,22 @@ class KDTree
 		/// \threading May be called by multiple concurrent threads provided they are each using a different vector for the result.
 		unsigned int nearestNNeighbours( const Point &p, unsigned int numNeighbours, std::vector<Neighbour> &nearNeighbours ) const;
 
+		/// Performs nearestNeighbours() for every point in the range [first, last), using
+		/// multiple threads. Results are returned in compressed sparse row form : the
+		/// neighbours of the ith query point are stored in nearNeighbours[offsets[i]] to
+		/// nearNeighbours[offsets[i+1]-1], in no particular order. The offsets vector is
+		/// resized to hold one more element than there are query points.
+		/// \threading May be called by multiple concurrent threads provided they are each using different vectors for the result.
+		template<typename QueryIterator>
+		void batchNearestNeighbours( QueryIterator first, QueryIterator last, BaseType r, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const;
+
+		/// Performs nearestNNeighbours() for every point in the range [first, last), using
+		/// multiple threads. Results are returned in the same form as for batchNearestNeighbours(),
+		/// with the neighbours for each query point sorted closest first.
+		/// \threading May be called by multiple concurrent threads provided they are each using different vectors for the result.
+		template<typename QueryIterator>
+		void batchNearestNNeighbours( QueryIterator first, QueryIterator last, unsigned int numNeighbours, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const;
+
 		/// Finds all the points contained by the specified bound, outputting them to the specified iterator.
 		/// \threading May be called by multiple concurrent threads.
 		template<typename Box, typename OutputIterator>
@@ -128,23 +147,44 @@ class KDTree
 
 		typedef std::vector<PointIterator> Permutation;
 		typedef typename Permutation::iterator PermutationIterator;
-		typedef typename Permutation::const_iterator PermutationConstIterator;
+
+		/// Used during construction, so that partitioning can operate
+		/// on contiguous point data rather than dereferencing iterators.
+		struct BuildEntry
+		{
+			Point point;
+			PointIterator iterator;
+		};
+		typedef std::vector<BuildEntry> BuildEntries;
+		typedef typename BuildEntries::iterator BuildIterator;
 
 		class AxisSort;
 
-		unsigned char majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast );
-		void build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast );
+		unsigned char majorAxis( BuildIterator first, BuildIterator last );
+		/// Builds the subtree for the entries in the range [first, last), which
+		/// maps to the same range in m_perm.
+		void build( NodeIndex nodeIndex, BuildEntries &entries, size_t first, size_t last );
+		/// Returns the stored copies of the points referenced by a leaf node.
+		inline const Point *leafPoints( const Node &node ) const;
 
 		void nearestNeighbourWalk( NodeIndex nodeIndex, const Point &p, PointIterator &closestPoint, BaseType &distSquared ) const;
 
-		void nearestNeighboursWalk( NodeIndex nodeIndex, const Point &p, BaseType r2, std::vector<PointIterator> &nearNeighbours ) const;
+		template<typename NeighbourContainer>
+		void nearestNeighboursWalk( NodeIndex nodeIndex, const Point &p, BaseType r2, NeighbourContainer &nearNeighbours ) const;
+		inline void appendNeighbour( const PointIterator &point, BaseType dist2, std::vector<PointIterator> &nearNeighbours ) const;
+		inline void appendNeighbour( const PointIterator &point, BaseType dist2, std::vector<Neighbour> &nearNeighbours ) const;
 
 		template<typename Box, typename OutputIterator>
 		void enclosedPointsWalk( NodeIndex nodeIndex, const Box &bound, OutputIterator it ) const;
 
 		void nearestNNeighboursWalk( NodeIndex nodeIndex, const Point &p, unsigned int numNeighbours, std::vector<Neighbour> &nearNeighbours, BaseType &maxDistSquared ) const;
 
+		/// Subtrees with at least this many points are built in parallel.
+		static const size_t m_minParallelBuildSize = 10000;
+
 		Permutation m_perm;
+		/// Copies of the points, in the same order as m_perm.
+		std::vector<Point> m_points;
 		NodeVector m_nodes;
 		int m_maxLeafSize;
 		PointIterator m_lastPoint;
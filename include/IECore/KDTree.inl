@@ -37,6 +37,12 @@
 
 #include "OpenEXR/ImathLimits.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/task_group.h"
+
 #include <algorithm>
 
 namespace IECore
@@ -101,9 +107,9 @@ class KDTree<PointIterator>::AxisSort
 		{
 		}
 
-		bool operator() ( PointIterator i, PointIterator j )
+		bool operator() ( const BuildEntry &i, const BuildEntry &j ) const
 		{
-			return (*i)[m_axis] < (*j)[m_axis];
+			return i.point[m_axis] < j.point[m_axis];
 		}
 
 	private :
@@ -128,36 +134,75 @@ void KDTree<PointIterator>::init( PointIterator first, PointIterator last, int m
 {
 	m_maxLeafSize = maxLeafSize;
 	m_lastPoint = last;
-	m_perm.resize( last - first );
-	unsigned int i=0;
-	for( PointIterator it=first; it!=last; it++ )
+
+	const size_t numPoints = last - first;
+	BuildEntries entries( numPoints );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		[&entries, first]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				entries[i].iterator = first + i;
+				entries[i].point = *entries[i].iterator;
+			}
+		},
+		taskGroupContext
+	);
+
+	// Because we always split at the median, the high child of a node
+	// is never smaller than the low child, so following high children
+	// from the root leads to the node with the largest index. We can
+	// therefore allocate all the nodes up front, which allows the
+	// subtrees to be built concurrently.
+	NodeIndex lastNodeIndex = rootIndex();
+	for( size_t size = numPoints; size > (size_t)m_maxLeafSize; size -= size / 2 )
 	{
-		m_perm[i++] = it;
+		lastNodeIndex = highChildIndex( lastNodeIndex );
 	}
-
-	/// \todo Can we reserve() enough space for m_nodes before doing this?
-	build( rootIndex(), m_perm.begin(), m_perm.end() );
+	m_nodes.clear();
+	m_nodes.resize( lastNodeIndex + 1 );
+
+	m_perm.resize( numPoints );
+	build( rootIndex(), entries, 0, numPoints );
+
+	// Now the entries are in their final order, we split them into the
+	// permutation and a copy of the points, so that searches can read points
+	// sequentially without having to dereference the iterators.
+	m_points.resize( numPoints );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		[this, &entries]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				m_perm[i] = entries[i].iterator;
+				m_points[i] = entries[i].point;
+			}
+		},
+		taskGroupContext
+	);
 }
 
 template<class PointIterator>
-unsigned char KDTree<PointIterator>::majorAxis( PermutationConstIterator permFirst, PermutationConstIterator permLast )
+unsigned char KDTree<PointIterator>::majorAxis( BuildIterator first, BuildIterator last )
 {
 	Point min, max;
 	for( unsigned char i=0; i<VectorTraits<Point>::dimensions(); i++ ) {
 		min[i] = Imath::limits<BaseType>::max();
 		max[i] = Imath::limits<BaseType>::min();
 	}
-	for( PermutationConstIterator it=permFirst; it!=permLast; it++ )
+	for( BuildIterator it=first; it!=last; it++ )
 	{
 		for( unsigned char i=0; i<VectorTraits<Point>::dimensions(); i++ )
 		{
-			if( (**it)[i] < min[i] )
+			if( it->point[i] < min[i] )
 			{
-				min[i] = (**it)[i];
+				min[i] = it->point[i];
 			}
-			if( (**it)[i] > max[i] )
+			if( it->point[i] > max[i] )
 			{
-				max[i] = (**it)[i];
+				max[i] = it->point[i];
 			}
 		}
 	}
@@ -174,33 +219,49 @@ unsigned char KDTree<PointIterator>::majorAxis( PermutationConstIterator permFir
 }
 
 template<class PointIterator>
-void KDTree<PointIterator>::build( NodeIndex nodeIndex, PermutationIterator permFirst, PermutationIterator permLast )
+void KDTree<PointIterator>::build( NodeIndex nodeIndex, BuildEntries &entries, size_t first, size_t last )
 {
-	// make room for the new node
-	if( nodeIndex>=m_nodes.size() )
-	{
-		m_nodes.resize( nodeIndex+1 );
-	}
+	assert( nodeIndex < m_nodes.size() );
 
-	if( permLast - permFirst > m_maxLeafSize )
+	if( last - first > (size_t)m_maxLeafSize )
 	{
-		unsigned int cutAxis = majorAxis( permFirst, permLast );
-		PermutationIterator permMid = permFirst  + (permLast - permFirst)/2;
-		std::nth_element( permFirst, permMid, permLast, AxisSort( cutAxis ) );
-		BaseType cutValue = (**permMid)[cutAxis];
+		unsigned int cutAxis = majorAxis( entries.begin() + first, entries.begin() + last );
+		size_t mid = first + (last - first)/2;
+		std::nth_element( entries.begin() + first, entries.begin() + mid, entries.begin() + last, AxisSort( cutAxis ) );
+		BaseType cutValue = entries[mid].point[cutAxis];
 		// insert node
 		m_nodes[nodeIndex].makeBranch( cutAxis, cutValue );
 
-		build( lowChildIndex( nodeIndex ), permFirst, permMid );
-		build( highChildIndex( nodeIndex ), permMid, permLast );
+		// The children occupy disjoint ranges of the entries and
+		// of the node array, so large subtrees can be built in parallel.
+		if( last - first >= m_minParallelBuildSize )
+		{
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_invoke(
+				[this, nodeIndex, &entries, first, mid] { build( lowChildIndex( nodeIndex ), entries, first, mid ); },
+				[this, nodeIndex, &entries, mid, last] { build( highChildIndex( nodeIndex ), entries, mid, last ); },
+				taskGroupContext
+			);
+		}
+		else
+		{
+			build( lowChildIndex( nodeIndex ), entries, first, mid );
+			build( highChildIndex( nodeIndex ), entries, mid, last );
+		}
 	}
 	else
 	{
 		// leaf node
-		m_nodes[nodeIndex].makeLeaf( permFirst, permLast );
+		m_nodes[nodeIndex].makeLeaf( m_perm.begin() + first, m_perm.begin() + last );
 	}
 }
 
+template<class PointIterator>
+inline const typename KDTree<PointIterator>::Point *KDTree<PointIterator>::leafPoints( const Node &node ) const
+{
+	return m_points.data() + ( node.permFirst() - m_perm.data() );
+}
+
 // nearest neighbour searching
 
 template<class PointIterator>
@@ -252,6 +313,108 @@ unsigned int KDTree<PointIterator>::nearestNNeighbours( const Point &p, unsigned
 	return nearNeighbours.size();
 }
 
+template<class PointIterator>
+template<typename QueryIterator>
+void KDTree<PointIterator>::batchNearestNeighbours( QueryIterator first, QueryIterator last, BaseType r, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const
+{
+	const size_t numQueries = last - first;
+	const BaseType r2 = r * r;
+
+	// We don't know how many neighbours each query will find, so we process
+	// the queries in fixed size blocks, accumulating the neighbours for each
+	// block separately and recording the count for each query in `offsets`.
+	// We then convert the counts to offsets and concatenate the blocks.
+	const size_t blockSize = 1024;
+	const size_t numBlocks = ( numQueries + blockSize - 1 ) / blockSize;
+	std::vector<std::vector<Neighbour>> blockNeighbours( numBlocks );
+
+	offsets.resize( numQueries + 1 );
+	offsets[0] = 0;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t block = range.begin(); block != range.end(); ++block )
+			{
+				std::vector<Neighbour> &neighbours = blockNeighbours[block];
+				const size_t blockEnd = std::min( ( block + 1 ) * blockSize, numQueries );
+				for( size_t i = block * blockSize; i < blockEnd; ++i )
+				{
+					const size_t sizeBefore = neighbours.size();
+					nearestNeighboursWalk( rootIndex(), *(first + i), r2, neighbours );
+					offsets[i+1] = neighbours.size() - sizeBefore;
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < numQueries; ++i )
+	{
+		offsets[i+1] += offsets[i];
+	}
+
+	nearNeighbours.clear();
+	nearNeighbours.resize( offsets[numQueries], Neighbour( m_lastPoint, 0 ) );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t block = range.begin(); block != range.end(); ++block )
+			{
+				std::copy(
+					blockNeighbours[block].begin(), blockNeighbours[block].end(),
+					nearNeighbours.begin() + offsets[block * blockSize]
+				);
+			}
+		},
+		taskGroupContext
+	);
+}
+
+template<class PointIterator>
+template<typename QueryIterator>
+void KDTree<PointIterator>::batchNearestNNeighbours( QueryIterator first, QueryIterator last, unsigned int numNeighbours, std::vector<size_t> &offsets, std::vector<Neighbour> &nearNeighbours ) const
+{
+	const size_t numQueries = last - first;
+
+	// Every query finds the same number of neighbours, so we know where
+	// each result goes before we start.
+	const size_t numFound = std::min<size_t>( numNeighbours, m_perm.size() );
+
+	offsets.resize( numQueries + 1 );
+	for( size_t i = 0; i <= numQueries; ++i )
+	{
+		offsets[i] = i * numFound;
+	}
+
+	nearNeighbours.clear();
+	nearNeighbours.resize( numQueries * numFound, Neighbour( m_lastPoint, 0 ) );
+	if( !numFound )
+	{
+		return;
+	}
+
+	// Scratch space for the heap, reused by all the queries made on each thread.
+	tbb::enumerable_thread_specific<std::vector<Neighbour>> threadNeighbours;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numQueries ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			std::vector<Neighbour> &neighbours = threadNeighbours.local();
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				nearestNNeighbours( *(first + i), numNeighbours, neighbours );
+				assert( neighbours.size() == numFound );
+				std::copy( neighbours.begin(), neighbours.end(), nearNeighbours.begin() + offsets[i] );
+			}
+		},
+		taskGroupContext
+	);
+}
+
 template<class PointIterator>
 void KDTree<PointIterator>::nearestNeighbourWalk( NodeIndex nodeIndex, const Point &p, PointIterator &closestPoint, BaseType &distSquared ) const
 {
@@ -259,9 +422,10 @@ void KDTree<PointIterator>::nearestNeighbourWalk( NodeIndex nodeIndex, const Poi
 	if( node.isLeaf() )
 	{
 		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Point *point = leafPoints( node );
+		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++, point++ )
 		{
-			const Point &pp = **perm;
+			const Point &pp = *point;
 			BaseType dist2 = vecDistance2( p, pp );
 
 			if( dist2 < distSquared )
@@ -296,20 +460,34 @@ void KDTree<PointIterator>::nearestNeighbourWalk( NodeIndex nodeIndex, const Poi
 }
 
 template<class PointIterator>
-void KDTree<PointIterator>::nearestNeighboursWalk( NodeIndex nodeIndex, const Point &p, BaseType r2, std::vector<PointIterator> &nearNeighbours ) const
+inline void KDTree<PointIterator>::appendNeighbour( const PointIterator &point, BaseType dist2, std::vector<PointIterator> &nearNeighbours ) const
+{
+	nearNeighbours.push_back( point );
+}
+
+template<class PointIterator>
+inline void KDTree<PointIterator>::appendNeighbour( const PointIterator &point, BaseType dist2, std::vector<Neighbour> &nearNeighbours ) const
+{
+	nearNeighbours.push_back( Neighbour( point, dist2 ) );
+}
+
+template<class PointIterator>
+template<typename NeighbourContainer>
+void KDTree<PointIterator>::nearestNeighboursWalk( NodeIndex nodeIndex, const Point &p, BaseType r2, NeighbourContainer &nearNeighbours ) const
 {
 	const Node &node = m_nodes[nodeIndex];
 	if( node.isLeaf() )
 	{
 		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Point *point = leafPoints( node );
+		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++, point++ )
 		{
-			const Point &pp = **perm;
+			const Point &pp = *point;
 			BaseType dist2 = vecDistance2( p, pp );
 
 			if (dist2 < r2 )
 			{
-				nearNeighbours.push_back( *perm );
+				appendNeighbour( *perm, dist2, nearNeighbours );
 			}
 		}
 	}
@@ -344,9 +522,10 @@ void KDTree<PointIterator>::nearestNNeighboursWalk( NodeIndex nodeIndex, const P
 	if( node.isLeaf() )
 	{
 		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Point *point = leafPoints( node );
+		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++, point++ )
 		{
-			const Point &pp = **perm;
+			const Point &pp = *point;
 			BaseType dist2 = vecDistance2( p, pp );
 
 			if( dist2 < maxDistSquared || nearNeighbours.size() < numNeighbours )
@@ -408,9 +587,10 @@ void KDTree<PointIterator>::enclosedPointsWalk( NodeIndex nodeIndex, const Box &
 	if( node.isLeaf() )
 	{
 		PointIterator *permLast = node.permLast();
-		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Point *point = leafPoints( node );
+		for( PointIterator *perm = node.permFirst(); perm!=permLast; perm++, point++ )
 		{
-			const Point &pp = **perm;
+			const Point &pp = *point;
 			if( boxIntersects( bound, pp ) )
 			{
 				*it++ = *perm;
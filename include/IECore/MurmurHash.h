@@ -71,6 +71,10 @@ class IECORE_API MurmurHash
 
 		MurmurHash();
 		MurmurHash( const MurmurHash &other );
+		/// Constructs from the two halves of a hash previously
+		/// retrieved using h1() and h2(), for instance when a hash
+		/// has been stored in a file.
+		MurmurHash( uint64_t h1, uint64_t h2 );
 
 		inline MurmurHash &append( char data );
 		inline MurmurHash &append( unsigned char data );
@@ -155,6 +159,9 @@ class IECORE_API MurmurHash
 
 		std::string toString() const;
 
+		inline uint64_t h1() const;
+		inline uint64_t h2() const;
+
 	private :
 
 		inline void append( const void *data, size_t bytes, int elementSize );
@@ -164,6 +164,13 @@ class IECORE_API Object : public RunTimeTyped
 		/// Loads an object previously saved with the given name in the current directory
 		/// of ioInterface.
 		static ObjectPtr load( ConstIndexedIOPtr ioInterface, const IndexedIO::EntryID &name );
+		/// Enables the concurrent loading of the members of CompoundObject,
+		/// CompoundData, ObjectVector and the primitive variables of Primitive.
+		/// This is only used for files opened in Read mode. The file layout
+		/// is unaffected. The default may be specified using the
+		/// IECORE_OBJECT_PARALLELLOADING environment variable.
+		static void setParallelLoading( bool parallelLoading );
+		static bool getParallelLoading();
 		//@}
 
 		typedef std::function<ObjectPtr ()> CreatorFn;
@@ -264,18 +271,35 @@ class IECORE_API Object : public RunTimeTyped
 				template<class T>
 				/// Load an Object instance previously saved by SaveContext::save().
 				typename T::Ptr load( const IndexedIO *container, const IndexedIO::EntryID &name );
+				/// As for load(), but allows the loaded object to defer reading its
+				/// data until it is first accessed. Whether or not this is done is up
+				/// to the object's load() implementation, which should query lazy().
+				/// See Data::setLazyLoading() for details.
+				template<class T>
+				typename T::Ptr loadLazily( const IndexedIO *container, const IndexedIO::EntryID &name );
+				/// Returns true if the object being loaded was requested using loadLazily(),
+				/// and the file is open for reading only. In this case, load() may keep a
+				/// reference to rawContainer() or container() and read from it later.
+				bool lazy() const;
+				/// Calls `loader( i )` for each `i` in the range `[0, numObjects)`, concurrently
+				/// if parallel loading is enabled (see Object::setParallelLoading()). This
+				/// should be used by classes which load several independent members. The
+				/// loader may call load() and loadLazily(), but must otherwise only access
+				/// state specific to `i`.
+				void parallelLoad( size_t numObjects, const std::function<void ( size_t )> &loader );
 				/// Returns an interface to a raw container created by SaveContext::rawContainer() - please see
 				/// documentation and cautionary notes for that function.
 				const IndexedIO *rawContainer();
 
 			private :
 				struct LoadedObjects;
-				LoadContext( ConstIndexedIOPtr ioInterface, std::shared_ptr<LoadedObjects> loadedObjects );
-				ObjectPtr loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name );
-				ObjectPtr loadObject( const IndexedIO *container );
+				LoadContext( ConstIndexedIOPtr ioInterface, std::shared_ptr<LoadedObjects> loadedObjects, bool lazy );
+				ObjectPtr loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name, bool lazy );
+				ObjectPtr loadObject( const IndexedIO *container, bool lazy );
 
 				ConstIndexedIOPtr m_ioInterface;
 				std::shared_ptr<LoadedObjects> m_loadedObjects;
+				bool m_lazy;
 		};
 		IE_CORE_DECLAREPTR( LoadContext );
 
@@ -287,8 +311,8 @@ class IECORE_API Object : public RunTimeTyped
 		/// Must be implemented in all derived classes. Implementations should first call the parent class load() method,
 		/// then call context->container() before loading their member data from that container.
 		/// context is a smart pointer to a reference counted object to allow you to keep the
-		/// context and perform lazy loading at a later date - although this is not yet used
-		/// by any of the core types. A call to context->container() will throw an Exception if the corresponding
+		/// context and perform lazy loading at a later date - see LoadContext::lazy().
+		/// A call to context->container() will throw an Exception if the corresponding
 		/// save() method did not create a container.
 		virtual void load( LoadContextPtr context ) = 0;
 
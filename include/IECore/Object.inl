@@ -84,7 +84,13 @@ Object::TypeDescription<T>::TypeDescription( TypeId alternateTypeId, const std::
 template<class T>
 typename T::Ptr Object::LoadContext::load( const IndexedIO *i, const IndexedIO::EntryID &name )
 {
-	return runTimeCast<T>( loadObjectOrReference( i, name ) );
+	return runTimeCast<T>( loadObjectOrReference( i, name, false ) );
+}
+
+template<class T>
+typename T::Ptr Object::LoadContext::loadLazily( const IndexedIO *i, const IndexedIO::EntryID &name )
+{
+	return runTimeCast<T>( loadObjectOrReference( i, name, true ) );
 }
 
 } // namespace IECore
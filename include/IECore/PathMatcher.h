@@ -41,14 +41,19 @@
 #include "IECore/InternedString.h"
 #include "IECore/RefCounted.h"
 
+#include "boost/iterator/iterator_facade.hpp"
 #include "boost/iterator_adaptors.hpp"
 
 #include <map>
+#include <unordered_set>
 #include <vector>
 
 namespace IECore
 {
 
+class MurmurHash;
+template<class T> class TypedData;
+
 /// The PathMatcher class provides an acceleration structure for matching
 /// paths against a sequence of reference paths. It provides the internal
 /// implementation for the PathFilter.
@@ -74,6 +79,14 @@ class IECORE_API PathMatcher
 		template<typename PathIterator>
 		PathMatcher( PathIterator pathsBegin, PathIterator pathsEnd );
 
+		/// Constructs from paths which have been sorted lexicographically,
+		/// for instance using `std::sort()`. Duplicate paths are permitted.
+		/// This is significantly faster than adding the paths one at a time,
+		/// builds independent subtrees in parallel, and produces the compact
+		/// representation described in `compact()`. Throws if the paths are
+		/// not sorted.
+		explicit PathMatcher( const std::vector<std::vector<IECore::InternedString>> &sortedPaths );
+
 		template<typename PathIterator>
 		void init( PathIterator pathsBegin, PathIterator pathsEnd );
 
@@ -88,6 +101,8 @@ class IECORE_API PathMatcher
 
 		/// Adds all paths from the other PathMatcher, returning true if
 		/// any were added, and false if they were all already present.
+		/// Independent subtrees are processed in parallel, as are those
+		/// of `removePaths()` and `intersection()`.
 		bool addPaths( const PathMatcher &paths );
 		/// As above, but prefixing the paths that are added.
 		bool addPaths( const PathMatcher &paths, const std::vector<IECore::InternedString> &prefix );
@@ -110,6 +125,19 @@ class IECORE_API PathMatcher
 
 		void clear();
 
+		/// Converts the internal representation into a compact form which
+		/// stores the children of each location in a sorted array rather than
+		/// a map. This uses significantly less memory and gives better locality
+		/// for `match()` and iteration, so is well suited to large sets which
+		/// are constructed once and then queried many times. Compaction is
+		/// transparent to all other methods, and edits made after compaction
+		/// are still supported, with the edited locations being converted back
+		/// to the regular form as necessary. Compaction never modifies locations
+		/// shared with other PathMatchers via copy-on-write, so it is safe to
+		/// compact copies which are being read concurrently elsewhere.
+		/// Complexity : linear in the number of stored locations.
+		void compact();
+
 		bool isEmpty() const;
 		/// Returns the number of paths that have been explicitly
 		/// added. Complexity : linear in the number of stored
@@ -128,6 +156,16 @@ class IECORE_API PathMatcher
 		bool operator == ( const PathMatcher &other ) const;
 		bool operator != ( const PathMatcher &other ) const;
 
+		/// Appends a hash of the stored paths to `h`. The hash is independent
+		/// of the order in which paths were added, and of the internal
+		/// representation. Independent subtrees are hashed in parallel.
+		void hash( MurmurHash &h ) const;
+
+		/// Returns an estimate of the memory used by the stored paths, in
+		/// bytes. Locations shared with other PathMatchers via copy-on-write
+		/// are included. Complexity : linear in the number of stored locations.
+		size_t memoryUsage() const;
+
 		class RawIterator;
 		class Iterator;
 
@@ -196,15 +234,55 @@ class IECORE_API PathMatcher
 				typedef ChildMap::iterator ChildMapIterator;
 				typedef ChildMap::value_type ChildMapValue;
 				typedef ChildMap::const_iterator ConstChildMapIterator;
+				// Container used to store the children of compacted nodes.
+				// This holds the same values as the ChildMap would, sorted
+				// in the same order, but without the per-child allocation
+				// and pointer overhead of the map.
+				typedef std::vector<ChildMapValue> ChildVector;
+
+				// Provides read-only iteration over the children of
+				// a node, regardless of which container holds them.
+				class ConstChildIterator : public boost::iterator_facade<ConstChildIterator, const ChildMapValue, boost::bidirectional_traversal_tag>
+				{
+
+					public :
+
+						ConstChildIterator();
+						ConstChildIterator( ConstChildMapIterator it );
+						ConstChildIterator( const ChildMapValue *it );
+
+					private :
+
+						friend class boost::iterator_core_access;
+
+						void increment();
+						void decrement();
+						bool equal( const ConstChildIterator &other ) const;
+						const ChildMapValue &dereference() const;
+
+						ConstChildMapIterator m_mapIt;
+						const ChildMapValue *m_vectorIt;
+						bool m_compact;
+
+				};
 
 				Node( bool terminator = false );
-				// Shallow copy.
+				// Shallow copy. The copy always stores its children
+				// in `children`, so that it may be edited.
 				Node( const Node &other );
 				~Node() override;
 
+				// Read access to the children. These may be used
+				// with both compact and regular nodes.
+				ConstChildIterator childrenBegin() const;
+				ConstChildIterator childrenEnd() const;
+				ConstChildIterator findChild( const Name &name ) const;
+				bool hasChildren() const;
+				size_t numChildren() const;
+
 				// Returns an iterator to the first child whose name contains wildcards.
-				// All children between here and children.end() will also contain wildcards.
-				ConstChildMapIterator wildcardsBegin() const;
+				// All children between here and childrenEnd() will also contain wildcards.
+				ConstChildIterator wildcardsBegin() const;
 
 				Node *child( const Name &name );
 				const Node *child( const Name &name ) const;
@@ -216,7 +294,20 @@ class IECORE_API PathMatcher
 				bool clearChildren();
 				bool isEmpty();
 
+				// Returns true if the children are held in
+				// `compactChildren` rather than `children`.
+				bool isCompact() const;
+				// Moves any compact children into `children`,
+				// so that they may be edited. Must only be
+				// called on nodes which are not shared.
+				void expand();
+
+				// Children are stored in exactly one of these
+				// containers, and the other is always empty. Edits
+				// must only be made to `children`, after calling
+				// `expand()`.
 				ChildMap children;
+				ChildVector compactChildren;
 				bool terminator;
 
 				// For most Node trees, the number of leaf nodes
@@ -243,6 +334,24 @@ class IECORE_API PathMatcher
 		NodePtr addPrefixedPathsWalk( Node *node, const Node *srcNode, const NameIterator &start, const NameIterator &end, bool shared, bool &added  );
 		NodePtr removePathsWalk( Node *node, const Node *srcNode, bool shared, bool &removed );
 
+		NodePtr compactWalk( Node *node );
+
+		typedef std::vector<std::vector<IECore::InternedString>>::const_iterator SortedPathIterator;
+		static NodePtr buildWalk( SortedPathIterator begin, SortedPathIterator end, size_t depth );
+		static NodePtr intersectionWalk( Node *node, Node *otherNode );
+		static void hashWalk( const Node *node, MurmurHash &h );
+		static size_t memoryUsageWalk( const Node *node, std::unordered_set<const Node *> &visited );
+		static NodePtr compactNode( bool terminator, const std::vector<Name> &names, const std::vector<NodePtr> &children );
+
+		// Serialisation support for PathMatcherData. The paths are encoded
+		// into a single flat block of bytes, described in PathMatcher.cpp,
+		// which can be decoded again in parallel.
+		friend class TypedData<PathMatcher>;
+		void encode( std::vector<char> &data ) const;
+		static PathMatcher decode( const char *data, size_t size );
+		struct EncodedTree;
+		static NodePtr decodeWalk( const EncodedTree &tree, size_t index );
+
 		void matchWalk( const Node *node, const NameIterator &start, const NameIterator &end, unsigned &result ) const;
 
 		NodePtr m_root;
@@ -301,19 +410,19 @@ class PathMatcher::RawIterator : public boost::iterator_facade<RawIterator, cons
 		struct Level
 		{
 
-			Level( const Node::ChildMap &children, Node::ConstChildMapIterator it );
+			Level( const Node &node, Node::ConstChildIterator it );
 
 			bool operator == ( const Level &other ) const;
 
-			Node::ConstChildMapIterator end;
-			Node::ConstChildMapIterator it;
+			Node::ConstChildIterator end;
+			Node::ConstChildIterator it;
 
 		};
 
 		typedef std::vector<Level> Levels;
 		Levels m_stack;
 		std::vector<IECore::InternedString> m_path;
-		// Because there is no ChildMapIterator for the root
+		// Because there is no ConstChildIterator for the root
 		// node, we have to store it explicitly. The value
 		// will be non-null only when we're pointing at the root.
 		Node *m_nodeIfRoot;
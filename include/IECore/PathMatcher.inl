@@ -60,6 +60,100 @@ void PathMatcher::init( PathIterator pathsBegin, PathIterator pathsEnd )
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Node::ConstChildIterator
+//////////////////////////////////////////////////////////////////////////
+
+inline PathMatcher::Node::ConstChildIterator::ConstChildIterator()
+	:	m_vectorIt( nullptr ), m_compact( false )
+{
+}
+
+inline PathMatcher::Node::ConstChildIterator::ConstChildIterator( ConstChildMapIterator it )
+	:	m_mapIt( it ), m_vectorIt( nullptr ), m_compact( false )
+{
+}
+
+inline PathMatcher::Node::ConstChildIterator::ConstChildIterator( const ChildMapValue *it )
+	:	m_vectorIt( it ), m_compact( true )
+{
+}
+
+inline void PathMatcher::Node::ConstChildIterator::increment()
+{
+	if( m_compact )
+	{
+		++m_vectorIt;
+	}
+	else
+	{
+		++m_mapIt;
+	}
+}
+
+inline void PathMatcher::Node::ConstChildIterator::decrement()
+{
+	if( m_compact )
+	{
+		--m_vectorIt;
+	}
+	else
+	{
+		--m_mapIt;
+	}
+}
+
+inline bool PathMatcher::Node::ConstChildIterator::equal( const ConstChildIterator &other ) const
+{
+	if( m_compact != other.m_compact )
+	{
+		return false;
+	}
+	return m_compact ? m_vectorIt == other.m_vectorIt : m_mapIt == other.m_mapIt;
+}
+
+inline const PathMatcher::Node::ChildMapValue &PathMatcher::Node::ConstChildIterator::dereference() const
+{
+	return m_compact ? *m_vectorIt : *m_mapIt;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Node
+//////////////////////////////////////////////////////////////////////////
+
+inline bool PathMatcher::Node::isCompact() const
+{
+	return !compactChildren.empty();
+}
+
+inline PathMatcher::Node::ConstChildIterator PathMatcher::Node::childrenBegin() const
+{
+	if( isCompact() )
+	{
+		return ConstChildIterator( compactChildren.data() );
+	}
+	return ConstChildIterator( children.begin() );
+}
+
+inline PathMatcher::Node::ConstChildIterator PathMatcher::Node::childrenEnd() const
+{
+	if( isCompact() )
+	{
+		return ConstChildIterator( compactChildren.data() + compactChildren.size() );
+	}
+	return ConstChildIterator( children.end() );
+}
+
+inline bool PathMatcher::Node::hasChildren() const
+{
+	return !children.empty() || !compactChildren.empty();
+}
+
+inline size_t PathMatcher::Node::numChildren() const
+{
+	return children.size() + compactChildren.size();
+}
+
 //////////////////////////////////////////////////////////////////////////
 // RawIterator
 //////////////////////////////////////////////////////////////////////////
@@ -83,11 +177,11 @@ inline PathMatcher::RawIterator::RawIterator( const PathMatcher &matcher, bool a
 {
 	if( atEnd )
 	{
-		m_stack.push_back( Level( matcher.m_root->children, matcher.m_root->children.end() ) );
+		m_stack.push_back( Level( *matcher.m_root, matcher.m_root->childrenEnd() ) );
 	}
 	else
 	{
-		m_stack.push_back( Level( matcher.m_root->children, matcher.m_root->children.begin() ) );
+		m_stack.push_back( Level( *matcher.m_root, matcher.m_root->childrenBegin() ) );
 		if( !matcher.isEmpty() )
 		{
 			m_nodeIfRoot = matcher.m_root.get();
@@ -100,7 +194,7 @@ inline PathMatcher::RawIterator::RawIterator( const PathMatcher &matcher, const
 {
 	if( !path.size() )
 	{
-		m_stack.push_back( Level( matcher.m_root->children, matcher.m_root->children.begin() ) );
+		m_stack.push_back( Level( *matcher.m_root, matcher.m_root->childrenBegin() ) );
 		if( !matcher.isEmpty() )
 		{
 			m_nodeIfRoot = matcher.m_root.get();
@@ -111,15 +205,15 @@ inline PathMatcher::RawIterator::RawIterator( const PathMatcher &matcher, const
 	Node *node = matcher.m_root.get();
 	for( std::vector<IECore::InternedString>::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
 	{
-		Node::ConstChildMapIterator cIt = node->children.find( *it );
-		if( cIt == node->children.end() )
+		Node::ConstChildIterator cIt = node->findChild( *it );
+		if( cIt == node->childrenEnd() )
 		{
 			// path doesn't exist
 			m_stack.clear();
-			m_stack.push_back( Level( matcher.m_root->children, matcher.m_root->children.end() ) );
+			m_stack.push_back( Level( *matcher.m_root, matcher.m_root->childrenEnd() ) );
 			return;
 		}
-		m_stack.push_back( Level( node->children, cIt ) );
+		m_stack.push_back( Level( *node, cIt ) );
 		node = cIt->second.get();
 	}
 	m_path = path;
@@ -135,12 +229,12 @@ inline void PathMatcher::RawIterator::increment()
 	}
 
 	const Node *node = m_stack.back().it->second.get();
-	if( !m_pruned && !node->children.empty() )
+	if( !m_pruned && node->hasChildren() )
 	{
 		m_stack.push_back(
 			Level(
-				node->children,
-				node->children.begin()
+				*node,
+				node->childrenBegin()
 			)
 		);
 		m_path.push_back( m_stack.back().it->first.name );
@@ -189,8 +283,8 @@ inline PathMatcher::Node *PathMatcher::RawIterator::node() const
 	return nullptr;
 }
 
-inline PathMatcher::RawIterator::Level::Level( const Node::ChildMap &children, Node::ConstChildMapIterator it )
-	:	end( children.end() ), it( it )
+inline PathMatcher::RawIterator::Level::Level( const Node &node, Node::ConstChildIterator it )
+	:	end( node.childrenEnd() ), it( it )
 {
 }
 
@@ -35,11 +35,50 @@
 #ifndef IECORE_TYPEDDATAINTERNALS_H
 #define IECORE_TYPEDDATAINTERNALS_H
 
+#include "IECore/Data.h"
 #include "IECore/MurmurHash.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 namespace IECore
 {
 
+namespace Detail
+{
+
+// Arrays are split into blocks of this size for Data::ChunkedHash.
+static const size_t g_hashChunkBytes = 1024 * 1024;
+
+// Calls `chunkHash( i, hash )` in parallel for each of `numChunks` chunks,
+// and appends the combined result to `h`.
+IECORE_API void appendChunkHashes( MurmurHash &h, size_t numElements, size_t numChunks, const std::function<void ( size_t, MurmurHash & )> &chunkHash );
+
+// Appends the hash of an array to `h`, using the specified algorithm.
+template<typename T>
+void appendArray( MurmurHash &h, const T *data, size_t numElements, Data::HashVersion hashVersion )
+{
+	const size_t chunkSize = std::max<size_t>( g_hashChunkBytes / sizeof( T ), 1 );
+	if( hashVersion == Data::SerialHash || numElements <= chunkSize )
+	{
+		h.append( data, numElements );
+		return;
+	}
+
+	appendChunkHashes(
+		h, numElements, ( numElements + chunkSize - 1 ) / chunkSize,
+		[data, numElements, chunkSize]( size_t chunk, MurmurHash &chunkHash ) {
+			const size_t begin = chunk * chunkSize;
+			chunkHash.append( data + begin, std::min( chunkSize, numElements - begin ) );
+		}
+	);
+}
+
+} // namespace Detail
+
 template<class T>
 class IECORE_EXPORT SimpleDataHolder
 {
@@ -101,12 +140,14 @@ class IECORE_EXPORT SharedDataHolder
 		const T &readable() const
 		{
 			assert( m_data );
+			m_data->loadIfNecessary();
 			return m_data->data;
 		}
 
 		T &writable()
 		{
 			assert( m_data );
+			m_data->loadIfNecessary();
 			if( m_data->refCount() > 1 )
 			{
 				// duplicate the data
@@ -134,12 +175,47 @@ class IECORE_EXPORT SharedDataHolder
 		// datatype has special needs.
 		void hash( MurmurHash &h ) const
 		{
-			if( !m_data->hashValid )
+			h.append( valueHash() );
+		}
+
+		// Returns the hash that hash( h ) appends, computing
+		// it if necessary.
+		MurmurHash valueHash() const
+		{
+			const Data::HashVersion hashVersion = Data::getHashVersion();
+			if( !m_data->hashValid || m_data->hashVersion != hashVersion )
 			{
 				m_data->hash = hash();
+				m_data->hashVersion = hashVersion;
+				m_data->hashValid = true;
+			}
+			return m_data->hash;
+		}
+
+		typedef std::function<void ( T & )> Loader;
+
+		// Defers the filling of the data until it is first accessed via
+		// readable() or writable(), at which point `loader` is called
+		// from within a lock. If `hash` is provided then it is used as
+		// the result of valueHash() for `hashVersion`, so that hashing
+		// doesn't require loading.
+		void setLoader( const Loader &loader, const MurmurHash *hash = nullptr, Data::HashVersion hashVersion = Data::SerialHash )
+		{
+			m_data = new Shareable;
+			m_data->loader.reset( new LazyLoader( loader ) );
+			m_data->lazy = true;
+			if( hash )
+			{
+				m_data->hash = *hash;
+				m_data->hashVersion = hashVersion;
 				m_data->hashValid = true;
 			}
-			h.append( m_data->hash );
+		}
+
+		// Returns false if a loader is still pending.
+		bool loaded() const
+		{
+			return !m_data->lazy.load( std::memory_order_acquire );
 		}
 
 	protected :
@@ -147,22 +223,60 @@ class IECORE_EXPORT SharedDataHolder
 		MurmurHash hash() const
 		{
 			MurmurHash result;
-			result.append( &(readable()[0]), readable().size() );
+			Detail::appendArray( result, &(readable()[0]), readable().size(), Data::getHashVersion() );
 			return result;
 		}
 
 	private :
 
+		struct LazyLoader
+		{
+			LazyLoader( const Loader &l ) : loader( l ) {}
+			Loader loader;
+			std::mutex mutex;
+		};
+
 		class IECORE_EXPORT Shareable : public RefCounted
 		{
 			public :
 
-				Shareable() : data(), hashValid( false ) {}
-				Shareable( const T &initData ) : data( initData ), hashValid( false ) {}
+				Shareable() : data(), hashValid( false ), hashVersion( Data::SerialHash ), lazy( false ) {}
+				Shareable( const T &initData ) : data( initData ), hashValid( false ), hashVersion( Data::SerialHash ), lazy( false ) {}
+
+				void loadIfNecessary()
+				{
+					if( lazy.load( std::memory_order_acquire ) )
+					{
+						load();
+					}
+				}
 
 				T data;
 				MurmurHash hash;
 				volatile bool hashValid;
+				volatile Data::HashVersion hashVersion;
+				// The loader is kept until destruction rather than
+				// being reset after use, because other threads may be
+				// waiting on its mutex.
+				std::unique_ptr<LazyLoader> loader;
+				std::atomic_bool lazy;
+
+			private :
+
+				void load()
+				{
+					std::lock_guard<std::mutex> lock( loader->mutex );
+					if( lazy.load( std::memory_order_relaxed ) )
+					{
+						// If the loader throws we remain lazy, so that
+						// subsequent accesses can try again.
+						loader->loader( data );
+						// Release the loader's resources (typically an
+						// open file) now that they are no longer needed.
+						loader->loader = Loader();
+						lazy.store( false, std::memory_order_release );
+					}
+				}
 
 		};
 
@@ -51,9 +51,19 @@ class IECOREGL_API MeshPrimitive : public Primitive
 
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( IECoreGL::MeshPrimitive, MeshPrimitiveTypeId, Primitive );
 
+		/// Constructs a mesh drawn as an unindexed list of triangles, with
+		/// FaceVarying primitive variables providing the vertex attributes.
 		MeshPrimitive( unsigned numTriangles );
+		/// Constructs a mesh drawn with `glDrawElements()`, where each
+		/// consecutive triple of `vertexIds` forms a triangle. Vertex and
+		/// Varying primitive variables provide the vertex attributes.
+		MeshPrimitive( IECore::ConstUIntVectorDataPtr vertexIds );
 		~MeshPrimitive() override;
 
+		/// Returns the vertex indices for an indexed mesh, or
+		/// nullptr for an unindexed one.
+		const IECore::UIntVectorData *vertexIds() const;
+
 		Imath::Box3f bound() const override;
 
 		void addPrimitiveVariable( const std::string &name, const IECoreScene::PrimitiveVariable &primVar ) override;
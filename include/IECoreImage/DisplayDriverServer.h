@@ -52,7 +52,9 @@ namespace IECoreImage
 /// Server class that receives images from ClientDisplayDriver connections and forwards the data to local display drivers.
 /// The type of the local display drivers is defined by the 'remoteDisplayType' parameter.
 ///
-/// The server object creates a thread to control the socket connection. The thread dies when the object is destroyed.
+/// The server object creates a pool of threads to service the socket connections. The threads die when the object
+/// is destroyed. Each client connection is handled by a Session, whose handlers are serialised by a strand so that
+/// messages for a single image are always processed in order, while separate sessions may be processed concurrently.
 /// \ingroup renderingGroup
 class IECOREIMAGE_API DisplayDriverServer : public IECore::RunTimeTyped
 {
@@ -62,11 +64,16 @@ class IECOREIMAGE_API DisplayDriverServer : public IECore::RunTimeTyped
 
 		/// A port number of 0 causes a free port to be chosen
 		/// automatically. Call `portNumber()` after construction
-		/// to retrieve the actual number.
-		DisplayDriverServer( int portNumber = 0 );
+		/// to retrieve the actual number. The `numThreads` argument
+		/// specifies how many threads are used to service client
+		/// connections - a value of 0 causes one thread per hardware
+		/// thread to be used.
+		DisplayDriverServer( int portNumber = 0, int numThreads = 1 );
 		~DisplayDriverServer() override;
 
 		int portNumber();
+		/// Returns the number of threads servicing connections.
+		int numThreads();
 
 	private:
 
@@ -40,13 +40,117 @@
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
 
+#include "IECore/Exception.h"
+#include "IECore/VectorTypedData.h"
+
 #include "boost/python/suite/indexing/container_utils.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <type_traits>
 
 namespace IECorePython
 {
 
+namespace Detail
+{
+
+/// Returns a new Python object which exposes the memory at `address` via the
+/// buffer protocol, keeping `data` alive for as long as the object exists.
+IECOREPYTHON_API PyObject *dataBuffer( const IECore::Data *data, const void *address, const std::vector<Py_ssize_t> &shape, const char *format, size_t itemSize, bool readOnly );
+/// Returns true if memory described by the buffer protocol `format` and `itemSize`
+/// may be copied directly into memory of `requiredFormat` and `requiredItemSize`.
+IECOREPYTHON_API bool bufferFormatsMatch( const char *format, size_t itemSize, const char *requiredFormat, size_t requiredItemSize );
+
+/// Provides the buffer protocol format for the base type of VectorTypedData.
+/// A null format denotes types which can't be exposed as buffers.
+template<typename T>
+struct BufferFormat
+{
+	static const char *value() { return nullptr; }
+};
+
+#define IECOREPYTHON_DEFINEBUFFERFORMAT( TYPE, FORMAT ) \
+	template<> \
+	struct BufferFormat<TYPE> \
+	{ \
+		static const char *value() { return FORMAT; } \
+	}; \
+
+IECOREPYTHON_DEFINEBUFFERFORMAT( half, "e" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( float, "f" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( double, "d" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( char, "b" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned char, "B" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( short, "h" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned short, "H" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( int, "i" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned int, "I" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( int64_t, "q" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( uint64_t, "Q" )
+
+#undef IECOREPYTHON_DEFINEBUFFERFORMAT
+
+/// Appends the dimensions of a single element to a buffer shape,
+/// so that for instance a V3fVectorData has shape `( size, 3 )` and
+/// an M44fVectorData has shape `( size, 4, 4 )`.
+template<typename T>
+struct ElementShape
+{
+	static void append( std::vector<Py_ssize_t> &shape ) {}
+};
+
+template<typename T>
+struct ElementShape<Imath::Vec2<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 2 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Vec3<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 3 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Color3<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 3 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Color4<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 4 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Quat<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 4 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Matrix33<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 3 ); shape.push_back( 3 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Matrix44<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 4 ); shape.push_back( 4 ); }
+};
+
+template<typename T>
+struct ElementShape<Imath::Box<T>>
+{
+	static void append( std::vector<Py_ssize_t> &shape ) { shape.push_back( 2 ); ElementShape<T>::append( shape ); }
+};
+
+} // namespace Detail
+
 template<typename ThisClass>
 class VectorTypedDataFunctions
 {
@@ -81,11 +185,46 @@ class VectorTypedDataFunctions
 			else
 			{
 				ThisClassPtr r = new ThisClass();
+				if( !PyList_Check( v.ptr() ) && PyObject_CheckBuffer( v.ptr() ) )
+				{
+					// Objects such as numpy arrays can be copied with
+					// a single memcpy, rather than element by element.
+					if( copyFromBuffer( v.ptr(), r->writable(), BufferSupported() ) )
+					{
+						return r;
+					}
+				}
 				boost::python::container_utils::extend_container( r->writable(), v );
 				return r;
 			}
 		}
 
+		/// Returns an object providing read-only access to the data via
+		/// the buffer protocol, suitable for passing to `numpy.asarray()`.
+		/// The buffer references a snapshot of the data, and remains valid
+		/// and unchanged even if the data is subsequently modified.
+		static boost::python::object asReadOnlyBuffer( ThisClass &x )
+		{
+			return buffer( x, true );
+		}
+
+		/// As above, but allowing modification. The data is unshared
+		/// from any copies first, as for any other call to writable().
+		/// Modifications made via the buffer are visible in the data
+		/// until the data is next modified by other means, at which
+		/// point the data is unshared from the buffer again. The buffer
+		/// should not be used to modify the data after the data has
+		/// been copied. Modifications made via the buffer are not
+		/// tracked, so do not update a hash that has already been
+		/// computed for the data. Calling asReadWriteBuffer() again,
+		/// or modifying the data by other means, discards the stale
+		/// hash.
+		static boost::python::object asReadWriteBuffer( ThisClass &x )
+		{
+			x.writable();
+			return buffer( x, false );
+		}
+
 		//
 		static iterator begin( ThisClass &x )
 		{
@@ -546,6 +685,76 @@ class VectorTypedDataFunctions
 		 * Utility functions
 		 */
 
+		typedef typename ThisClass::BaseType BaseType;
+		typedef std::integral_constant<
+			bool,
+			( std::is_arithmetic<BaseType>::value && !std::is_same<BaseType, bool>::value ) || std::is_same<BaseType, half>::value
+		> BufferSupported;
+
+		static boost::python::object buffer( ThisClass &x, bool readOnly )
+		{
+			// The buffer keeps a copy of the data alive, rather than the data
+			// itself. The copy shares storage with `x` until either is modified,
+			// so any subsequent call to `x.writable()` unshares the storage,
+			// leaving the memory referenced by the buffer intact.
+			typename ThisClass::ConstPtr holder = x.copy();
+			const Container &container = holder->readable();
+
+			std::vector<Py_ssize_t> shape( 1, container.size() );
+			Detail::ElementShape<data_type>::append( shape );
+			return boost::python::object( boost::python::handle<>(
+				Detail::dataBuffer( holder.get(), container.data(), shape, Detail::BufferFormat<BaseType>::value(), sizeof( BaseType ), readOnly )
+			) );
+		}
+
+		// Returns false if `o` doesn't provide a buffer of the right type,
+		// and throws if it provides one of the right type but the wrong shape.
+		static bool copyFromBuffer( PyObject *o, Container &result, std::true_type )
+		{
+			Py_buffer view;
+			if( PyObject_GetBuffer( o, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT ) != 0 )
+			{
+				PyErr_Clear();
+				return false;
+			}
+
+			const bool formatMatches = Detail::bufferFormatsMatch( view.format, view.itemsize, Detail::BufferFormat<BaseType>::value(), sizeof( BaseType ) );
+
+			// We require the buffer to have the shape of our elements, so that
+			// for instance a flat array of floats isn't silently reinterpreted
+			// as an array of V3fs.
+			bool shapeMatches = false;
+			if( formatMatches && view.ndim > 0 )
+			{
+				std::vector<Py_ssize_t> shape( 1, view.shape[0] );
+				Detail::ElementShape<data_type>::append( shape );
+				shapeMatches = view.ndim == (int)shape.size() && std::equal( shape.begin() + 1, shape.end(), view.shape + 1 );
+			}
+
+			if( shapeMatches )
+			{
+				result.resize( view.shape[0] );
+				if( view.len )
+				{
+					std::memcpy( result.data(), view.buf, view.len );
+				}
+			}
+
+			PyBuffer_Release( &view );
+
+			if( formatMatches && !shapeMatches )
+			{
+				throw IECore::InvalidArgumentException( std::string( "Buffer shape does not match the elements of " ) + ThisClass::staticTypeName() );
+			}
+
+			return shapeMatches;
+		}
+
+		static bool copyFromBuffer( PyObject *o, Container &result, std::false_type )
+		{
+			return false;
+		}
+
 		/// converts from python indexes to non-negative C++ indexes.
 		static index_type convertIndex( ThisClass & container, PyObject *i_, bool acceptExpand = false )
 		{
@@ -727,6 +936,11 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 			.def("__str__", &str<ThisClass> )	\
 			.def("__repr__", &repr<ThisClass> )	\
 
+// provides access to the data via the buffer protocol, for use with numpy and the like
+#define BUFFER_VECTOR_BINDING\
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only view of the data which supports the buffer protocol, without copying. The view is unaffected by subsequent modifications to the data.")\
+				.def("asReadWriteBuffer", &ThisBinder::asReadWriteBuffer, "Returns a writable view of the data which supports the buffer protocol, without copying. Modifications via the view are visible in the data until the data is next modified by other means, and the view should not be used to modify the data once it has been copied. Modifications via the view do not update a hash that has already been computed for the data : call asReadWriteBuffer() again before hashing to discard it.")\
+
 // bind a VectorTypedData class that does not support Math operators
 #define BIND_VECTOR_TYPEDDATA(T, Tname)													\
 		{																							\
@@ -735,6 +949,17 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 			;																						\
 		}
 
+// bind a VectorTypedData class that does not support Math operators, but
+// whose elements are composed of simple numeric types
+#define BIND_NUMERIC_VECTOR_TYPEDDATA(T, Tname)											\
+		{																							\
+			BASIC_VECTOR_BINDING(IECore::TypedData< std::vector< T > >, Tname)																	\
+				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
+				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				BUFFER_VECTOR_BINDING\
+			;																						\
+		}
+
 // bind a VectorTypedData class that supports simple Math operators (+=, -= and *=)
 #define BIND_SIMPLE_OPERATED_VECTOR_TYPEDDATA(T, Tname)									\
 		{																							\
@@ -748,6 +973,7 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__imul__", &ThisBinder::imul, "inplace multiplication (s *= v) : accepts another vector of the same type or a single " Tname)		\
 				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				BUFFER_VECTOR_BINDING\
 			;																						\
 		}
 
@@ -768,6 +994,7 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__itruediv__", &ThisBinder::idiv, "inplace division (s /= v) : accepts another vector of the same type or a single " Tname)			\
 				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				BUFFER_VECTOR_BINDING\
 			;																						\
 		}
 
@@ -792,6 +1019,7 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__gt__", &ThisBinder::gt, "The comparison is element-wise, like a string comparison. \n")	\
 				.def("__ge__", &ThisBinder::ge, "The comparison is element-wise, like a string comparison. \n")	\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				BUFFER_VECTOR_BINDING\
 			; \
 		}
 
@@ -164,6 +164,26 @@ class IECORESCENE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		const std::vector<int> &varyingDataOffsets() const;
 		//@}
 
+		//! @name Batched queries
+		/// These perform many queries at once, in parallel, writing the
+		/// results into plain arrays rather than allocating a Result per
+		/// query. Each output array must have room for one element per
+		/// query, but any may be null if the corresponding results aren't
+		/// needed. Queries which find nothing are given a curve index of -1,
+		/// and their other outputs are left untouched. Further information for
+		/// any result may be obtained by passing the curve index and v
+		/// parameter to pointAtV().
+		//////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Equivalent to calling closestPoint() for each point, but considering
+		/// only curves within `maxDistance` of the point.
+		void batchClosestPoint(
+			const Imath::V3f *points, size_t numPoints,
+			int *curveIndices, float *v, Imath::V3f *positions,
+			float maxDistance = Imath::limits<float>::max()
+		) const;
+		//@}
+
 	protected :
 
 		/// \todo It would be much better if PrimitiveEvaluator::Description didn't require these create()
@@ -191,6 +211,8 @@ class IECORESCENE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		IECore::Box3fTree m_tree;
 		std::vector<Imath::Box3f> m_treeBounds;
 		struct Line;
+		// Stored in the same order as the tree's permutation, so that
+		// the lines for each leaf are contiguous.
 		std::vector<Line> m_treeLines;
 
 		void closestPointWalk( IECore::Box3fTree::NodeIndex nodeIndex, const Imath::V3f &p, unsigned &curveIndex, float &v, float &closestDistSquared ) const;
@@ -142,6 +142,34 @@ class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 		/// Returns a bounding box covering all the uv coordinates of the mesh.
 		const Imath::Box2f uvBound() const;
 
+		//! @name Batched queries
+		/// These perform many queries at once, in parallel, writing the
+		/// results into plain arrays rather than allocating a Result per
+		/// query. They use an internal bounding volume hierarchy which is
+		/// built on first use, and which stores the triangles in traversal
+		/// order for cache efficiency. Each output array must have room for
+		/// one element per query, but any may be null if the corresponding
+		/// results aren't needed. Queries which find nothing are given a
+		/// triangle index of -1, and their other outputs are left untouched.
+		/// Further information for any result may be obtained by passing the
+		/// triangle index and barycentric coordinates to barycentricPosition().
+		//////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Equivalent to calling closestPoint() for each point, but considering
+		/// only triangles within `maxDistance` of the point.
+		void batchClosestPoint(
+			const Imath::V3f *points, size_t numPoints,
+			int *triangleIndices, Imath::V3f *barycentricCoordinates, Imath::V3f *positions,
+			float maxDistance = Imath::limits<float>::max()
+		) const;
+		/// Equivalent to calling intersectionPoint() for each ray.
+		void batchIntersectionPoint(
+			const Imath::V3f *origins, const Imath::V3f *directions, size_t numRays,
+			int *triangleIndices, Imath::V3f *barycentricCoordinates, Imath::V3f *positions,
+			float maxDistance = Imath::limits<float>::max()
+		) const;
+		//@}
+
 		//! @name Internal KDTrees.
 		/// The MeshPrimitiveEvaluator uses internal KDTrees to perform many of
 		/// its queries. Const access is provided to these so that clients can use them
@@ -206,6 +234,12 @@ class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 		mutable bool m_haveSurfaceArea;
 		mutable float m_surfaceArea;
 
+		class BVH;
+		const BVH *bvh() const;
+		typedef tbb::mutex BVHMutex;
+		mutable BVHMutex m_bvhMutex;
+		mutable const BVH *m_bvh;
+
 		typedef tbb::mutex NormalsMutex;
 		mutable NormalsMutex m_normalsMutex;
 		mutable bool m_haveAverageNormals;
@@ -113,6 +113,15 @@ class IECORESCENE_API NParticleReader : public ParticleReader
 		IECore::IntVectorDataPtr m_frames;
 		std::map<int, IECore::IFFFile::Chunk::ChunkIterator> frameToRootChildren;
 
+		// The CHNM chunk for each channel in a frame, in file order.
+		typedef std::vector<std::pair<std::string, IECore::IFFFile::Chunk::ChunkIterator> > ChannelIndex;
+		// Returns the channels for the frame specified by m_frameParameter,
+		// reading the channel names from the file on first use so that
+		// subsequent lookups don't need to touch the file. Returns nullptr
+		// if the frame doesn't exist.
+		const ChannelIndex *channels( const char *context );
+		std::map<int, ChannelIndex> m_channels;
+
 		template<typename T, typename F>
 		typename T::Ptr filterAttr( const F * attr, float percentage );
 };
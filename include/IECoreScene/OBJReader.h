@@ -38,22 +38,19 @@
 #include "IECoreScene/Export.h"
 #include "IECoreScene/TypeIds.h"
 
-#include "IECore/Export.h"
 #include "IECore/Reader.h"
-
-IECORE_PUSH_DEFAULT_VISIBILITY
-#include "OpenEXR/ImathVec.h"
-IECORE_POP_DEFAULT_VISIBILITY
-
-#include <vector>
+#include "IECore/SimpleTypedParameter.h"
 
 namespace IECoreScene
 {
 
-IE_CORE_FORWARDDECLARE(MeshPrimitive);
-
 /// The OBJReader class defines a class for reading OBJ mesh data.
 /// This is a subset of the full setup of objects encodable in OBJ.
+///
+/// The file is memory mapped and split into line-aligned chunks which
+/// are parsed in parallel, before being merged into a single
+/// MeshPrimitive. Normals and texture coordinates are optional, and
+/// skipping them reduces both parsing time and memory use.
 /// \ingroup ioGroup
 class IECORESCENE_API OBJReader : public IECore::Reader
 {
@@ -65,6 +62,20 @@ class IECORESCENE_API OBJReader : public IECore::Reader
 
 		static bool canRead( const std::string &filename );
 
+		//! @name Parameter accessors
+		/////////////////////////////////////////////////////////
+		//@{
+		/// When false, "vn" statements and face normal indices
+		/// are ignored, and no "N" primitive variable is output.
+		IECore::BoolParameter *readNormalsParameter();
+		const IECore::BoolParameter *readNormalsParameter() const;
+		/// When false, "vt" statements and face texture coordinate
+		/// indices are ignored, and no "s" or "t" primitive
+		/// variables are output.
+		IECore::BoolParameter *readTextureCoordinatesParameter();
+		const IECore::BoolParameter *readTextureCoordinatesParameter() const;
+		//@}
+
 	protected:
 
 		IECore::ObjectPtr doOperation( const IECore::CompoundObject * operands) override;
@@ -73,27 +84,9 @@ class IECORESCENE_API OBJReader : public IECore::Reader
 
 		static const ReaderDescription<OBJReader> m_readerDescription;
 
-		// top-level parse method
-		void parseOBJ();
-
-		// statement-level parse methods
-		void parseVertex(const char *, const char *);
-		void parseTextureCoordinate(const char *, const char *);
-		void parseNormal(const char *, const char *);
-
-		// elements
-		void parseFace(const char *, const char *);
-
-		// grouping
-		void parseGroup(const char *, const char *);
-
-		// pointers to mesh data
-		std::vector<int> *m_vpf, *m_vids;
-		std::vector<Imath::V3f> *m_vertices, *m_normals;
-		std::vector<float> *m_sTextureCoordinates, *m_tTextureCoordinates;
+		IECore::BoolParameterPtr m_readNormalsParameter;
+		IECore::BoolParameterPtr m_readTextureCoordinatesParameter;
 
-		// local data for assembling mesh
-		std::vector<Imath::V3f> m_introducedNormals, m_introducedTextureCoordinates;
 };
 
 IE_CORE_DECLAREPTR(OBJReader);
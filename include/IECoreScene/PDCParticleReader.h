@@ -40,6 +40,16 @@
 
 #include "IECore/VectorTypedData.h"
 
+#include <memory>
+
+namespace boost
+{
+namespace iostreams
+{
+class mapped_file_source;
+} // namespace iostreams
+} // namespace boost
+
 namespace IECoreScene
 {
 
@@ -47,6 +57,12 @@ namespace IECoreScene
 /// interface for Maya .pdc format particle caches. Percentage filtering
 /// of loaded particles is seeded using the particleId attribute, so
 /// is not only repeatable but also consistent from frame to frame.
+///
+/// Files are memory mapped, and the location of each attribute is
+/// indexed when the file is first opened, so that reading a subset of
+/// the attributes only touches the parts of the file that are needed.
+/// When reading several attributes via read(), they are loaded in
+/// parallel.
 /// \ingroup ioGroup
 class IECORESCENE_API PDCParticleReader : public ParticleReader
 {
@@ -69,6 +85,8 @@ class IECORESCENE_API PDCParticleReader : public ParticleReader
 
 		// Returns the name of the position primVar
 		std::string positionPrimVarName() override;
+		// Reads the attributes in parallel
+		void readAttributes( const std::vector<std::string> &names, std::vector<IECore::DataPtr> &data ) override;
 
 	private :
 
@@ -87,13 +105,13 @@ class IECORESCENE_API PDCParticleReader : public ParticleReader
 		struct Record
 		{
 			int type;
-			std::streampos position;
+			size_t position;
 		};
 
-		// makes sure that m_iStream is open and that m_header is full.
+		// makes sure that m_file is open and that m_header is full.
 		// returns true on success and false on failure.
 		bool open();
-		std::ifstream *m_iStream;
+		std::unique_ptr<boost::iostreams::mapped_file_source> m_file;
 		std::string m_streamFileName;
 		struct
 		{
@@ -104,12 +122,21 @@ class IECORESCENE_API PDCParticleReader : public ParticleReader
 			std::map<std::string, Record> attributes;
 		} m_header;
 
+		// copies n elements from the file into buffer, reversing
+		// the byte order if necessary
 		template<typename T>
-		void readElements( T *buffer, std::streampos pos, unsigned long n ) const;
+		void readElements( T *buffer, size_t pos, unsigned long n ) const;
+
+		// reads a single attribute. this is safe to call concurrently
+		// once open() and idAttribute() have been called.
+		IECore::DataPtr readRecord( const Record &record, const IECore::Data *idAttr ) const;
 
 		// loads particleId in a completely unfiltered state
 		const IECore::Data * idAttribute();
 		IECore::DataPtr m_idAttribute;
+		// returns idAttribute(), warning if it is needed for
+		// filtering but doesn't exist
+		const IECore::Data * filteringIdAttribute();
 
 };
 
@@ -115,6 +115,13 @@ class IECORESCENE_API ParticleReader : public IECore::Reader
 		/// in derived classes.
 		IECore::ObjectPtr doOperation( const IECore::CompoundObject * operands ) override;
 
+		/// Called by doOperation() to read all the attributes needed for the
+		/// result, filling data with the result of readAttribute() for each name.
+		/// The default implementation simply calls readAttribute() for each
+		/// name in turn, but may be reimplemented by derived classes to read
+		/// the attributes in parallel.
+		virtual void readAttributes( const std::vector<std::string> &names, std::vector<IECore::DataPtr> &data );
+
 		/// Convenience functions to access the values held in parameters().
 		/// If called from within doOperation they will never throw, but if
 		/// called at any other time they may, due to invalid values in the
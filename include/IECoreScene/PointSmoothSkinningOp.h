@@ -48,6 +48,7 @@
 #include "IECore/SimpleTypedParameter.h"
 #include "IECore/VectorTypedParameter.h"
 
+#include <memory>
 #include <vector>
 
 namespace IECoreScene
@@ -60,6 +61,14 @@ namespace IECoreScene
 /// parameter (which defaults to "P"). Optionally one can also deform a normal V3fVectorData primitive variable (which
 /// defaults to "N"). These variables must have the same number of elements and must match the number of points in the
 /// SmoothSkinningData.
+///
+/// The skinning matrices are assumed to be affine. The Linear blend mode blends them directly, whereas the DualQuaternion
+/// mode blends their rotation and translation as dual quaternions, avoiding the loss of volume that linear blending
+/// suffers around twisting joints. Any scale or shear in the matrices is ignored by the DualQuaternion mode.
+///
+/// The influences are rearranged into a form suited to the primitive being deformed the first time the Op is used,
+/// and are reused for as long as the SmoothSkinningData and reference indices remain unchanged. Deforming a sequence
+/// of poses with the same Op therefore costs only a single pass over the points per pose.
 /// \ingroup geometryProcessingGroup
 /// \ingroup skinningGroup
 class IECORESCENE_API PointSmoothSkinningOp : public IECore::ModifyOp
@@ -73,7 +82,7 @@ class IECORESCENE_API PointSmoothSkinningOp : public IECore::ModifyOp
 		typedef enum
 		{
 			Linear = 0,
-			// todo: DualQuaternion = 1
+			DualQuaternion = 1,
 			// todo: LinearDualQuaternionMix = 2
 		} Blend;
 
@@ -125,10 +134,8 @@ class IECORESCENE_API PointSmoothSkinningOp : public IECore::ModifyOp
 		IECore::M44fVectorParameterPtr m_deformationPoseParameter;
 		IECore::IntVectorParameterPtr m_refIndicesParameter;
 
-		ConstSmoothSkinningDataPtr m_prevSmoothSkinningData;
-
-		struct DeformPositions;
-		struct DeformNormals;
+		struct InfluenceWeights;
+		std::unique_ptr<InfluenceWeights> m_influenceWeights;
 };
 
 IE_CORE_DECLAREPTR( PointSmoothSkinningOp );
@@ -128,6 +128,20 @@ class IECORESCENE_API PointsPrimitiveEvaluator : public PrimitiveEvaluator
 			std::vector<PrimitiveEvaluator::ResultPtr> &results, float maxDistance = Imath::limits<float>::max() ) const override;
 		//@}
 
+		//! @name Batch Query Functions
+		/// These find the neighbours of many query points at once, using multiple
+		/// threads. Results are returned in compressed sparse row form : the neighbours
+		/// of the ith query point are pointIndices[offsets[i]] to pointIndices[offsets[i+1]-1],
+		/// and the corresponding distances are stored in the same range of distances.
+		/// The offsets vector is resized to hold numPoints + 1 elements.
+		////////////////////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Finds the numNeighbours closest points to each query point, sorted closest first.
+		void batchNearestNNeighbours( const Imath::V3f *points, size_t numPoints, unsigned int numNeighbours, std::vector<int> &offsets, std::vector<int> &pointIndices, std::vector<float> &distances ) const;
+		/// Finds all the points closer than radius to each query point, in no particular order.
+		void batchPointsInRadius( const Imath::V3f *points, size_t numPoints, float radius, std::vector<int> &offsets, std::vector<int> &pointIndices, std::vector<float> &distances ) const;
+		//@}
+
 	protected :
 
 		/// \todo It would be much better if PrimitiveEvaluator::Description didn't require these create()
@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENE_PRIMITIVEINTERPOLATOR_H
+#define IECORESCENE_PRIMITIVEINTERPOLATOR_H
+
+#include "IECoreScene/Export.h"
+#include "IECoreScene/Primitive.h"
+
+namespace IECoreScene
+{
+
+/// Linearly interpolates the primitive variables and blind data of two primitives,
+/// taking the topology and any uninterpolable values from y0. Returns a null pointer
+/// if the primitives have different variable sizes. This is the function used by
+/// `IECore::linearObjectInterpolation()` for all primitive types.
+IECORESCENE_API PrimitivePtr linearPrimitiveInterpolation( const Primitive *y0, const Primitive *y1, double x );
+
+/// As above, but writing into an existing primitive of the same type as y0. Where
+/// `result` already holds data of the right type and is its sole owner, that data
+/// is reused, so interpolating repeatedly into the same primitive (for instance, once
+/// per shutter sample) doesn't require the primitive variables to be reallocated.
+/// Returns false and leaves `result` unchanged if the primitives can't be interpolated.
+IECORESCENE_API bool linearPrimitiveInterpolation( const Primitive *y0, const Primitive *y1, double x, Primitive *result );
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_PRIMITIVEINTERPOLATOR_H
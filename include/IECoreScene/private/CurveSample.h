@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENE_CURVESAMPLE_H
+#define IECORESCENE_CURVESAMPLE_H
+
+#include "IECore/CubicBasis.h"
+#include "IECore/FastFloat.h"
+
+#include "OpenEXR/ImathFun.h"
+
+#include <algorithm>
+
+namespace IECoreScene
+{
+
+namespace Detail
+{
+
+/// The basis coefficients and data indices needed to evaluate primitive
+/// variables at a particular `v` parameter along a curve. This provides
+/// the same results as CurvesPrimitiveEvaluator::Result, without the
+/// overhead of allocating a Result and making virtual calls for each
+/// value, so that curves can be processed in tight loops.
+struct CurveSample
+{
+
+	/// Initialises the sample for parameter `v` on a curve with `numVertices`
+	/// vertices, whose data starts at the specified offsets.
+	template<bool linear, bool periodic>
+	void init( const IECore::CubicBasisf &basis, int numVertices, unsigned vertexDataOffset, unsigned varyingDataOffset, float v )
+	{
+		unsigned numSegments = 0;
+		if( linear )
+		{
+			numSegments = periodic ? numVertices : numVertices - 1;
+		}
+		else
+		{
+			numSegments = periodic ? numVertices / basis.step : ( numVertices - 4 ) / basis.step + 1;
+		}
+
+		const float vv = v * numSegments;
+		const unsigned segment = std::min( (unsigned)IECore::fastFloatFloor( vv ), numSegments - 1 );
+		segmentV = vv - segment;
+
+		const unsigned o = vertexDataOffset;
+		const unsigned i = segment * basis.step;
+
+		if( linear )
+		{
+			coefficients[0] = 1.0f - segmentV;
+			coefficients[1] = segmentV;
+			derivativeCoefficients[0] = 1.0f;
+			derivativeCoefficients[1] = -1.0f;
+			vertexDataIndices[0] = varyingDataIndices[0] = o + i;
+			if( periodic )
+			{
+				vertexDataIndices[1] = varyingDataIndices[1] = o + ( ( i + 1 ) % numVertices );
+			}
+			else
+			{
+				vertexDataIndices[1] = varyingDataIndices[1] = vertexDataIndices[0] + 1;
+			}
+		}
+		else
+		{
+			basis.coefficients( segmentV, coefficients );
+			basis.derivativeCoefficients( segmentV, derivativeCoefficients );
+
+			if( periodic )
+			{
+				vertexDataIndices[0] = o + i;
+				vertexDataIndices[1] = o + ( ( i + 1 ) % numVertices );
+				vertexDataIndices[2] = o + ( ( i + 2 ) % numVertices );
+				vertexDataIndices[3] = o + ( ( i + 3 ) % numVertices );
+
+				varyingDataIndices[0] = varyingDataOffset + segment;
+				varyingDataIndices[1] = varyingDataOffset + ( segment % numSegments );
+			}
+			else
+			{
+				vertexDataIndices[0] = o + i;
+				vertexDataIndices[1] = vertexDataIndices[0] + 1;
+				vertexDataIndices[2] = vertexDataIndices[1] + 1;
+				vertexDataIndices[3] = vertexDataIndices[2] + 1;
+
+				varyingDataIndices[0] = varyingDataOffset + segment;
+				varyingDataIndices[1] = varyingDataIndices[0] + 1;
+			}
+		}
+	}
+
+	/// Evaluates vertex interpolated data, using either `coefficients` or
+	/// `derivativeCoefficients`. `Container` may be any type providing
+	/// `operator[]`, such as `std::vector<T>` or `PrimitiveVariable::IndexedView<T>`.
+	template<bool linear, typename T, typename Container>
+	T vertexValue( const Container &data, const float *c ) const
+	{
+		if( linear )
+		{
+			return (T)( c[0] * data[vertexDataIndices[0]] + c[1] * data[vertexDataIndices[1]] );
+		}
+		else
+		{
+			return (T)(
+				c[0] * data[vertexDataIndices[0]] +
+				c[1] * data[vertexDataIndices[1]] +
+				c[2] * data[vertexDataIndices[2]] +
+				c[3] * data[vertexDataIndices[3]]
+			);
+		}
+	}
+
+	/// Evaluates varying or facevarying interpolated data.
+	template<typename T, typename Container>
+	T varyingValue( const Container &data ) const
+	{
+		return Imath::lerp( data[varyingDataIndices[0]], data[varyingDataIndices[1]], segmentV );
+	}
+
+	float segmentV;
+	float coefficients[4];
+	float derivativeCoefficients[4];
+	unsigned vertexDataIndices[4];
+	unsigned varyingDataIndices[2];
+
+};
+
+} // namespace Detail
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_CURVESAMPLE_H
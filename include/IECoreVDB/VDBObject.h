@@ -85,6 +85,14 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 
 		IECore::CompoundObjectPtr metadata( const std::string &name );
 
+		//! Hash representing the grid types, transforms and tree topology,
+		//! ignoring the voxel values stored in leaf nodes. Note that the
+		//! topology includes the background value and the values of tiles
+		//! in internal nodes, so changing those changes the hash. This is
+		//! much cheaper than hash() and is available without loading voxel
+		//! data for objects loaded from an IndexedIO file.
+		void topologyHash( IECore::MurmurHash &h ) const;
+
 		//! Are the grids in this VDBObject unmodified from the vdb file in filename?
 		//! Useful for passing VDB objects to renders by filename instead of memory buffer
 		bool unmodifiedFromFile() const;
@@ -111,31 +119,55 @@ class IECOREVDB_API VDBObject : public IECoreScene::VisibleRenderable
 			tbb::recursive_mutex mutex;
 		};
 
+		// guard multithreaded access to a grid stored in an IndexedIO
+		// container by save(), which is only read on first access.
+		struct LockedContainer
+		{
+			LockedContainer( IECore::ConstIndexedIOPtr container ) : container( container )
+			{}
+
+			IECore::ConstIndexedIOPtr container;
+			tbb::recursive_mutex mutex;
+		};
+
 		class HashedGrid
 		{
 			public:
-				HashedGrid() : m_hashValid( false )
+				HashedGrid() : m_hashValid( false ), m_topologyHashValid( false )
 				{
 				}
 
 				HashedGrid( openvdb::GridBase::Ptr grid, std::shared_ptr<LockedFile> file )
 					: m_grid( grid ),
-					m_hashValid( false ), m_lockedFile( file )
+					m_hashValid( false ), m_topologyHashValid( false ), m_lockedFile( file )
+				{
+				}
+
+				HashedGrid( openvdb::GridBase::Ptr metadata, std::shared_ptr<LockedContainer> container, const IECore::MurmurHash &hash, const IECore::MurmurHash &topologyHash )
+					: m_grid( metadata ),
+					m_hashValid( true ), m_hash( hash ),
+					m_topologyHashValid( true ), m_topologyHash( topologyHash ),
+					m_lockedContainer( container )
 				{
 				}
 
 				IECore::MurmurHash hash() const;
+				IECore::MurmurHash topologyHash() const;
 				openvdb::GridBase::Ptr metadata() const;
 				openvdb::GridBase::Ptr grid() const;
 				bool unmodifiedFromFile() const;
 				void markedAsEdited();
+				void save( IECore::IndexedIO *container ) const;
 
 			private:
 				mutable openvdb::GridBase::Ptr m_grid;
 				mutable bool m_hashValid;
 				mutable IECore::MurmurHash m_hash;
+				mutable bool m_topologyHashValid;
+				mutable IECore::MurmurHash m_topologyHash;
 
 				mutable std::shared_ptr<LockedFile> m_lockedFile;
+				mutable std::shared_ptr<LockedContainer> m_lockedContainer;
 		};
 
 		std::unordered_map<std::string, HashedGrid> m_grids;
@@ -164,10 +164,18 @@ void CompoundDataBase::load( LoadContextPtr context )
 
 	IndexedIO::EntryIDList memberNames;
 	container->entryIds( memberNames );
-	IndexedIO::EntryIDList::const_iterator it;
-	for( it=memberNames.begin(); it!=memberNames.end(); it++ )
+
+	std::vector<DataPtr> members( memberNames.size() );
+	context->parallelLoad(
+		memberNames.size(),
+		[&members, &memberNames, &container, &context]( size_t i ) {
+			members[i] = context->load<Data>( container.get(), memberNames[i] );
+		}
+	);
+
+	for( size_t i = 0, e = memberNames.size(); i < e; ++i )
 	{
-		m[*it] = context->load<Data>( container.get(), *it );
+		m[memberNames[i]] = members[i];
 	}
 }
 
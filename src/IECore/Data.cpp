@@ -34,12 +34,98 @@
 
 #include "IECore/Data.h"
 
+#include "IECore/MessageHandler.h"
+#include "IECore/TypedDataInternals.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
 using namespace IECore;
 
+namespace
+{
+
+Data::HashVersion defaultHashVersion()
+{
+	if( const char *v = getenv( "IECORE_DATA_HASHVERSION" ) )
+	{
+		const int version = atoi( v );
+		if( version == Data::SerialHash || version == Data::ChunkedHash )
+		{
+			return (Data::HashVersion)version;
+		}
+		msg( Msg::Warning, "Data", std::string( "Invalid IECORE_DATA_HASHVERSION \"" ) + v + "\"" );
+	}
+	return Data::SerialHash;
+}
+
+// Atomic because the version may be changed while other threads are hashing.
+std::atomic<Data::HashVersion> g_hashVersion( defaultHashVersion() );
+
+bool defaultLazyLoading()
+{
+	if( const char *v = getenv( "IECORE_DATA_LAZYLOADING" ) )
+	{
+		return atoi( v );
+	}
+	return false;
+}
+
+std::atomic_bool g_lazyLoading( defaultLazyLoading() );
+
+} // namespace
+
 IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( Data );
 
 const unsigned int Data::m_ioVersion = 0;
 
+void Data::setHashVersion( HashVersion hashVersion )
+{
+	g_hashVersion = hashVersion;
+}
+
+Data::HashVersion Data::getHashVersion()
+{
+	return g_hashVersion;
+}
+
+void Data::setLazyLoading( bool lazyLoading )
+{
+	g_lazyLoading = lazyLoading;
+}
+
+bool Data::getLazyLoading()
+{
+	return g_lazyLoading;
+}
+
+void Detail::appendChunkHashes( MurmurHash &h, size_t numElements, size_t numChunks, const std::function<void ( size_t, MurmurHash & )> &chunkHash )
+{
+	std::vector<MurmurHash> chunkHashes( numChunks );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numChunks ),
+		[&chunkHashes, &chunkHash]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				chunkHash( i, chunkHashes[i] );
+			}
+		},
+		taskGroupContext
+	);
+
+	h.append( (uint64_t)numElements );
+	for( const auto &chunkHash : chunkHashes )
+	{
+		h.append( chunkHash );
+	}
+}
+
 Data::~Data()
 {
 }
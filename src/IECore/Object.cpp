@@ -39,7 +39,15 @@
 #include "boost/format.hpp"
 #include "boost/tokenizer.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 
 
 using namespace IECore;
@@ -54,6 +62,37 @@ static IndexedIO::EntryID g_dataEntry("data");
 static IndexedIO::EntryID g_typeEntry("type");
 const unsigned int Object::m_ioVersion = 0;
 
+namespace
+{
+
+bool defaultParallelLoading()
+{
+	if( const char *v = getenv( "IECORE_OBJECT_PARALLELLOADING" ) )
+	{
+		return atoi( v );
+	}
+	return false;
+}
+
+std::atomic_bool g_parallelLoading( defaultParallelLoading() );
+
+// Returns true if the file can't be modified while we are reading it.
+bool readOnly( const IndexedIO *io )
+{
+	const IndexedIO::OpenMode mode = io->openMode();
+	return ( mode & IndexedIO::Read ) && !( mode & ( IndexedIO::Write | IndexedIO::Append ) );
+}
+
+// Returns true if `path` is `container` or one of its ancestors.
+bool isAncestor( const IndexedIO::EntryIDList &path, const IndexedIO *container )
+{
+	IndexedIO::EntryIDList containerPath;
+	container->path( containerPath );
+	return path.size() <= containerPath.size() && std::equal( path.begin(), path.end(), containerPath.begin() );
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // structors
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -224,17 +263,55 @@ void Object::SaveContext::save( const Object *toSave, IndexedIO *container, cons
 // load context stuff
 //////////////////////////////////////////////////////////////////////////////////////////
 
-struct Object::LoadContext::LoadedObjects : public std::map<IndexedIO::EntryIDList, ObjectPtr>
+// Records every object loaded so far, so that references to them can be
+// resolved. When loading in parallel, each object has its own mutex so that
+// concurrent loads of the same object wait for the first, without blocking
+// loads of other objects. Serial loads don't use the mutexes.
+struct Object::LoadContext::LoadedObjects
 {
+
+	LoadedObjects( bool parallel )
+		:	parallel( parallel )
+	{
+	}
+
+	struct Entry
+	{
+		Entry() : loaded( false ) {}
+		std::mutex mutex;
+		bool loaded;
+		ObjectPtr object;
+	};
+
+	typedef std::shared_ptr<Entry> EntryPtr;
+
+	EntryPtr entry( const IndexedIO::EntryIDList &path )
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		EntryPtr &result = entries[path];
+		if( !result )
+		{
+			result = std::make_shared<Entry>();
+		}
+		return result;
+	}
+
+	const bool parallel;
+
+	private :
+
+		std::mutex mutex;
+		std::map<IndexedIO::EntryIDList, EntryPtr> entries;
+
 };
 
 Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface )
-	:	m_ioInterface( ioInterface ), m_loadedObjects( new LoadedObjects )
+	:	m_ioInterface( ioInterface ), m_loadedObjects( new LoadedObjects( g_parallelLoading && readOnly( ioInterface.get() ) ) ), m_lazy( false )
 {
 }
 
-Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface, std::shared_ptr<LoadedObjects> loadedObjects )
-	:	m_ioInterface( ioInterface ), m_loadedObjects( loadedObjects )
+Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface, std::shared_ptr<LoadedObjects> loadedObjects, bool lazy )
+	:	m_ioInterface( ioInterface ), m_loadedObjects( loadedObjects ), m_lazy( lazy )
 {
 }
 
@@ -255,17 +332,49 @@ ConstIndexedIOPtr Object::LoadContext::container( const std::string &typeName, u
 	return typeIO->subdirectory( g_dataEntry, throwIfMissing ? IndexedIO::ThrowIfMissing : IndexedIO::NullIfMissing );
 }
 
+bool Object::LoadContext::lazy() const
+{
+	// Lazy loading reads from the file after load() has returned,
+	// so we can't allow it if the file might be modified.
+	return m_lazy && readOnly( m_ioInterface.get() );
+}
+
+void Object::LoadContext::parallelLoad( size_t numObjects, const std::function<void ( size_t )> &loader )
+{
+	if( !m_loadedObjects->parallel || numObjects < 2 )
+	{
+		for( size_t i = 0; i < numObjects; ++i )
+		{
+			loader( i );
+		}
+		return;
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numObjects, 1 ),
+		[&loader]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				loader( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
 const IndexedIO *Object::LoadContext::rawContainer()
 {
 	return m_ioInterface.get();
 }
 
-ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name )
+ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name, bool lazy )
 {
 	IndexedIO::Entry e = container->entry( name );
+	IndexedIO::EntryIDList pathParts;
+	ConstIndexedIOPtr ioObject;
 	if( e.entryType()==IndexedIO::File )
 	{
-		IndexedIO::EntryIDList pathParts;
 		if ( e.dataType() == IndexedIO::InternedStringArray )
 		{
 			pathParts.resize( e.arrayLength() );
@@ -287,43 +396,59 @@ ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container
 				pathParts.push_back( *t );
 			}
 		}
-		std::pair<LoadedObjects::iterator, bool> ret = m_loadedObjects->insert( std::pair<IndexedIO::EntryIDList, ObjectPtr>( pathParts, nullptr ) );
-		if ( ret.second )
-		{
-			// jump to the path..
-			ConstIndexedIOPtr ioObject = m_ioInterface->directory( pathParts );
-			// add the loaded object to the map.
-			ret.first->second = loadObject( ioObject.get() );
-		}
-		return ret.first->second;
 	}
 	else
 	{
-		ConstIndexedIOPtr ioObject = container->subdirectory( name );
-
-		IndexedIO::EntryIDList pathParts;
+		ioObject = container->subdirectory( name );
 		ioObject->path( pathParts );
+	}
+
+	LoadedObjects::EntryPtr entry = m_loadedObjects->entry( pathParts );
+	std::unique_lock<std::mutex> lock;
+	if( m_loadedObjects->parallel )
+	{
+		// SaveContext records an object before saving its children, so an
+		// object which contains itself is saved with a reference back to an
+		// ancestor. That ancestor is still loading, possibly on this thread
+		// or possibly on one which is waiting for us, so we mustn't wait for
+		// it. We return null as serial loading does.
+		if( !ioObject && isAncestor( pathParts, container ) )
+		{
+			return nullptr;
+		}
+		lock = std::unique_lock<std::mutex>( entry->mutex );
+	}
 
-		std::pair<LoadedObjects::iterator, bool> ret = m_loadedObjects->insert( std::pair<IndexedIO::EntryIDList, ObjectPtr>( pathParts, nullptr ) );
-		if ( ret.second )
+	if( !entry->loaded )
+	{
+		entry->loaded = true;
+		if( !ioObject )
 		{
-			// add the loaded object to the map.
-			ret.first->second = loadObject( ioObject.get() );
+			// jump to the path..
+			ioObject = m_ioInterface->directory( pathParts );
 		}
-		return ret.first->second;
+		// Isolation prevents this thread from picking up unrelated
+		// loading tasks while we hold the lock, as they could need
+		// the same lock.
+		tbb::this_task_arena::isolate(
+			[&entry, &ioObject, lazy, this]() {
+				entry->object = loadObject( ioObject.get(), lazy );
+			}
+		);
 	}
+	return entry->object;
 }
 
 // this function can only load concrete objects. it can't load references to
 // objects. path is relative to the root of m_ioInterface
-ObjectPtr Object::LoadContext::loadObject( const IndexedIO *container )
+ObjectPtr Object::LoadContext::loadObject( const IndexedIO *container, bool lazy )
 {
 	ObjectPtr result = nullptr;
 	string type = "";
 	container->read( g_typeEntry, type );
 	ConstIndexedIOPtr dataIO = container->subdirectory( g_dataEntry );
 	result = create( type );
-	LoadContextPtr context = new LoadContext( dataIO, m_loadedObjects );
+	LoadContextPtr context = new LoadContext( dataIO, m_loadedObjects, lazy );
 	result->load( context );
 	return result;
 }
@@ -567,3 +692,13 @@ ObjectPtr Object::load( ConstIndexedIOPtr ioInterface, const IndexedIO::EntryID
 	ObjectPtr result = context->load<Object>( ioInterface.get(), name );
 	return result;
 }
+
+void Object::setParallelLoading( bool parallelLoading )
+{
+	g_parallelLoading = parallelLoading;
+}
+
+bool Object::getParallelLoading()
+{
+	return g_parallelLoading;
+}
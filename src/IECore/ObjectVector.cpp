@@ -121,11 +121,24 @@ void ObjectVector::load( LoadContextPtr context )
 
 	IndexedIO::EntryIDList l;
 	ioMembers->entryIds(l);
+
+	std::vector<MemberContainer::size_type> indices;
+	indices.reserve( l.size() );
 	for( IndexedIO::EntryIDList::const_iterator it=l.begin(); it!=l.end(); it++ )
 	{
-		MemberContainer::size_type i = boost::lexical_cast<MemberContainer::size_type>( (*it).value() );
-		m_members[i] = context->load<Object>( ioMembers.get(), *it );
+		indices.push_back( boost::lexical_cast<MemberContainer::size_type>( (*it).value() ) );
+		if( indices.back() >= m_members.size() )
+		{
+			throw IOException( "ObjectVector member index out of range" );
+		}
 	}
+
+	context->parallelLoad(
+		l.size(),
+		[this, &l, &indices, &ioMembers, &context]( size_t i ) {
+			m_members[indices[i]] = context->load<Object>( ioMembers.get(), l[i] );
+		}
+	);
 }
 
 bool ObjectVector::isEqualTo( const Object *other ) const
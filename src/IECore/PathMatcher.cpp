@@ -37,13 +37,127 @@
 
 #include "IECore/PathMatcher.h"
 
+#include "IECore/Exception.h"
+#include "IECore/MurmurHash.h"
 #include "IECore/StringAlgo.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
 using namespace std;
 using namespace IECore;
 
 static IECore::InternedString g_ellipsis( "..." );
 
+//////////////////////////////////////////////////////////////////////////
+// Parallel processing utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Nodes with fewer children than this are processed serially, since
+// the overhead of launching tasks would outweigh the benefit.
+const size_t g_minParallelChildren = 16;
+
+// Calls `f( i )` for each `i` in the range `[0, size)`, in parallel if
+// `size` is large enough to make that worthwhile. Since `f` is typically
+// recursive, it may itself launch further parallel work.
+template<typename F>
+void parallelForEach( size_t size, const F &f )
+{
+	if( size < g_minParallelChildren )
+	{
+		for( size_t i = 0; i < size; ++i )
+		{
+			f( i );
+		}
+		return;
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size ),
+		[&f]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+// Integers are encoded little endian, independent of the host.
+
+void encodeUInt32( uint32_t value, char *dst )
+{
+	for( int i = 0; i < 4; ++i )
+	{
+		dst[i] = (char)( ( value >> ( i * 8 ) ) & 0xff );
+	}
+}
+
+uint32_t decodeUInt32( const char *src )
+{
+	const unsigned char *s = reinterpret_cast<const unsigned char *>( src );
+	return (uint32_t)s[0] | ( (uint32_t)s[1] << 8 ) | ( (uint32_t)s[2] << 16 ) | ( (uint32_t)s[3] << 24 );
+}
+
+// Returns pointers to the elements of the range, so they can be
+// accessed randomly from parallel tasks regardless of the type of
+// container they are stored in.
+template<typename Iterator>
+std::vector<const typename std::iterator_traits<Iterator>::value_type *> elementPointers( Iterator begin, Iterator end )
+{
+	std::vector<const typename std::iterator_traits<Iterator>::value_type *> result;
+	for( Iterator it = begin; it != end; ++it )
+	{
+		result.push_back( &*it );
+	}
+	return result;
+}
+
+// Calls `compute( *it )` for each element in the range, and then passes
+// each result to `apply( *it, result )`. The `compute` calls may be made
+// in parallel, but `apply` is always called serially and in order, so it
+// may be used to make edits that are not threadsafe. Small ranges are
+// processed serially without any additional allocations.
+template<typename Iterator, typename Compute, typename Apply>
+void computeAndApply( Iterator begin, Iterator end, size_t size, const Compute &compute, const Apply &apply )
+{
+	if( size < g_minParallelChildren )
+	{
+		for( Iterator it = begin; it != end; ++it )
+		{
+			auto result = compute( *it );
+			apply( *it, result );
+		}
+		return;
+	}
+
+	const auto elements = elementPointers( begin, end );
+	std::vector<decltype( compute( *begin ) )> results( elements.size() );
+	parallelForEach(
+		elements.size(),
+		[&]( size_t i ) {
+			results[i] = compute( *elements[i] );
+		}
+	);
+
+	for( size_t i = 0, e = elements.size(); i < e; ++i )
+	{
+		apply( *elements[i], results[i] );
+	}
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Name implementation
 //////////////////////////////////////////////////////////////////////////
@@ -75,23 +189,55 @@ PathMatcher::Node::Node( bool terminator )
 PathMatcher::Node::Node( const Node &other )
 	:	children( other.children ), terminator( other.terminator )
 {
+	children.insert( other.compactChildren.begin(), other.compactChildren.end() );
 }
 
 PathMatcher::Node::~Node()
 {
 }
 
-inline PathMatcher::Node::ConstChildMapIterator PathMatcher::Node::wildcardsBegin() const
+inline PathMatcher::Node::ConstChildIterator PathMatcher::Node::findChild( const Name &name ) const
+{
+	if( !isCompact() )
+	{
+		return ConstChildIterator( children.find( name ) );
+	}
+
+	const ChildMapValue *end = compactChildren.data() + compactChildren.size();
+	const ChildMapValue *it = std::lower_bound(
+		compactChildren.data(), end, name,
+		[]( const ChildMapValue &child, const Name &name ) { return child.first < name; }
+	);
+	if( it != end && !( name < it->first ) )
+	{
+		return ConstChildIterator( it );
+	}
+	return ConstChildIterator( end );
+}
+
+inline PathMatcher::Node::ConstChildIterator PathMatcher::Node::wildcardsBegin() const
 {
 	// The value for name used here will never be inserted in the map,
 	// but it marks the transition from non-wildcarded to wildcarded names.
-	return children.lower_bound( Name( IECore::InternedString(), Name::Boundary ) );
+	const Name boundary( IECore::InternedString(), Name::Boundary );
+	if( !isCompact() )
+	{
+		return ConstChildIterator( children.lower_bound( boundary ) );
+	}
+
+	const ChildMapValue *end = compactChildren.data() + compactChildren.size();
+	return ConstChildIterator(
+		std::lower_bound(
+			compactChildren.data(), end, boundary,
+			[]( const ChildMapValue &child, const Name &name ) { return child.first < name; }
+		)
+	);
 }
 
 inline PathMatcher::Node *PathMatcher::Node::child( const Name &name )
 {
-	ChildMapIterator it = children.find( name );
-	if( it != children.end() )
+	ConstChildIterator it = findChild( name );
+	if( it != childrenEnd() )
 	{
 		return it->second.get();
 	}
@@ -100,8 +246,8 @@ inline PathMatcher::Node *PathMatcher::Node::child( const Name &name )
 
 inline const PathMatcher::Node *PathMatcher::Node::child( const Name &name ) const
 {
-	ConstChildMapIterator it = children.find( name );
-	if( it != children.end() )
+	ConstChildIterator it = findChild( name );
+	if( it != childrenEnd() )
 	{
 		return it->second.get();
 	}
@@ -115,15 +261,17 @@ bool PathMatcher::Node::operator == ( const Node &other ) const
 		return false;
 	}
 
-	if( children.size() != other.children.size() )
+	const size_t numChildren = isCompact() ? compactChildren.size() : children.size();
+	const size_t otherNumChildren = other.isCompact() ? other.compactChildren.size() : other.children.size();
+	if( numChildren != otherNumChildren )
 	{
 		return false;
 	}
 
-	for( ConstChildMapIterator it = children.begin(), eIt = children.end(); it != eIt; it++ )
+	for( ConstChildIterator it = childrenBegin(), eIt = childrenEnd(); it != eIt; it++ )
 	{
-		ConstChildMapIterator oIt = other.children.find( it->first );
-		if( oIt == other.children.end() )
+		ConstChildIterator oIt = other.findChild( it->first );
+		if( oIt == other.childrenEnd() )
 		{
 			return false;
 		}
@@ -143,14 +291,31 @@ bool PathMatcher::Node::operator != ( const Node &other )
 
 bool PathMatcher::Node::clearChildren()
 {
-	const bool result = !children.empty();
+	const bool result = hasChildren();
 	children.clear();
+	ChildVector().swap( compactChildren );
 	return result;
 }
 
 bool PathMatcher::Node::isEmpty()
 {
-	return !terminator && children.empty();
+	return !terminator && !hasChildren();
+}
+
+void PathMatcher::Node::expand()
+{
+	if( compactChildren.empty() )
+	{
+		return;
+	}
+
+	for( auto &child : compactChildren )
+	{
+		// The compact children are already sorted, so
+		// inserting at the end is amortised constant time.
+		children.insert( children.end(), std::move( child ) );
+	}
+	ChildVector().swap( compactChildren );
 }
 
 PathMatcher::Node *PathMatcher::Node::leaf()
@@ -180,11 +345,25 @@ PathMatcher::PathMatcher( const NodePtr &root )
 {
 }
 
+PathMatcher::PathMatcher( const std::vector<std::vector<IECore::InternedString>> &sortedPaths )
+	:	m_root( sortedPaths.empty() ? new Node : buildWalk( sortedPaths.begin(), sortedPaths.end(), 0 ) )
+{
+}
+
 void PathMatcher::clear()
 {
 	m_root = new Node;
 }
 
+void PathMatcher::compact()
+{
+	NodePtr newRoot = compactWalk( m_root.get() );
+	if( newRoot )
+	{
+		m_root = newRoot;
+	}
+}
+
 bool PathMatcher::isEmpty() const
 {
 	return m_root->isEmpty();
@@ -226,6 +405,18 @@ bool PathMatcher::operator != ( const PathMatcher &other ) const
 	return !(*this == other );
 }
 
+void PathMatcher::hash( MurmurHash &h ) const
+{
+	h.append( (unsigned char)m_root->terminator );
+	hashWalk( m_root.get(), h );
+}
+
+size_t PathMatcher::memoryUsage() const
+{
+	std::unordered_set<const Node *> visited;
+	return memoryUsageWalk( m_root.get(), visited );
+}
+
 unsigned PathMatcher::match( const std::string &path ) const
 {
 	if( path.empty() )
@@ -259,7 +450,7 @@ void PathMatcher::matchWalk( const Node *node, const NameIterator &start, const
 		{
 			result |= ExactMatch;
 		}
-		if( node->children.size() )
+		if( node->hasChildren() )
 		{
 			result |= DescendantMatch;
 		}
@@ -291,8 +482,8 @@ void PathMatcher::matchWalk( const Node *node, const NameIterator &start, const
 	// not interested in finding a child with wildcards here - this avoids
 	// a call to hasWildcards() and gives us a decent little performance boost.
 
-	Node::ConstChildMapIterator childIt = node->children.find( Name( *start, Name::Plain ) );
-	const Node::ConstChildMapIterator childItEnd = node->children.end();
+	Node::ConstChildIterator childIt = node->findChild( Name( *start, Name::Plain ) );
+	const Node::ConstChildIterator childItEnd = node->childrenEnd();
 	if( childIt != childItEnd )
 	{
 		NameIterator newStart = start + 1;
@@ -438,20 +629,7 @@ bool PathMatcher::removePaths( const PathMatcher &paths )
 
 PathMatcher PathMatcher::intersection( const PathMatcher &paths ) const
 {
-	PathMatcher result = PathMatcher();
-	for( Iterator it = (*this).begin(); it != (*this).end(); ++it )
-	{
-		RawIterator rit = paths.find( *it );
-		if( rit == paths.end() )
-		{
-			it.prune();
-		}
-		else if( rit.exactMatch() )
-		{
-			result.addPath( *it );
-		}
-	}
-	return result;
+	return PathMatcher( intersectionWalk( m_root.get(), paths.m_root.get() ) );
 }
 
 bool PathMatcher::prune( const std::string &path )
@@ -519,6 +697,9 @@ PathMatcher::Node *PathMatcher::writable( Node *node, NodePtr &writableCopy, boo
 {
 	if( !shared )
 	{
+		// We have exclusive ownership of the node, so can
+		// convert it to an editable form in place.
+		node->expand();
 		return node;
 	}
 
@@ -617,24 +798,23 @@ PathMatcher::NodePtr PathMatcher::removeWalk( Node *node, const NameIterator &st
 		return result;
 	}
 
-	Node::ChildMapIterator childIt = node->children.find( *start );
-	if( childIt == node->children.end() )
+	const Name childName( *start );
+	Node *childNode = node->child( childName );
+	if( !childNode )
 	{
 		return result;
 	}
 
-	Node *childNode = childIt->second.get();
-
 	NameIterator childStart = start; childStart++;
-	NodePtr newChild = removeWalk( childIt->second.get(), childStart, end, shared, prune, removed );
+	NodePtr newChild = removeWalk( childNode, childStart, end, shared, prune, removed );
 
 	if( newChild && !newChild->isEmpty() )
 	{
-		writable( node, result, shared )->children[childIt->first] = newChild;
+		writable( node, result, shared )->children[childName] = newChild;
 	}
 	else if( childNode->isEmpty() || ( newChild && newChild->isEmpty() ) )
 	{
-		writable( node, result, shared )->children.erase( childIt->first );
+		writable( node, result, shared )->children.erase( childName );
 	}
 
 	return result;
@@ -651,27 +831,41 @@ PathMatcher::NodePtr PathMatcher::addPathsWalk( Node *node, const Node *srcNode,
 		writable( node, result, shared )->terminator = true;
 	}
 
-	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
+	// Process the children in parallel, and then apply the results
+	// serially, since the node itself can't be edited concurrently.
+
+	struct ChildResult
 	{
-		Node *srcChild = it->second.get();
 		NodePtr newChild;
-		if( Node *child = node->child( it->first ) )
-		{
-			if( child != srcChild )
+		bool added = false;
+	};
+
+	computeAndApply(
+		srcNode->childrenBegin(), srcNode->childrenEnd(), srcNode->numChildren(),
+		[&]( const Node::ChildMapValue &srcChild ) {
+			ChildResult childResult;
+			if( Node *child = node->child( srcChild.first ) )
 			{
-				newChild = addPathsWalk( child, srcChild, shared, added );
+				if( child != srcChild.second.get() )
+				{
+					childResult.newChild = addPathsWalk( child, srcChild.second.get(), shared, childResult.added );
+				}
+			}
+			else
+			{
+				childResult.newChild = srcChild.second;
+				childResult.added = true; // source node can only exist if it or a descendant is a terminator
+			}
+			return childResult;
+		},
+		[&]( const Node::ChildMapValue &srcChild, const ChildResult &childResult ) {
+			added = added || childResult.added;
+			if( childResult.newChild )
+			{
+				writable( node, result, shared )->children[srcChild.first] = childResult.newChild;
 			}
 		}
-		else
-		{
-			newChild = srcChild;
-			added = true; // source node can only exist if it or a descendant is a terminator
-		}
-		if( newChild )
-		{
-			writable( node, result, shared )->children[it->first] = newChild;
-		}
-	}
+	);
 
 	return result;
 }
@@ -730,23 +924,501 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 		removed = true;
 	}
 
-	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
+	// As for addPathsWalk(), process the children in parallel and
+	// then apply the results serially.
+
+	struct ChildResult
 	{
-		const Node::ChildMapIterator childIt = node->children.find( it->first );
-		if( childIt != node->children.end() )
-		{
-			Node *child = childIt->second.get();
-			NodePtr newChild = removePathsWalk( child, it->second.get(), shared, removed );
+		Node *child = nullptr;
+		NodePtr newChild;
+		bool removed = false;
+	};
+
+	computeAndApply(
+		srcNode->childrenBegin(), srcNode->childrenEnd(), srcNode->numChildren(),
+		[&]( const Node::ChildMapValue &srcChild ) {
+			ChildResult childResult;
+			if( Node *child = node->child( srcChild.first ) )
+			{
+				childResult.child = child;
+				childResult.newChild = removePathsWalk( child, srcChild.second.get(), shared, childResult.removed );
+			}
+			return childResult;
+		},
+		[&]( const Node::ChildMapValue &srcChild, const ChildResult &childResult ) {
+			if( !childResult.child )
+			{
+				return;
+			}
 
+			removed = removed || childResult.removed;
+			const NodePtr &newChild = childResult.newChild;
 			if( newChild && !newChild->isEmpty() )
 			{
-				writable( node, result, shared )->children[childIt->first] = newChild;
+				writable( node, result, shared )->children[srcChild.first] = newChild;
 			}
-			else if( child->isEmpty() || ( newChild && newChild->isEmpty() ) )
+			else if( childResult.child->isEmpty() || ( newChild && newChild->isEmpty() ) )
+			{
+				writable( node, result, shared )->children.erase( srcChild.first );
+			}
+		}
+	);
+
+	return result;
+}
+
+PathMatcher::NodePtr PathMatcher::compactWalk( Node *node )
+{
+	if( !node->hasChildren() )
+	{
+		return nullptr;
+	}
+
+	// Compact the children first. We never modify a node in place,
+	// because it may be shared with other PathMatchers which are
+	// being read concurrently.
+	std::vector<NodePtr> newChildren;
+	bool changed = !node->isCompact();
+	for( Node::ConstChildIterator it = node->childrenBegin(), eIt = node->childrenEnd(); it != eIt; ++it )
+	{
+		NodePtr newChild = compactWalk( it->second.get() );
+		changed = changed || newChild;
+		newChildren.push_back( newChild ? newChild : it->second );
+	}
+
+	if( !changed )
+	{
+		return nullptr;
+	}
+
+	NodePtr result = new Node( node->terminator );
+	result->compactChildren.reserve( newChildren.size() );
+	std::vector<NodePtr>::const_iterator newChildIt = newChildren.begin();
+	for( Node::ConstChildIterator it = node->childrenBegin(), eIt = node->childrenEnd(); it != eIt; ++it, ++newChildIt )
+	{
+		result->compactChildren.emplace_back( it->first, *newChildIt );
+	}
+
+	return result;
+}
+
+PathMatcher::NodePtr PathMatcher::buildWalk( SortedPathIterator begin, SortedPathIterator end, size_t depth )
+{
+	// Since the paths are sorted, any which terminate at this
+	// node will come before all those which continue to its
+	// descendants.
+	bool terminator = false;
+	while( begin != end && begin->size() == depth )
+	{
+		terminator = true;
+		++begin;
+	}
+
+	if( begin == end )
+	{
+		// We're a leaf, so can use the same shared instance
+		// that addWalk() uses.
+		return terminator ? Node::leaf() : new Node;
+	}
+
+	// Find the ranges of paths belonging to each child. The
+	// sorting means that these are contiguous.
+	std::vector<SortedPathIterator> childRanges;
+	for( SortedPathIterator it = begin; it != end; )
+	{
+		childRanges.push_back( it );
+		const IECore::InternedString &childName = (*it)[depth];
+		do
+		{
+			++it;
+			if( it != end && it->size() <= depth )
 			{
-				writable( node, result, shared )->children.erase( childIt->first );
+				throw IECore::InvalidArgumentException( "PathMatcher : Paths are not sorted" );
 			}
+		} while( it != end && (*it)[depth] == childName );
+	}
+	childRanges.push_back( end );
+
+	const size_t numChildren = childRanges.size() - 1;
+	std::vector<NodePtr> children( numChildren );
+	parallelForEach(
+		numChildren,
+		[&]( size_t i ) {
+			children[i] = buildWalk( childRanges[i], childRanges[i+1], depth + 1 );
 		}
+	);
+
+	std::vector<Name> names;
+	names.reserve( numChildren );
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		names.push_back( Name( (*childRanges[i])[depth] ) );
+	}
+
+	NodePtr result = compactNode( terminator, names, children );
+	if( !result )
+	{
+		// The same name appeared in two separate ranges.
+		throw IECore::InvalidArgumentException( "PathMatcher : Paths are not sorted" );
+	}
+
+	return result;
+}
+
+PathMatcher::NodePtr PathMatcher::compactNode( bool terminator, const std::vector<Name> &names, const std::vector<NodePtr> &children )
+{
+	// Sort the children into the order required by Node, and
+	// store them compactly.
+
+	const size_t numChildren = names.size();
+	std::vector<size_t> order( numChildren );
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		order[i] = i;
+	}
+
+	std::sort(
+		order.begin(), order.end(),
+		[&names]( size_t a, size_t b ) { return names[a] < names[b]; }
+	);
+
+	NodePtr result = new Node( terminator );
+	result->compactChildren.reserve( numChildren );
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		const size_t index = order[i];
+		if( i && !( names[order[i-1]] < names[index] ) )
+		{
+			return nullptr;
+		}
+		result->compactChildren.emplace_back( names[index], children[index] );
+	}
+
+	return result;
+}
+
+PathMatcher::NodePtr PathMatcher::intersectionWalk( Node *node, Node *otherNode )
+{
+	if( node == otherNode )
+	{
+		// Identical subtrees, as is common with lazy-copy-on-write.
+		// The intersection is the subtree itself.
+		return node;
+	}
+
+	NodePtr result = new Node( node->terminator && otherNode->terminator );
+
+	computeAndApply(
+		node->childrenBegin(), node->childrenEnd(), node->numChildren(),
+		[&]( const Node::ChildMapValue &child ) {
+			NodePtr newChild;
+			if( Node *otherChild = otherNode->child( child.first ) )
+			{
+				newChild = intersectionWalk( child.second.get(), otherChild );
+				if( newChild->isEmpty() )
+				{
+					newChild = nullptr;
+				}
+			}
+			return newChild;
+		},
+		[&]( const Node::ChildMapValue &child, const NodePtr &newChild ) {
+			if( newChild )
+			{
+				// Children are visited in sorted order, so we
+				// can always insert at the end.
+				result->children.insert( result->children.end(), Node::ChildMapValue( child.first, newChild ) );
+			}
+		}
+	);
+
+	return result;
+}
+
+void PathMatcher::hashWalk( const Node *node, MurmurHash &h )
+{
+	// The children are stored in InternedString address order, which
+	// varies from process to process. So we hash them in alphabetical
+	// order instead, to give a hash that is stable between processes.
+
+	auto children = elementPointers( node->childrenBegin(), node->childrenEnd() );
+	std::sort(
+		children.begin(), children.end(),
+		[]( const Node::ChildMapValue *a, const Node::ChildMapValue *b ) {
+			return strcmp( a->first.name.c_str(), b->first.name.c_str() ) < 0;
+		}
+	);
+
+	std::vector<MurmurHash> childHashes( children.size() );
+	parallelForEach(
+		children.size(),
+		[&]( size_t i ) {
+			const Node *child = children[i]->second.get();
+			if( child->hasChildren() )
+			{
+				hashWalk( child, childHashes[i] );
+			}
+		}
+	);
+
+	h.append( (uint64_t)children.size() );
+	for( size_t i = 0, e = children.size(); i < e; ++i )
+	{
+		h.append( children[i]->first.name );
+		h.append( (unsigned char)children[i]->second->terminator );
+		h.append( childHashes[i] );
+	}
+}
+
+size_t PathMatcher::memoryUsageWalk( const Node *node, std::unordered_set<const Node *> &visited )
+{
+	// Nodes may appear many times in a single tree (the shared leaf
+	// instance always does), so we only count each one once.
+	if( !visited.insert( node ).second )
+	{
+		return 0;
+	}
+
+	// The map allocates a separate tree node for each child, which carries
+	// a colour and parent, left and right pointers in addition to the value.
+	static const size_t mapNodeOverhead = 4 * sizeof( void * );
+
+	size_t result = sizeof( Node );
+	result += node->children.size() * ( sizeof( Node::ChildMapValue ) + mapNodeOverhead );
+	result += node->compactChildren.capacity() * sizeof( Node::ChildMapValue );
+	for( Node::ConstChildIterator it = node->childrenBegin(), eIt = node->childrenEnd(); it != eIt; ++it )
+	{
+		result += memoryUsageWalk( it->second.get(), visited );
+	}
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Serialisation
+//////////////////////////////////////////////////////////////////////////
+
+// The encoded form is a single block of bytes, laid out as follows :
+//
+// - numNames : uint32
+// - numNodes : uint32
+// - nameIndices : uint32[numNodes]
+// - subtreeSizes : uint32[numNodes]
+// - terminators : uint8[numNodes]
+// - names : numNames null-terminated strings
+//
+// Nodes are listed in depth-first order, starting with the root, whose
+// name index is unused. The subtree size of a node counts the node itself
+// and all its descendants, so the children of any node can be located
+// without visiting their descendants. This allows the tree to be rebuilt
+// in parallel. Each name is stored only once, however many nodes use it,
+// so that only a single InternedString is constructed per name when
+// decoding. All integers are little endian.
+
+struct PathMatcher::EncodedTree
+{
+
+	uint32_t nameIndex( size_t node ) const
+	{
+		return decodeUInt32( nameIndices + node * 4 );
+	}
+
+	uint32_t subtreeSize( size_t node ) const
+	{
+		return decodeUInt32( subtreeSizes + node * 4 );
+	}
+
+	const char *nameIndices;
+	const char *subtreeSizes;
+	const char *terminators;
+	std::vector<Name> names;
+
+};
+
+void PathMatcher::encode( std::vector<char> &data ) const
+{
+	std::vector<uint32_t> nameIndices;
+	std::vector<uint32_t> subtreeSizes;
+	std::vector<char> terminators;
+
+	std::vector<const std::string *> names;
+	std::unordered_map<const std::string *, uint32_t> nameMap;
+
+	// RawIterator visits the nodes in depth-first order, and we use a
+	// stack of open ancestors to fill in the subtree sizes once we have
+	// left them.
+	std::vector<size_t> ancestors;
+	for( RawIterator it = begin(), eIt = end(); it != eIt; ++it )
+	{
+		const size_t index = nameIndices.size();
+		while( ancestors.size() > it->size() )
+		{
+			subtreeSizes[ancestors.back()] = index - ancestors.back();
+			ancestors.pop_back();
+		}
+		ancestors.push_back( index );
+
+		uint32_t nameIndex = 0;
+		if( it->size() )
+		{
+			const std::string *name = &it->back().string();
+			auto inserted = nameMap.insert( std::make_pair( name, (uint32_t)names.size() ) );
+			if( inserted.second )
+			{
+				names.push_back( name );
+			}
+			nameIndex = inserted.first->second;
+		}
+
+		nameIndices.push_back( nameIndex );
+		subtreeSizes.push_back( 0 );
+		terminators.push_back( it.exactMatch() );
+	}
+
+	const size_t numNodes = nameIndices.size();
+	while( ancestors.size() )
+	{
+		subtreeSizes[ancestors.back()] = numNodes - ancestors.back();
+		ancestors.pop_back();
+	}
+
+	if( numNodes > std::numeric_limits<uint32_t>::max() )
+	{
+		throw IECore::Exception( "PathMatcher : Too many paths to encode" );
+	}
+
+	size_t namesSize = 0;
+	for( const auto &name : names )
+	{
+		namesSize += name->size() + 1;
+	}
+
+	data.resize( 8 + numNodes * 9 + namesSize );
+	char *dst = data.data();
+
+	encodeUInt32( names.size(), dst ); dst += 4;
+	encodeUInt32( numNodes, dst ); dst += 4;
+	for( const auto &i : nameIndices )
+	{
+		encodeUInt32( i, dst ); dst += 4;
+	}
+	for( const auto &s : subtreeSizes )
+	{
+		encodeUInt32( s, dst ); dst += 4;
+	}
+	memcpy( dst, terminators.data(), numNodes ); dst += numNodes;
+	for( const auto &name : names )
+	{
+		memcpy( dst, name->c_str(), name->size() + 1 );
+		dst += name->size() + 1;
+	}
+}
+
+PathMatcher PathMatcher::decode( const char *data, size_t size )
+{
+	const char *invalid = "PathMatcher : Invalid encoded data";
+	if( size < 8 )
+	{
+		throw IECore::Exception( invalid );
+	}
+
+	const size_t numNames = decodeUInt32( data );
+	const size_t numNodes = decodeUInt32( data + 4 );
+	if( size < 8 + numNodes * 9 )
+	{
+		throw IECore::Exception( invalid );
+	}
+
+	if( !numNodes )
+	{
+		// RawIterator doesn't visit the root of an empty
+		// PathMatcher, so we won't have encoded it.
+		return PathMatcher();
+	}
+
+	EncodedTree tree;
+	tree.nameIndices = data + 8;
+	tree.subtreeSizes = tree.nameIndices + numNodes * 4;
+	tree.terminators = tree.subtreeSizes + numNodes * 4;
+
+	if( tree.subtreeSize( 0 ) != numNodes )
+	{
+		throw IECore::Exception( invalid );
+	}
+
+	// Locate the names, and then intern them in parallel. Interning is
+	// the most expensive part of this, and InternedString is threadsafe.
+
+	std::vector<const char *> nameStrings;
+	nameStrings.reserve( numNames );
+	const char *namesEnd = data + size;
+	for( const char *name = tree.terminators + numNodes; nameStrings.size() < numNames; )
+	{
+		const char *nameEnd = name < namesEnd ? (const char *)memchr( name, 0, namesEnd - name ) : nullptr;
+		if( !nameEnd )
+		{
+			throw IECore::Exception( invalid );
+		}
+		nameStrings.push_back( name );
+		name = nameEnd + 1;
+	}
+
+	std::vector<InternedString> internedNames( numNames );
+	std::vector<unsigned char> types( numNames );
+	parallelForEach(
+		numNames,
+		[&]( size_t i ) {
+			internedNames[i] = InternedString( nameStrings[i] );
+			types[i] = Name( internedNames[i] ).type;
+		}
+	);
+
+	tree.names.reserve( numNames );
+	for( size_t i = 0; i < numNames; ++i )
+	{
+		tree.names.push_back( Name( internedNames[i], (Name::Type)types[i] ) );
+	}
+
+	return PathMatcher( decodeWalk( tree, 0 ) );
+}
+
+PathMatcher::NodePtr PathMatcher::decodeWalk( const EncodedTree &tree, size_t index )
+{
+	const char *invalid = "PathMatcher : Invalid encoded data";
+
+	const bool terminator = tree.terminators[index];
+	const size_t end = index + tree.subtreeSize( index );
+	if( end == index + 1 )
+	{
+		return terminator ? Node::leaf() : new Node;
+	}
+
+	std::vector<size_t> childIndices;
+	std::vector<Name> names;
+	for( size_t childIndex = index + 1; childIndex < end; )
+	{
+		const size_t childSize = tree.subtreeSize( childIndex );
+		const size_t nameIndex = tree.nameIndex( childIndex );
+		if( !childSize || childIndex + childSize > end || nameIndex >= tree.names.size() )
+		{
+			throw IECore::Exception( invalid );
+		}
+		childIndices.push_back( childIndex );
+		names.push_back( tree.names[nameIndex] );
+		childIndex += childSize;
+	}
+
+	std::vector<NodePtr> children( childIndices.size() );
+	parallelForEach(
+		childIndices.size(),
+		[&]( size_t i ) {
+			children[i] = decodeWalk( tree, childIndices[i] );
+		}
+	);
+
+	NodePtr result = compactNode( terminator, names, children );
+	if( !result )
+	{
+		throw IECore::Exception( invalid );
 	}
 
 	return result;
@@ -42,47 +42,12 @@ using namespace IECore;
 namespace
 {
 
-//////////////////////////////////////////////////////////////////////////
-// Support code for SharedDataHolder<GafferScene::PathMatcher>::hash()
-//////////////////////////////////////////////////////////////////////////
-
-struct HashNode
-{
-
-	HashNode( const char *name, unsigned char exactMatch )
-		:	name( name ), exactMatch( exactMatch )
-	{
-	}
-
-	bool operator < ( const HashNode &rhs ) const
-	{
-		return strcmp( name, rhs.name ) < 0;
-	}
-
-	const char *name;
-	unsigned char exactMatch;
-
-};
-
-typedef std::vector<HashNode> HashNodes;
-typedef std::stack<HashNodes> HashStack;
-
-void popHashNodes( HashStack &stack, size_t size, IECore::MurmurHash &h )
-{
-	while( stack.size() > size )
-	{
-		h.append( (uint64_t)stack.top().size() );
-		std::sort( stack.top().begin(), stack.top().end() );
-		for( HashNodes::const_iterator nIt = stack.top().begin(), nEIt = stack.top().end(); nIt != nEIt; ++nIt )
-		{
-			h.append( nIt->name );
-			h.append( nIt->exactMatch );
-		}
-		stack.pop();
-	}
-}
-
-static const unsigned int g_ioVersion = 0;
+// Version 0 : Separate entries for the names, path lengths and exact matches
+//             of every node, loaded by adding paths one at a time.
+// Version 1 : A single entry holding the flat encoding provided by
+//             PathMatcher::encode(), loaded in parallel.
+static const unsigned int g_ioVersion = 1;
+static const IndexedIO::EntryID g_encodedEntry( "encoded" );
 
 } // namespace
 
@@ -97,23 +62,12 @@ void PathMatcherData::save( SaveContext *context ) const
 	Data::save( context );
 	IndexedIOPtr container = context->container( staticTypeName(), g_ioVersion );
 
-	std::vector<InternedString> strings;
-	std::vector<unsigned int> pathLengths;
-	std::vector<unsigned char> exactMatches;
-
-	for( PathMatcher::RawIterator it = readable().begin(), eIt = readable().end(); it != eIt; ++it )
-	{
-		pathLengths.push_back( it->size() );
-		if( it->size() )
-		{
-			strings.push_back( it->back() );
-		}
-		exactMatches.push_back( it.exactMatch() );
-	}
-
-	container->write( "strings", strings.data(), strings.size() );
-	container->write( "pathLengths", pathLengths.data(), pathLengths.size() );
-	container->write( "exactMatches", exactMatches.data(), exactMatches.size() );
+	// We write everything as a single array so that it can be read in
+	// one shot, and so that IndexedIO implementations which compress
+	// large entries can compress it as a single block.
+	std::vector<char> encoded;
+	readable().encode( encoded );
+	container->write( g_encodedEntry, encoded.data(), encoded.size() );
 }
 
 template<>
@@ -123,6 +77,16 @@ void PathMatcherData::load( LoadContextPtr context )
 	unsigned int v = g_ioVersion;
 	ConstIndexedIOPtr container = context->container( staticTypeName(), v );
 
+	if( v > 0 )
+	{
+		const IndexedIO::Entry encodedEntry = container->entry( g_encodedEntry );
+		std::vector<char> encoded( encodedEntry.arrayLength() );
+		char *encodedPtr = encoded.data();
+		container->read( g_encodedEntry, encodedPtr, encodedEntry.arrayLength() );
+		writable() = PathMatcher::decode( encoded.data(), encoded.size() );
+		return;
+	}
+
 	const IndexedIO::Entry stringsEntry = container->entry( "strings" );
 	std::vector<InternedString> strings;
 	strings.resize( stringsEntry.arrayLength() );
@@ -156,47 +120,23 @@ void PathMatcherData::load( LoadContextPtr context )
 	}
 }
 
-// Our hash is complicated by the fact that PathMatcher::Iterator doesn't
-// guarantee the order of visiting child nodes in its tree (because it
-// sorts using InternedString addresses for the fastest possible match()
-// implementation). We therefore have to use a stack to keep track of
-// our traversal through the tree, and output all the children at each
-// level only after sorting them alphabetically.
 template<>
 MurmurHash SharedDataHolder<PathMatcher>::hash() const
 {
 	IECore::MurmurHash result;
-
-	HashStack stack;
-	PathMatcher m = readable();
-	for( PathMatcher::RawIterator it = m.begin(), eIt = m.end(); it != eIt; ++it )
-	{
-		// The iterator is recursive, so we use a stack to keep
-		// track of where we are. Resize the stack to match our
-		// current depth. The required size has the +1 because
-		// we need a stack entry for the root item.
-		size_t requiredStackSize = it->size() + 1;
-		if( requiredStackSize > stack.size() )
-		{
-			// Going a level deeper.
-			stack.push( HashNodes() );
-			assert( stack.size() == requiredStackSize );
-		}
-		else if( requiredStackSize < stack.size() )
-		{
-			// Returning from recursion to the child nodes.
-			// Output the hashes for the children we visited
-			// and stored on the stack previously.
-			popHashNodes( stack, requiredStackSize, result );
-		}
-
-		stack.top().push_back( HashNode( it->size() ? it->back().c_str() : "", it.exactMatch() ) );
-	}
-	popHashNodes( stack, 0, result );
-
+	readable().hash( result );
 	return result;
 }
 
+template<>
+void PathMatcherData::memoryUsage( Object::MemoryAccumulator &accumulator ) const
+{
+	Data::memoryUsage( accumulator );
+	// The PathMatcher may be shared with other PathMatcherData via
+	// lazy-copy-on-write, so we pass its address to avoid double counting.
+	accumulator.accumulate( &readable(), sizeof( PathMatcher ) + readable().memoryUsage() );
+}
+
 template class TypedData<PathMatcher>;
 
 } // namespace IECore
@@ -45,12 +45,80 @@ using namespace IECore;
 
 static IndexedIO::EntryID g_valueEntry("value");
 static IndexedIO::EntryID g_sizeEntry("size");
+static IndexedIO::EntryID g_hashEntry("hash");
+
+// Arrays at least this many bytes in size are eligible for lazy
+// loading, and store their hash when saved with lazy loading enabled.
+static const size_t g_lazyLoadingThreshold = 64 * 1024;
+
+namespace
+{
+
+// Stores the hash alongside the array, so that it is available from lazily
+// loaded data without reading the array. We only do this when lazy loading
+// is enabled, so that files written otherwise keep the existing format.
+template<typename T>
+void saveHash( const SharedDataHolder<T> &data, size_t arrayLength, IndexedIO *container )
+{
+	if( !Data::getLazyLoading() || arrayLength * sizeof( typename TypedDataTraits<T>::BaseType ) < g_lazyLoadingThreshold )
+	{
+		return;
+	}
+
+	const MurmurHash h = data.valueHash();
+	const uint64_t hash[3] = { (uint64_t)Data::getHashVersion(), h.h1(), h.h2() };
+	container->write( g_hashEntry, hash, 3 );
+}
+
+// Defers reading of the array until it is first accessed, if lazy loading
+// has been requested and the array is large enough to make it worthwhile.
+// Returns false if the array should be loaded immediately.
+template<typename T>
+bool setLoader( SharedDataHolder<T> &data, bool lazy, const IndexedIO *rawContainer, const IndexedIO::Entry &valueEntry )
+{
+	typedef typename TypedDataTraits<T>::BaseType BaseType;
+	const size_t arrayLength = valueEntry.arrayLength();
+	if( !lazy || !Data::getLazyLoading() || arrayLength * sizeof( BaseType ) < g_lazyLoadingThreshold )
+	{
+		return false;
+	}
+
+	ConstIndexedIOPtr container = rawContainer;
+	auto loader = [container, arrayLength]( T &value ) {
+		value.resize( arrayLength / ( sizeof( typename T::value_type ) / sizeof( BaseType ) ) );
+		BaseType *p = reinterpret_cast<BaseType *>( value.data() );
+		container->read( g_valueEntry, p, arrayLength );
+	};
+
+	if( container->hasEntry( g_hashEntry ) )
+	{
+		uint64_t hash[3];
+		uint64_t *hashPtr = hash;
+		container->read( g_hashEntry, hashPtr, 3 );
+		const MurmurHash h( hash[1], hash[2] );
+		data.setLoader( loader, &h, (Data::HashVersion)hash[0] );
+	}
+	else
+	{
+		data.setLoader( loader );
+	}
+
+	return true;
+}
+
+} // namespace
 
 #define IE_CORE_DEFINEVECTORTYPEDDATAMEMUSAGESPECIALISATION( TNAME )										\
 	template<>																								\
 	void TNAME::memoryUsage( Object::MemoryAccumulator &accumulator ) const			\
 	{																										\
 		Data::memoryUsage( accumulator );																	\
+		if( !m_data.loaded() )																				\
+		{																									\
+			/* Don't trigger lazy loading just to measure it */												\
+			accumulator.accumulate( sizeof( TNAME::ValueType ) );											\
+			return;																							\
+		}																									\
 		accumulator.accumulate( &readable(), sizeof( TNAME::ValueType ) + readable().capacity() * sizeof( TNAME::ValueType::value_type ) );	\
 	}																										\
 
@@ -91,6 +159,7 @@ static IndexedIO::EntryID g_sizeEntry("size");
 		IndexedIO *container = context->rawContainer();												\
 		assert( ( sizeof( TNAME::ValueType::value_type ) / sizeof( TNAME::BaseType ) ) == N );		\
 		container->write( g_valueEntry, baseReadable(), baseSize() );								\
+		saveHash( m_data, baseSize(), container );													\
 	}																								\
 	template<>																						\
 	void TNAME::load( LoadContextPtr context )														\
@@ -100,6 +169,10 @@ static IndexedIO::EntryID g_sizeEntry("size");
 		{																							\
 			const IndexedIO *container = context->rawContainer();									\
 			IndexedIO::Entry e = container->entry( g_valueEntry );									\
+			if( setLoader( m_data, context->lazy(), container, e ) )								\
+			{																						\
+				return;																				\
+			}																						\
 			writable().resize( e.arrayLength() / N );												\
 			if ( e.arrayLength() ) 																	\
 			{ 																						\
@@ -190,6 +263,11 @@ template<>
 void StringVectorData::memoryUsage( Object::MemoryAccumulator &accumulator ) const
 {
 	Data::memoryUsage( accumulator );
+	if( !m_data.loaded() )
+	{
+		accumulator.accumulate( sizeof( std::vector<std::string> ) );
+		return;
+	}
 
 	size_t count = 0;
 	const std::vector< std::string > &vector = readable();
@@ -36,21 +36,339 @@
 
 #include "IECoreGL/MeshPrimitive.h"
 
-#include "IECoreScene/FaceVaryingPromotionOp.h"
 #include "IECoreScene/MeshAlgo.h"
-#include "IECoreScene/MeshNormalsOp.h"
 #include "IECoreScene/MeshPrimitive.h"
 
-#include "IECore/DespatchTypedData.h"
+#include "IECore/DataAlgo.h"
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
+#include "IECore/MurmurHash.h"
 #include "IECore/SimpleTypedData.h"
+#include "IECore/TypeTraits.h"
 
 #include "boost/format.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
 #include <cassert>
+#include <cstring>
 
 using namespace IECoreGL;
 
+//////////////////////////////////////////////////////////////////////////
+// Vertex welding
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Provides access to the value of a primitive variable at each
+// face-vertex of a mesh, without expanding it.
+struct WeldVariable
+{
+
+	WeldVariable( const std::string &name, const IECoreScene::PrimitiveVariable &primVar, size_t elementSize )
+		:	name( name ),
+			primVar( primVar ),
+			bytes( static_cast<const char *>( IECore::address( primVar.data.get() ) ) ),
+			elementSize( elementSize ),
+			indices( primVar.indices ? &primVar.indices->readable() : nullptr )
+	{
+	}
+
+	size_t index( size_t faceVertex, size_t face, const std::vector<int> &vertexIds ) const
+	{
+		size_t i;
+		switch( primVar.interpolation )
+		{
+			case IECoreScene::PrimitiveVariable::Vertex :
+			case IECoreScene::PrimitiveVariable::Varying :
+				i = vertexIds[faceVertex];
+				break;
+			case IECoreScene::PrimitiveVariable::Uniform :
+				i = face;
+				break;
+			default :
+				i = faceVertex;
+		}
+		return indices ? (*indices)[i] : i;
+	}
+
+	const char *value( size_t faceVertex, size_t face, const std::vector<int> &vertexIds ) const
+	{
+		return bytes + index( faceVertex, face, vertexIds ) * elementSize;
+	}
+
+	// Only unindexed face-varying data is welded by value. Everything
+	// else is welded by index, so that the result depends only on the
+	// topology and not on values such as P and N which change from
+	// frame to frame in a deforming mesh.
+	bool weldByValue() const
+	{
+		return !indices && primVar.interpolation == IECoreScene::PrimitiveVariable::FaceVarying;
+	}
+
+	std::string name;
+	IECoreScene::PrimitiveVariable primVar;
+	const char *bytes;
+	size_t elementSize;
+	const std::vector<int> *indices;
+
+};
+
+typedef std::vector<WeldVariable> WeldVariables;
+
+template<typename T>
+using EnableIfNumeric = std::enable_if<IECore::TypeTraits::IsNumericBasedVectorTypedData<IECore::TypedData<std::vector<T>>>::value>;
+
+// Returns the size of each element of numeric vector data, and 0
+// for all other types.
+struct ElementSize
+{
+
+	template<typename T, typename = typename EnableIfNumeric<T>::type>
+	size_t operator()( const IECore::TypedData<std::vector<T>> *data )
+	{
+		return sizeof( T );
+	}
+
+	size_t operator()( const IECore::Data *data )
+	{
+		return 0;
+	}
+
+};
+
+// The result of triangulating and welding a mesh. Because welding
+// doesn't depend on vertex values, this can be shared by every frame
+// of a deforming mesh, and only the primitive variables need to be
+// gathered again. Sharing `weldedIds` also means the index buffer is
+// shared via the CachedConverter.
+struct WeldedTopology : public IECore::RefCounted
+{
+
+	IE_CORE_DECLAREMEMBERPTR( WeldedTopology );
+
+	size_t memoryUsage() const
+	{
+		return weldedIds->Object::memoryUsage() + ( faceVertices.capacity() + faces.capacity() ) * sizeof( int );
+	}
+
+	// The welded vertex for each triangle corner.
+	IECore::ConstUIntVectorDataPtr weldedIds;
+	// The original face-vertex and face represented by
+	// each welded vertex.
+	std::vector<int> faceVertices;
+	std::vector<int> faces;
+
+};
+
+IE_CORE_DECLAREPTR( WeldedTopology );
+
+// Fan triangulates the mesh (matching MeshAlgo::triangulate()), and merges
+// all triangle corners where every primitive variable is identical.
+ConstWeldedTopologyPtr weld( const IECoreScene::MeshPrimitive *mesh, const WeldVariables &variables )
+{
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+
+	// Find the original face-vertex and face for each triangle corner.
+
+	std::vector<int> cornerFaceVertices;
+	std::vector<int> cornerFaces;
+	cornerFaceVertices.reserve( ( vertexIds.size() - verticesPerFace.size() * 2 ) * 3 );
+	cornerFaces.reserve( cornerFaceVertices.capacity() );
+
+	int faceVertexStart = 0;
+	for( int face = 0, numFaces = verticesPerFace.size(); face < numFaces; ++face )
+	{
+		const int numFaceVertices = verticesPerFace[face];
+		for( int i = 1; i < numFaceVertices - 1; ++i )
+		{
+			cornerFaceVertices.push_back( faceVertexStart );
+			cornerFaceVertices.push_back( faceVertexStart + i );
+			cornerFaceVertices.push_back( faceVertexStart + i + 1 );
+			cornerFaces.insert( cornerFaces.end(), 3, face );
+		}
+		faceVertexStart += numFaceVertices;
+	}
+
+	const size_t numCorners = cornerFaceVertices.size();
+
+	auto compare = [&]( size_t a, size_t b ) {
+		const int faceVertexA = cornerFaceVertices[a];
+		const int faceVertexB = cornerFaceVertices[b];
+		for( const auto &v : variables )
+		{
+			if( v.weldByValue() )
+			{
+				if( int c = memcmp( v.value( faceVertexA, cornerFaces[a], vertexIds ), v.value( faceVertexB, cornerFaces[b], vertexIds ), v.elementSize ) )
+				{
+					return c;
+				}
+			}
+			else
+			{
+				const size_t indexA = v.index( faceVertexA, cornerFaces[a], vertexIds );
+				const size_t indexB = v.index( faceVertexB, cornerFaces[b], vertexIds );
+				if( indexA != indexB )
+				{
+					return indexA < indexB ? -1 : 1;
+				}
+			}
+		}
+		return 0;
+	};
+
+	// Sort the corners so that identical ones are adjacent. Ties are
+	// broken by corner index, so the sort is deterministic.
+
+	std::vector<size_t> order( numCorners );
+	for( size_t i = 0; i < numCorners; ++i )
+	{
+		order[i] = i;
+	}
+
+	tbb::parallel_sort(
+		order.begin(), order.end(),
+		[&]( size_t a, size_t b ) {
+			const int c = compare( a, b );
+			return c < 0 || ( c == 0 && a < b );
+		}
+	);
+
+	// Assign an id to each run of identical corners.
+
+	WeldedTopologyPtr result = new WeldedTopology;
+	IECore::UIntVectorDataPtr weldedIdsData = new IECore::UIntVectorData;
+	std::vector<unsigned int> &weldedIds = weldedIdsData->writable();
+	weldedIds.resize( numCorners );
+	for( size_t i = 0; i < numCorners; ++i )
+	{
+		if( !i || compare( order[i-1], order[i] ) )
+		{
+			result->faceVertices.push_back( cornerFaceVertices[order[i]] );
+			result->faces.push_back( cornerFaces[order[i]] );
+		}
+		weldedIds[order[i]] = result->faceVertices.size() - 1;
+	}
+
+	result->weldedIds = weldedIdsData;
+	return result;
+}
+
+// Gathers the value for each welded vertex from the face-vertex
+// which represents it.
+struct GatherWelded
+{
+
+	template<typename T, typename = typename EnableIfNumeric<T>::type>
+	IECore::DataPtr operator()( const IECore::TypedData<std::vector<T>> *data, const WeldVariable &variable, const WeldedTopology &topology, const std::vector<int> &vertexIds )
+	{
+		return gather( data, variable, topology, vertexIds );
+	}
+
+	template<typename T, typename = typename EnableIfNumeric<T>::type>
+	IECore::DataPtr operator()( const IECore::GeometricTypedData<std::vector<T>> *data, const WeldVariable &variable, const WeldedTopology &topology, const std::vector<int> &vertexIds )
+	{
+		typename IECore::GeometricTypedData<std::vector<T>>::Ptr result = gather( data, variable, topology, vertexIds );
+		result->setInterpretation( data->getInterpretation() );
+		return result;
+	}
+
+	IECore::DataPtr operator()( const IECore::Data *data, const WeldVariable &variable, const WeldedTopology &topology, const std::vector<int> &vertexIds )
+	{
+		return nullptr;
+	}
+
+	private :
+
+		template<typename DataType>
+		typename DataType::Ptr gather( const DataType *data, const WeldVariable &variable, const WeldedTopology &topology, const std::vector<int> &vertexIds )
+		{
+			typename DataType::Ptr result = new DataType;
+
+			const auto &in = data->readable();
+			auto &out = result->writable();
+			out.resize( topology.faceVertices.size() );
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, out.size() ),
+				[&]( const tbb::blocked_range<size_t> &range )
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						out[i] = in[variable.index( topology.faceVertices[i], topology.faces[i], vertexIds )];
+					}
+				},
+				taskGroupContext
+			);
+
+			return result;
+		}
+
+};
+
+// Conceptually the key for the topology cache is just a hash of
+// everything that affects welding, but the getter also needs the
+// mesh and variables, so we use the LRUCache's GetterKey feature
+// in the same way as the CachedConverter.
+struct TopologyCacheGetterKey
+{
+
+	TopologyCacheGetterKey( const IECoreScene::MeshPrimitive *mesh, const WeldVariables &variables )
+		:	mesh( mesh ), variables( variables )
+	{
+		mesh->topologyHash( hash );
+		for( const auto &v : variables )
+		{
+			hash.append( (int)v.primVar.interpolation );
+			if( v.indices )
+			{
+				v.primVar.indices->hash( hash );
+			}
+			else if( v.weldByValue() )
+			{
+				v.primVar.data->hash( hash );
+			}
+		}
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const IECoreScene::MeshPrimitive *mesh;
+	const WeldVariables &variables;
+	IECore::MurmurHash hash;
+
+};
+
+ConstWeldedTopologyPtr topologyCacheGetter( const TopologyCacheGetterKey &key, size_t &cost )
+{
+	ConstWeldedTopologyPtr result = weld( key.mesh, key.variables );
+	cost = result->memoryUsage();
+	return result;
+}
+
+typedef IECore::LRUCache<IECore::MurmurHash, ConstWeldedTopologyPtr, IECore::LRUCachePolicy::Parallel, TopologyCacheGetterKey> TopologyCache;
+
+TopologyCache &topologyCache()
+{
+	static TopologyCache g_cache( topologyCacheGetter, 100 * 1024 * 1024 );
+	return g_cache;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ToGLMeshConverter
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ToGLMeshConverter );
 
 ToGLConverter::ConverterDescription<ToGLMeshConverter> ToGLMeshConverter::g_description;
@@ -67,46 +385,92 @@ ToGLMeshConverter::~ToGLMeshConverter()
 
 IECore::RunTimeTypedPtr ToGLMeshConverter::doConversion( IECore::ConstObjectPtr src, IECore::ConstCompoundObjectPtr operands ) const
 {
-	IECoreScene::MeshPrimitivePtr mesh = boost::static_pointer_cast<IECoreScene::MeshPrimitive>( src->copy() ); // safe because the parameter validated it for us
+	IECoreScene::ConstMeshPrimitivePtr mesh = boost::static_pointer_cast<const IECoreScene::MeshPrimitive>( src ); // safe because the parameter validated it for us
 
 	if( !mesh->variableData<IECore::V3fVectorData>( "P", IECoreScene::PrimitiveVariable::Vertex ) )
 	{
 		throw IECore::Exception( "Must specify primitive variable \"P\", of type V3fVectorData and interpolation type Vertex." );
 	}
 
-	if( mesh->variables.find( "N" )==mesh->variables.end() )
+	// Collect the primitive variables to be converted. If the mesh has no normals
+	// we need to explicitly add some. If it's a polygon mesh (interpolation==linear)
+	// then we add per-face normals for a faceted look and if it's a subdivision
+	// mesh we add smooth per-vertex normals.
+
+	IECoreScene::PrimitiveVariableMap variables = mesh->variables;
+	if( variables.find( "N" ) == variables.end() )
 	{
-		// the mesh has no normals - we need to explicitly add some. if it's a polygon
-		// mesh (interpolation==linear) then we add per-face normals for a faceted look
-		// and if it's a subdivision mesh we add smooth per-vertex normals.
-		IECoreScene::MeshNormalsOpPtr normalOp = new IECoreScene::MeshNormalsOp();
-		normalOp->inputParameter()->setValue( mesh );
-		normalOp->copyParameter()->setTypedValue( false );
-		normalOp->interpolationParameter()->setNumericValue(
+		variables["N"] = IECoreScene::MeshAlgo::calculateNormals(
+			mesh.get(),
 			mesh->interpolation() == "linear" ? IECoreScene::PrimitiveVariable::Uniform : IECoreScene::PrimitiveVariable::Vertex
 		);
-		normalOp->operate();
 	}
 
-	mesh = IECoreScene::MeshAlgo::triangulate( mesh.get() );
-
-	IECoreScene::FaceVaryingPromotionOpPtr faceVaryingOp = new IECoreScene::FaceVaryingPromotionOp;
-	faceVaryingOp->inputParameter()->setValue( mesh );
-	faceVaryingOp->copyParameter()->setTypedValue( false );
-	faceVaryingOp->operate();
+	WeldVariables weldVariables;
+	WeldVariables constantVariables;
+	for( const auto &primVar : variables )
+	{
+		if( !primVar.second.data )
+		{
+			IECore::msg( IECore::Msg::Warning, "ToGLMeshConverter", boost::format( "No data given for primvar \"%s\"" ) % primVar.first );
+			continue;
+		}
 
-	MeshPrimitivePtr glMesh = new MeshPrimitive( mesh->numFaces() );
+		if( primVar.second.interpolation == IECoreScene::PrimitiveVariable::Constant )
+		{
+			constantVariables.push_back( WeldVariable( primVar.first, primVar.second, 0 ) );
+			continue;
+		}
 
-	for ( IECoreScene::PrimitiveVariableMap::iterator pIt = mesh->variables.begin(); pIt != mesh->variables.end(); ++pIt )
-	{
-		if( pIt->second.data )
+		const size_t elementSize = IECore::dispatch( primVar.second.data.get(), ElementSize() );
+		if( !elementSize )
 		{
-			glMesh->addPrimitiveVariable( pIt->first, pIt->second );
+			IECore::msg( IECore::Msg::Warning, "ToGLMeshConverter", boost::format( "Primvar \"%s\" has unsupported type \"%s\"" ) % primVar.first % primVar.second.data->typeName() );
+			continue;
 		}
-		else
+
+		if( !mesh->isPrimitiveVariableValid( primVar.second ) )
 		{
-			IECore::msg( IECore::Msg::Warning, "ToGLMeshConverter", boost::format( "No data given for primvar \"%s\"" ) % pIt->first );
+			IECore::msg( IECore::Msg::Warning, "ToGLMeshConverter", boost::format( "Primvar \"%s\" is invalid" ) % primVar.first );
+			continue;
 		}
+
+		weldVariables.push_back( WeldVariable( primVar.first, primVar.second, elementSize ) );
+	}
+
+	// Triangulate and weld together identical face-vertices, so that we can draw
+	// with an index buffer rather than a fully expanded triangle list. This is
+	// cached by topology, so for a deforming mesh we only need to gather the
+	// new primitive variable values.
+
+	ConstWeldedTopologyPtr topology = topologyCache().get( TopologyCacheGetterKey( mesh.get(), weldVariables ) );
+
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	std::vector<IECore::DataPtr> weldedData( weldVariables.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, weldVariables.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const WeldVariable &v = weldVariables[i];
+				weldedData[i] = IECore::dispatch( v.primVar.data.get(), GatherWelded(), v, *topology, vertexIds );
+			}
+		},
+		taskGroupContext
+	);
+
+	MeshPrimitivePtr glMesh = new MeshPrimitive( topology->weldedIds );
+
+	for( size_t i = 0; i < weldVariables.size(); ++i )
+	{
+		glMesh->addPrimitiveVariable( weldVariables[i].name, IECoreScene::PrimitiveVariable( IECoreScene::PrimitiveVariable::Vertex, weldedData[i] ) );
+	}
+
+	for( const auto &v : constantVariables )
+	{
+		glMesh->addPrimitiveVariable( v.name, v.primVar );
 	}
 
 	return glMesh;
@@ -42,12 +42,27 @@
 
 using namespace boost::python;
 
+namespace
+{
+
+IECore::UIntVectorDataPtr vertexIds( const IECoreGL::MeshPrimitive &mesh )
+{
+	if( const IECore::UIntVectorData *ids = mesh.vertexIds() )
+	{
+		return ids->copy();
+	}
+	return nullptr;
+}
+
+} // namespace
+
 namespace IECoreGL
 {
 
 void bindMeshPrimitive()
 {
 	IECorePython::RunTimeTypedClass<MeshPrimitive>()
+		.def( "vertexIds", &vertexIds )
 	;
 }
 
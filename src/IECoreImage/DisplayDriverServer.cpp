@@ -47,9 +47,10 @@
 
 #include "boost/bind.hpp"
 
-#include "tbb/tbb_thread.h"
-
+#include <algorithm>
 #include <fcntl.h>
+#include <thread>
+#include <vector>
 #ifndef _MSC_VER
 #include <unistd.h>
 #endif
@@ -80,7 +81,16 @@ class DisplayDriverServer::Session : public RefCounted
 		void sendException( const char *message );
 
 	private:
+		// Reads the next message header, dispatching the handler via our strand.
+		void asyncReadHeader();
+
 		boost::asio::ip::tcp::socket m_socket;
+		// All handlers for this session are dispatched through the strand,
+		// so that they are never run concurrently and the messages for a
+		// single image are processed in the order in which they were sent.
+		// Handlers for different sessions may run concurrently on any of
+		// the server threads.
+		boost::asio::io_service::strand m_strand;
 		DisplayDriverPtr m_displayDriver;
 		DisplayDriverServerHeader m_header;
 		CharVectorDataPtr m_buffer;
@@ -95,14 +105,13 @@ class DisplayDriverServer::PrivateData : public RefCounted
 		boost::asio::ip::tcp::endpoint m_endpoint;
 		boost::asio::io_service m_service;
 		boost::asio::ip::tcp::acceptor m_acceptor;
-		tbb::tbb_thread m_thread;
+		std::vector<std::thread> m_threads;
 
-		PrivateData( int portNumber ) :
+		PrivateData( int portNumber, int numThreads ) :
 			m_success(false),
 			m_endpoint(tcp::v4(), portNumber),
-			m_service(),
-			m_acceptor( m_service ),
-			m_thread()
+			m_service( numThreads ),
+			m_acceptor( m_service )
 		{
 			m_acceptor.open(  m_endpoint.protocol() );
 			m_acceptor.set_option( boost::asio::ip::tcp::acceptor::reuse_address(true));
@@ -117,7 +126,10 @@ class DisplayDriverServer::PrivateData : public RefCounted
 			{
 				m_acceptor.cancel();
 				m_acceptor.close();
-				m_thread.join();
+				for( auto &thread : m_threads )
+				{
+					thread.join();
+				}
 			}
 		}
 
@@ -135,18 +147,27 @@ static void fixSocketFlags( int socketDesc )
 #endif
 }
 
-DisplayDriverServer::DisplayDriverServer( int portNumber ) :
+DisplayDriverServer::DisplayDriverServer( int portNumber, int numThreads ) :
 		m_data( nullptr )
 {
-	m_data = new DisplayDriverServer::PrivateData( portNumber );
+	if( numThreads <= 0 )
+	{
+		numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+
+	m_data = new DisplayDriverServer::PrivateData( portNumber, numThreads );
 
 	DisplayDriverServer::SessionPtr newSession( new DisplayDriverServer::Session( m_data->m_service ) );
 	m_data->m_acceptor.async_accept( newSession->socket(),
 			boost::bind( &DisplayDriverServer::handleAccept, this, newSession,
 			boost::asio::placeholders::error));
 	fixSocketFlags( m_data->m_acceptor.native_handle() );
-	tbb::tbb_thread newThread( boost::bind(&DisplayDriverServer::serverThread, this) );
-	m_data->m_thread.swap( newThread );
+
+	m_data->m_threads.reserve( numThreads );
+	for( int i = 0; i < numThreads; ++i )
+	{
+		m_data->m_threads.emplace_back( boost::bind( &DisplayDriverServer::serverThread, this ) );
+	}
 }
 
 DisplayDriverServer::~DisplayDriverServer()
@@ -159,6 +180,11 @@ int DisplayDriverServer::portNumber()
 	return m_data->m_acceptor.local_endpoint().port();
 }
 
+int DisplayDriverServer::numThreads()
+{
+	return m_data->m_threads.size();
+}
+
 void DisplayDriverServer::serverThread()
 {
 	try
@@ -188,7 +214,7 @@ void DisplayDriverServer::handleAccept( DisplayDriverServer::SessionPtr session,
  */
 
 DisplayDriverServer::Session::Session( boost::asio::io_service& io_service ) :
-	m_socket( io_service ), m_displayDriver(nullptr), m_buffer( new CharVectorData( ) )
+	m_socket( io_service ), m_strand( io_service ), m_displayDriver(nullptr), m_buffer( new CharVectorData( ) )
 {
 }
 
@@ -203,15 +229,22 @@ boost::asio::ip::tcp::socket& DisplayDriverServer::Session::socket()
 }
 
 void DisplayDriverServer::Session::start()
+{
+	asyncReadHeader();
+	fixSocketFlags( m_socket.native_handle() );
+}
+
+void DisplayDriverServer::Session::asyncReadHeader()
 {
 	boost::asio::async_read( m_socket,
 			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
-			boost::bind(
-				&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
-				boost::asio::placeholders::error
+			m_strand.wrap(
+				boost::bind(
+					&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
+					boost::asio::placeholders::error
+				)
 			)
 	);
-	fixSocketFlags( m_socket.native_handle() );
 }
 
 void DisplayDriverServer::Session::handleReadHeader( const boost::system::error_code& error )
@@ -242,15 +275,20 @@ void DisplayDriverServer::Session::handleReadHeader( const boost::system::error_
 	case DisplayDriverServerHeader::imageOpen:
 		boost::asio::async_read( m_socket,
 				boost::asio::buffer( &data[0], bytesAhead ),
-				boost::bind( &DisplayDriverServer::Session::handleReadOpenParameters, SessionPtr(this), boost::asio::placeholders::error)
+				m_strand.wrap(
+					boost::bind( &DisplayDriverServer::Session::handleReadOpenParameters, SessionPtr(this), boost::asio::placeholders::error)
+				)
 		);
 		break;
 
 	case DisplayDriverServerHeader::imageData:
 		boost::asio::async_read( m_socket,
 				boost::asio::buffer( &data[0], bytesAhead ),
-				boost::bind(&DisplayDriverServer::Session::handleReadDataParameters, SessionPtr(this),
-				boost::asio::placeholders::error));
+				m_strand.wrap(
+					boost::bind(&DisplayDriverServer::Session::handleReadDataParameters, SessionPtr(this),
+					boost::asio::placeholders::error)
+				)
+		);
 		break;
 
 	case DisplayDriverServerHeader::imageClose:
@@ -342,13 +380,7 @@ void DisplayDriverServer::Session::handleReadOpenParameters( const boost::system
 		m_socket.send( boost::asio::buffer( &acceptsRepeatedData, sizeof(acceptsRepeatedData) ) );
 
 		// prepare for getting imageData packages
-		boost::asio::async_read( m_socket,
-			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
-			boost::bind(
-				&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
-				boost::asio::placeholders::error
-			)
-		);
+		asyncReadHeader();
 	}
 	catch( std::exception &e )
 	{
@@ -389,13 +421,7 @@ void DisplayDriverServer::Session::handleReadDataParameters( const boost::system
 		m_displayDriver->imageData( box, data, dataSize );
 
 		// prepare for getting more imageData packages or a imageClose.
-		boost::asio::async_read( m_socket,
-			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
-			boost::bind(
-				&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
-				boost::asio::placeholders::error
-			)
-		);
+		asyncReadHeader();
 	}
 	catch( std::exception &e )
 	{
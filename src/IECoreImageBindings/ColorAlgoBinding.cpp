@@ -35,6 +35,7 @@
 #include "boost/python.hpp"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECoreImage/ColorAlgo.h"
 #include "IECoreImage/ImagePrimitive.h"
@@ -45,6 +46,23 @@ using namespace IECore;
 using namespace IECorePython;
 using namespace IECoreImage;
 
+namespace
+{
+
+void transformImage( ImagePrimitive *image, const std::string &inputSpace, const std::string &outputSpace )
+{
+	ScopedGILRelease gilRelease;
+	ColorAlgo::transformImage( image, inputSpace, outputSpace );
+}
+
+void transformChannel( Data *channel, const std::string &inputSpace, const std::string &outputSpace )
+{
+	ScopedGILRelease gilRelease;
+	ColorAlgo::transformChannel( channel, inputSpace, outputSpace );
+}
+
+} // namespace
+
 namespace IECoreImageBindings
 {
 
@@ -55,8 +73,8 @@ void bindColorAlgo()
 
 	scope moduleScope( module );
 
-	def( "transformImage", &ColorAlgo::transformImage, ( arg_( "image" ), arg_( "inputSpace" ), arg_( "outputSpace" ) ) );
-	def( "transformChannel", &ColorAlgo::transformChannel, ( arg_( "channel" ), arg_( "inputSpace" ), arg_( "outputSpace" ) ) );
+	def( "transformImage", &::transformImage, ( arg_( "image" ), arg_( "inputSpace" ), arg_( "outputSpace" ) ) );
+	def( "transformChannel", &::transformChannel, ( arg_( "channel" ), arg_( "inputSpace" ), arg_( "outputSpace" ) ) );
 }
 
 } // namespace IECoreImageBindings
@@ -54,8 +54,9 @@ void bindDisplayDriverServer()
 	using boost::python::arg;
 
 	RunTimeTypedClass<DisplayDriverServer>()
-		.def( init< int >( ( arg( "portNumber" ) = 0 ) ) )
+		.def( init< int, int >( ( arg( "portNumber" ) = 0, arg( "numThreads" ) = 1 ) ) )
 		.def( "portNumber", &DisplayDriverServer::portNumber )
+		.def( "numThreads", &DisplayDriverServer::numThreads )
 	;
 
 }
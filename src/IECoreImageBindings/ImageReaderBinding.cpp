@@ -36,6 +36,7 @@
 
 #include "IECore/VectorTypedData.h"
 #include "IECorePython/ReaderBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECoreImage/ImageReader.h"
 #include "IECoreImageBindings/ImageReaderBinding.h"
@@ -52,11 +53,18 @@ namespace
 
 static StringVectorDataPtr channelNames( ImageReader &that )
 {
+	ScopedGILRelease gilRelease;
 	StringVectorDataPtr result( new StringVectorData );
 	that.channelNames( result->writable() );
 	return result;
 }
 
+static DataPtr readChannel( ImageReader &that, const std::string &name, bool raw )
+{
+	ScopedGILRelease gilRelease;
+	return that.readChannel( name, raw );
+}
+
 } // namespace
 
 namespace IECoreImageBindings
@@ -73,7 +81,7 @@ void bindImageReader()
 		.def( "channelNames", &channelNames )
 		.def( "dataWindow", &ImageReader::dataWindow )
 		.def( "displayWindow", &ImageReader::displayWindow )
-		.def( "readChannel", (DataPtr (ImageReader::*)( const std::string &, bool ))&ImageReader::readChannel, ( arg_("name"), arg_( "raw" ) = false ) )
+		.def( "readChannel", &readChannel, ( arg_("name"), arg_( "raw" ) = false ) )
 	;
 
 }
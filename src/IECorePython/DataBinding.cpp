@@ -50,7 +50,16 @@ namespace IECorePython
 
 void bindData()
 {
-	RunTimeTypedClass<Data>( "An abstract base class for data storage." )
+	scope s = RunTimeTypedClass<Data>( "An abstract base class for data storage." )
+		.def( "setHashVersion", &Data::setHashVersion ).staticmethod( "setHashVersion" )
+		.def( "getHashVersion", &Data::getHashVersion ).staticmethod( "getHashVersion" )
+		.def( "setLazyLoading", &Data::setLazyLoading ).staticmethod( "setLazyLoading" )
+		.def( "getLazyLoading", &Data::getLazyLoading ).staticmethod( "getLazyLoading" )
+	;
+
+	enum_<Data::HashVersion>( "HashVersion" )
+		.value( "SerialHash", Data::SerialHash )
+		.value( "ChunkedHash", Data::ChunkedHash )
 	;
 }
 }
@@ -50,12 +50,12 @@ IECOREPYTHON_DEFINEVECTORDATASTRSPECIALISATION( Box3d )
 
 void bindImathBoxVectorTypedData()
 {
-	BIND_VECTOR_TYPEDDATA ( Box< V2i >, "Box2i")
-	BIND_VECTOR_TYPEDDATA ( Box< V2f >, "Box2f")
-	BIND_VECTOR_TYPEDDATA ( Box< V2d >, "Box2d")
-	BIND_VECTOR_TYPEDDATA ( Box< V3i >, "Box3i")
-	BIND_VECTOR_TYPEDDATA ( Box< V3f >, "Box3f")
-	BIND_VECTOR_TYPEDDATA ( Box< V3d >, "Box3d")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V2i >, "Box2i")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V2f >, "Box2f")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V2d >, "Box2d")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V3i >, "Box3i")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V3f >, "Box3f")
+	BIND_NUMERIC_VECTOR_TYPEDDATA ( Box< V3d >, "Box3d")
 }
 
 } // namespace IECorePython
@@ -40,6 +40,7 @@
 
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECore/CompoundData.h"
 #include "IECore/FileIndexedIO.h"
@@ -109,6 +110,7 @@ struct IndexedIOHelper
 
 	static IndexedIOPtr createAtRoot( const std::string &path, IndexedIO::OpenMode mode, IECore::CompoundDataPtr options )
 	{
+		IECorePython::ScopedGILRelease gilRelease;
 		return IndexedIO::create( path, IndexedIO::rootPath, mode, options.get() );
 	}
 
@@ -117,6 +119,7 @@ struct IndexedIOHelper
 		IndexedIO::EntryIDList rootPath;
 		IndexedIOHelper::listToEntryIds( root, rootPath );
 
+		IECorePython::ScopedGILRelease gilRelease;
 		return IndexedIO::create( path, rootPath, mode, options.get() );
 	}
 
@@ -170,6 +173,7 @@ struct IndexedIOHelper
 		assert(p);
 
 		const typename T::value_type *data = &(x->readable())[0];
+		IECorePython::ScopedGILRelease gilRelease;
 		p->write( name, data, (unsigned long)x->readable().size() );
 	}
 
@@ -193,69 +197,79 @@ struct IndexedIOHelper
 		return x;
 	}
 
-	static object read(IndexedIOPtr p, const IndexedIO::EntryID &name)
+	static DataPtr readData(IndexedIOPtr p, const IndexedIO::EntryID &name)
 	{
-		assert(p);
-
 		IndexedIO::Entry entry = p->entry(name);
 
 		switch( entry.dataType() )
 		{
 			case IndexedIO::Float:
-				return object( readSingle<float>(p, name, entry) );
+				return readSingle<float>(p, name, entry);
 			case IndexedIO::Double:
-				return object( readSingle<double>(p, name, entry) );
+				return readSingle<double>(p, name, entry);
 			case IndexedIO::Int:
-				return object( readSingle<int>(p, name, entry) );
+				return readSingle<int>(p, name, entry);
 			case IndexedIO::Long:
-				return object( readSingle<int>(p, name, entry) );
+				return readSingle<int>(p, name, entry);
 			case IndexedIO::String:
-				return object( readSingle<std::string>(p, name, entry) );
+				return readSingle<std::string>(p, name, entry);
 			case IndexedIO::StringArray:
-				return object( readArray<std::string>(p, name, entry) );
+				return readArray<std::string>(p, name, entry);
 			case IndexedIO::FloatArray:
-				return object( readArray<float>(p, name, entry) );
+				return readArray<float>(p, name, entry);
 			case IndexedIO::DoubleArray:
-				return object( readArray<double>(p, name, entry) );
+				return readArray<double>(p, name, entry);
 			case IndexedIO::IntArray:
-				return object( readArray<int>(p, name, entry) );
+				return readArray<int>(p, name, entry);
 			case IndexedIO::LongArray:
-				return object( readArray<int>(p, name, entry) );
+				return readArray<int>(p, name, entry);
 			case IndexedIO::UInt:
-				return object( readSingle<unsigned int>(p, name, entry) );
+				return readSingle<unsigned int>(p, name, entry);
 			case IndexedIO::UIntArray:
-				return object( readArray<unsigned int>(p, name, entry) );
+				return readArray<unsigned int>(p, name, entry);
 			case IndexedIO::Char:
-				return object( readSingle<char>(p, name, entry) );
+				return readSingle<char>(p, name, entry);
 			case IndexedIO::CharArray:
-				return object( readArray<char>(p, name, entry) );
+				return readArray<char>(p, name, entry);
 			case IndexedIO::UChar:
-				return object( readSingle<unsigned char>(p, name, entry) );
+				return readSingle<unsigned char>(p, name, entry);
 			case IndexedIO::UCharArray:
-				return object( readArray<unsigned char>(p, name, entry) );
+				return readArray<unsigned char>(p, name, entry);
 			case IndexedIO::Short:
-				return object( readSingle<short>(p, name, entry) );
+				return readSingle<short>(p, name, entry);
 			case IndexedIO::ShortArray:
-				return object( readArray<short>(p, name, entry) );
+				return readArray<short>(p, name, entry);
 			case IndexedIO::UShort:
-				return object( readSingle<unsigned short>(p, name, entry) );
+				return readSingle<unsigned short>(p, name, entry);
 			case IndexedIO::UShortArray:
-				return object( readArray<unsigned short>(p, name, entry) );
+				return readArray<unsigned short>(p, name, entry);
 			case IndexedIO::Int64:
-				return object( readSingle<int64_t>(p, name, entry) );
+				return readSingle<int64_t>(p, name, entry);
 			case IndexedIO::Int64Array:
-				return object( readArray<int64_t>(p, name, entry) );
+				return readArray<int64_t>(p, name, entry);
 			case IndexedIO::UInt64:
-				return object( readSingle<uint64_t>(p, name, entry) );
+				return readSingle<uint64_t>(p, name, entry);
 			case IndexedIO::UInt64Array:
-				return object( readArray<uint64_t>(p, name, entry) );
+				return readArray<uint64_t>(p, name, entry);
 			case IndexedIO::InternedStringArray:
-				return object( readArray<InternedString>(p, name, entry) );
+				return readArray<InternedString>(p, name, entry);
 			default:
 				throw IOException(name);
 		}
 	}
 
+	static object read(IndexedIOPtr p, const IndexedIO::EntryID &name)
+	{
+		assert(p);
+
+		DataPtr result;
+		{
+			IECorePython::ScopedGILRelease gilRelease;
+			result = readData( p, name );
+		}
+		return object( result );
+	}
+
 	static std::string readString(IndexedIOPtr p, const IndexedIO::EntryID &name)
 	{
 		assert(p);
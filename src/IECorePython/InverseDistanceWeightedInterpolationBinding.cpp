@@ -118,12 +118,7 @@ struct InverseDistanceWeightedInterpolationWrapper
 		const std::vector<typename T::Point> &p = pData->readable();
 
 		v.resize( p.size() );
-
-		typename T::NeighbourVector neighbours;
-		for( unsigned i=0; i<p.size(); i++ )
-		{
-			v[i] = (*m_idw)( p[i], neighbours );
-		}
+		(*m_idw)( p.data(), p.size(), v.data() );
 
 		return resultData;
 	}
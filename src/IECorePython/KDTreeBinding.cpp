@@ -44,6 +44,7 @@
 #include "IECore/VectorTypedData.h"
 
 #include <cassert>
+#include <cmath>
 #include <iterator>
 #include <string>
 
@@ -142,6 +143,43 @@ struct KDTreeWrapper
 
 	}
 
+	boost::python::tuple batchNearestNeighbours( const PointData *points, typename T::Point::BaseType r )
+	{
+		std::vector<size_t> offsets;
+		std::vector<typename T::Neighbour> neighbours;
+		m_tree->batchNearestNeighbours( points->readable().begin(), points->readable().end(), r, offsets, neighbours );
+		return batchResult( offsets, neighbours );
+	}
+
+	boost::python::tuple batchNearestNNeighbours( const PointData *points, unsigned int numNeighbours )
+	{
+		std::vector<size_t> offsets;
+		std::vector<typename T::Neighbour> neighbours;
+		m_tree->batchNearestNNeighbours( points->readable().begin(), points->readable().end(), numNeighbours, offsets, neighbours );
+		return batchResult( offsets, neighbours );
+	}
+
+	boost::python::tuple batchResult( const std::vector<size_t> &offsets, const std::vector<typename T::Neighbour> &neighbours )
+	{
+		typedef TypedData<std::vector<typename T::Point::BaseType> > DistanceData;
+
+		IntVectorDataPtr offsetsData = new IntVectorData( std::vector<int>( offsets.begin(), offsets.end() ) );
+		IntVectorDataPtr indicesData = new IntVectorData;
+		typename DistanceData::Ptr distancesData = new DistanceData;
+
+		std::vector<int> &indices = indicesData->writable();
+		std::vector<typename T::Point::BaseType> &distances = distancesData->writable();
+		indices.reserve( neighbours.size() );
+		distances.reserve( neighbours.size() );
+		for( typename std::vector<typename T::Neighbour>::const_iterator it = neighbours.begin(); it != neighbours.end(); ++it )
+		{
+			indices.push_back( std::distance( m_points->readable().begin(), it->point ) );
+			distances.push_back( sqrt( it->distSquared ) );
+		}
+
+		return boost::python::make_tuple( offsetsData, indicesData, distancesData );
+	}
+
 	IntVectorDataPtr enclosedPoints( const Box &bound )
 	{
 		typedef std::vector<typename T::Iterator> PointArray;
@@ -174,6 +212,8 @@ void bindKDTree(const char *bindName)
 		.def("nearestNeighbours", &KDTreeWrapper<T>::nearestNeighbours )
 		.def("nearestNNeighbours", &KDTreeWrapper<T>::nearestNNeighbours )
 		.def("enclosedPoints", &KDTreeWrapper<T>::enclosedPoints )
+		.def("batchNearestNeighbours", &KDTreeWrapper<T>::batchNearestNeighbours )
+		.def("batchNearestNNeighbours", &KDTreeWrapper<T>::batchNearestNNeighbours )
 		;
 }
 
@@ -38,6 +38,7 @@
 
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECore/MurmurHash.h"
 #include "IECore/Object.h"
@@ -69,6 +70,18 @@ void registerType( TypeId typeId, const std::string &typeName, object creator )
 	}
 }
 
+ObjectPtr load( ConstIndexedIOPtr ioInterface, const IndexedIO::EntryID &name )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return Object::load( ioInterface, name );
+}
+
+void save( const Object &object, IndexedIOPtr ioInterface, const IndexedIO::EntryID &name )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	object.save( ioInterface, name );
+}
+
 } // namespace
 
 namespace IECorePython
@@ -91,9 +104,11 @@ void bindObject()
 		.def( "create", (ObjectPtr (*)( const std::string &) )&Object::create )
 		.def( "create", (ObjectPtr (*)( TypeId ) )&Object::create )
 		.staticmethod( "create" )
-		.def( "load", (ObjectPtr (*)( ConstIndexedIOPtr, const IndexedIO::EntryID & ) )&Object::load )
+		.def( "load", &load )
 		.staticmethod( "load" )
-		.def( "save", (void (Object::*)( IndexedIOPtr, const IndexedIO::EntryID & )const )&Object::save )
+		.def( "setParallelLoading", &Object::setParallelLoading ).staticmethod( "setParallelLoading" )
+		.def( "getParallelLoading", &Object::getParallelLoading ).staticmethod( "getParallelLoading" )
+		.def( "save", &save )
 		.def( "memoryUsage", (size_t (Object::*)()const )&Object::memoryUsage, "Returns the number of bytes this instance occupies in memory" )
 		.def( "hash", (MurmurHash (Object::*)() const)&Object::hash )
 		.def( "hash", (void (Object::*)( MurmurHash & ) const)&Object::hash )
@@ -41,14 +41,20 @@
 
 #include "IECorePython/RunTimeTypedBinding.h"
 
+#include "IECore/MemoryIndexedIO.h"
 #include "IECore/PathMatcher.h"
 #include "IECore/PathMatcherData.h"
+#include "IECore/StringAlgo.h"
 #include "IECore/VectorTypedData.h"
 
 #include "boost/format.hpp"
 #include "boost/python/suite/indexing/container_utils.hpp"
 #include "boost/tokenizer.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
 using namespace std;
 using namespace boost::python;
 using namespace IECore;
@@ -176,6 +182,44 @@ void testPathMatcherFind()
 
 }
 
+void testPathMatcherDataLoadVersion0()
+{
+	const std::vector<std::string> paths = { "/", "/a", "/a/b/c", "/a/b/d", "/a/*/e", "/f/.../g" };
+	const PathMatcher m( paths.begin(), paths.end() );
+
+	// Write the file by hand, using the original encoding, since
+	// PathMatcherData::save() now uses a newer one.
+
+	MemoryIndexedIOPtr io = new MemoryIndexedIO( new CharVectorData, IndexedIO::EntryIDList(), IndexedIO::Write );
+	IndexedIOPtr objectIO = io->createSubdirectory( "d" );
+	objectIO->write( "type", std::string( "PathMatcherData" ) );
+	IndexedIOPtr typeIO = objectIO->createSubdirectory( "data" )->createSubdirectory( "PathMatcherData" );
+	typeIO->write( "ioVersion", 0u );
+	IndexedIOPtr dataIO = typeIO->createSubdirectory( "data" );
+
+	std::vector<InternedString> strings;
+	std::vector<unsigned int> pathLengths;
+	std::vector<unsigned char> exactMatches;
+	for( PathMatcher::RawIterator it = m.begin(), eIt = m.end(); it != eIt; ++it )
+	{
+		pathLengths.push_back( it->size() );
+		if( it->size() )
+		{
+			strings.push_back( it->back() );
+		}
+		exactMatches.push_back( it.exactMatch() );
+	}
+
+	dataIO->write( "strings", strings.data(), strings.size() );
+	dataIO->write( "pathLengths", pathLengths.data(), pathLengths.size() );
+	dataIO->write( "exactMatches", exactMatches.data(), exactMatches.size() );
+
+	io = new MemoryIndexedIO( io->buffer(), IndexedIO::EntryIDList(), IndexedIO::Read );
+	ConstPathMatcherDataPtr d = runTimeCast<const PathMatcherData>( Object::load( io, "d" ) );
+	IECORETEST_ASSERT( d );
+	IECORETEST_ASSERT( d->readable() == m );
+}
+
 // PathMatcher paths are just std::vector<InternedString>,
 // which doesn't exist in Python. So we register a conversion from
 // InternedStringVectorData which contains just such a vector.
@@ -290,7 +334,37 @@ PathMatcher *constructFromObject( boost::python::object oPaths )
 
 PathMatcher *constructFromVectorData( IECore::ConstStringVectorDataPtr paths )
 {
-	return new PathMatcher( paths->readable().begin(), paths->readable().end() );
+	// Tokenize and sort the paths in parallel, so that we can use
+	// the fast bulk constructor. Empty strings are ignored, to match
+	// the behaviour of `PathMatcher::addPath( const std::string & )`.
+
+	std::vector<const std::string *> strings;
+	strings.reserve( paths->readable().size() );
+	for( const auto &path : paths->readable() )
+	{
+		if( !path.empty() )
+		{
+			strings.push_back( &path );
+		}
+	}
+
+	std::vector<std::vector<InternedString>> tokenizedPaths( strings.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, strings.size() ),
+		[&strings, &tokenizedPaths]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				StringAlgo::tokenize( *strings[i], '/', tokenizedPaths[i] );
+			}
+		},
+		taskGroupContext
+	);
+
+	tbb::parallel_sort( tokenizedPaths.begin(), tokenizedPaths.end() );
+
+	return new PathMatcher( tokenizedPaths );
 }
 
 boost::python::list paths( const PathMatcher &p )
@@ -329,6 +403,7 @@ void IECorePython::bindPathMatcher()
 	def( "testPathMatcherRawIterator", &testPathMatcherRawIterator );
 	def( "testPathMatcherIteratorPrune", &testPathMatcherIteratorPrune );
 	def( "testPathMatcherFind", &testPathMatcherFind );
+	def( "testPathMatcherDataLoadVersion0", &testPathMatcherDataLoadVersion0 );
 
 	IECorePython::RunTimeTypedClass<PathMatcherData>()
 		.def( init<>() )
@@ -356,6 +431,7 @@ void IECorePython::bindPathMatcher()
 		.def( "subTree", (PathMatcher ( PathMatcher::*)( const std::vector<IECore::InternedString> & ) const)&PathMatcher::subTree )
 		.def( "subTree", (PathMatcher ( PathMatcher::*)( const std::string & ) const)&PathMatcher::subTree )
 		.def( "clear", &PathMatcher::clear )
+		.def( "compact", &PathMatcher::compact )
 		.def( "isEmpty", &PathMatcher::isEmpty )
 		.def( "size", &PathMatcher::size )
 		.def( "paths", &paths )
@@ -47,6 +47,8 @@
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/VectorTypedDataBinding.inl"
 
+#include "IECore/ByteOrder.h"
+#include "IECore/Exception.h"
 #include "IECore/Export.h"
 #include "IECore/VectorTypedData.h"
 
@@ -124,8 +126,228 @@ std::string str<BoolVectorData>( BoolVectorData &x )
 	return s.str();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Buffer protocol support
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const int g_maxBufferDimensions = 4;
+
+// A minimal Python type which exposes the contents of a VectorTypedData
+// via the buffer protocol, holding a reference to a copy of the data so
+// that the memory remains valid for the lifetime of the buffer.
+struct DataBuffer
+{
+	PyObject_HEAD
+	const Data *data;
+	void *address;
+	bool readOnly;
+	const char *format;
+	Py_ssize_t itemSize;
+	int ndim;
+	Py_ssize_t shape[g_maxBufferDimensions];
+	Py_ssize_t strides[g_maxBufferDimensions];
+	Py_ssize_t length;
+};
+
+int dataBufferGetBuffer( PyObject *self, Py_buffer *view, int flags )
+{
+	DataBuffer *buffer = reinterpret_cast<DataBuffer *>( self );
+	if( ( flags & PyBUF_WRITABLE ) && buffer->readOnly )
+	{
+		PyErr_SetString( PyExc_BufferError, "Buffer is read-only" );
+		view->obj = nullptr;
+		return -1;
+	}
+
+	view->buf = buffer->address;
+	view->obj = self;
+	Py_INCREF( self );
+	view->len = buffer->length;
+	view->readonly = buffer->readOnly;
+	if( ( flags & PyBUF_ND ) == PyBUF_ND )
+	{
+		view->itemsize = buffer->itemSize;
+		view->format = ( flags & PyBUF_FORMAT ) ? const_cast<char *>( buffer->format ) : nullptr;
+		view->ndim = buffer->ndim;
+		view->shape = buffer->shape;
+		view->strides = ( flags & PyBUF_STRIDES ) == PyBUF_STRIDES ? buffer->strides : nullptr;
+	}
+	else
+	{
+		// Without a shape, consumers treat the buffer as
+		// a flat array of bytes, as for `PyBuffer_FillInfo()`.
+		view->itemsize = 1;
+		view->format = ( flags & PyBUF_FORMAT ) ? const_cast<char *>( "B" ) : nullptr;
+		view->ndim = 1;
+		view->shape = nullptr;
+		view->strides = nullptr;
+	}
+	view->suboffsets = nullptr;
+	view->internal = nullptr;
+	return 0;
+}
+
+void dataBufferDealloc( PyObject *self )
+{
+	DataBuffer *buffer = reinterpret_cast<DataBuffer *>( self );
+	buffer->data->removeRef();
+	Py_TYPE( self )->tp_free( self );
+}
+
+PyBufferProcs g_dataBufferProcs = {
+#if PY_MAJOR_VERSION < 3
+	nullptr, nullptr, nullptr, nullptr,
+#endif
+	dataBufferGetBuffer,
+	nullptr
+};
+
+PyTypeObject g_dataBufferType = {
+	PyVarObject_HEAD_INIT( nullptr, 0 )
+	"IECore.DataBuffer"
+};
+
+void initDataBufferType()
+{
+	g_dataBufferType.tp_basicsize = sizeof( DataBuffer );
+	g_dataBufferType.tp_dealloc = dataBufferDealloc;
+	g_dataBufferType.tp_as_buffer = &g_dataBufferProcs;
+	g_dataBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+#if PY_MAJOR_VERSION < 3
+	g_dataBufferType.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+	g_dataBufferType.tp_doc = "Provides access to the contents of a VectorTypedData via the buffer protocol.";
+	if( PyType_Ready( &g_dataBufferType ) < 0 )
+	{
+		throw_error_already_set();
+	}
+}
+
+enum BufferKind
+{
+	Invalid,
+	Signed,
+	Unsigned,
+	Floating
+};
+
+BufferKind bufferKind( const char *format )
+{
+	if( !format )
+	{
+		// Absence of a format implies unsigned bytes.
+		return Unsigned;
+	}
+
+	// Skip byte order and alignment specifiers - we
+	// only accept native byte order.
+	switch( *format )
+	{
+		case '@' :
+		case '=' :
+			format++;
+			break;
+		case '<' :
+		case '>' :
+		case '!' :
+			{
+				const char native = littleEndian() ? '<' : '>';
+				if( *format != native && !( *format == '!' && native == '>' ) )
+				{
+					return Invalid;
+				}
+				format++;
+			}
+			break;
+		default :
+			break;
+	}
+
+	if( !*format || format[1] )
+	{
+		// Structured or multi-character formats aren't supported
+		return Invalid;
+	}
+
+	switch( *format )
+	{
+		case 'b' :
+		case 'h' :
+		case 'i' :
+		case 'l' :
+		case 'q' :
+		case 'n' :
+			return Signed;
+		case 'B' :
+		case 'H' :
+		case 'I' :
+		case 'L' :
+		case 'Q' :
+		case 'N' :
+		case 'c' :
+			return Unsigned;
+		case 'e' :
+		case 'f' :
+		case 'd' :
+			return Floating;
+		default :
+			return Invalid;
+	}
+}
+
+} // namespace
+
+namespace Detail
+{
+
+PyObject *dataBuffer( const IECore::Data *data, const void *address, const std::vector<Py_ssize_t> &shape, const char *format, size_t itemSize, bool readOnly )
+{
+	if( shape.size() > (size_t)g_maxBufferDimensions )
+	{
+		throw IECore::Exception( "Too many dimensions for buffer" );
+	}
+
+	DataBuffer *result = PyObject_New( DataBuffer, &g_dataBufferType );
+	if( !result )
+	{
+		throw_error_already_set();
+	}
+
+	data->addRef();
+	result->data = data;
+	result->address = const_cast<void *>( address );
+	result->readOnly = readOnly;
+	result->format = format;
+	result->itemSize = itemSize;
+	result->ndim = shape.size();
+
+	Py_ssize_t stride = itemSize;
+	for( int i = result->ndim - 1; i >= 0; --i )
+	{
+		result->shape[i] = shape[i];
+		result->strides[i] = stride;
+		stride *= shape[i];
+	}
+	result->length = stride;
+
+	return reinterpret_cast<PyObject *>( result );
+}
+
+bool bufferFormatsMatch( const char *format, size_t itemSize, const char *requiredFormat, size_t requiredItemSize )
+{
+	const BufferKind kind = bufferKind( format );
+	return kind != Invalid && kind == bufferKind( requiredFormat ) && itemSize == requiredItemSize;
+}
+
+} // namespace Detail
+
 void bindAllVectorTypedData()
 {
+	initDataBufferType();
+
 	// basic types
 	BIND_VECTOR_TYPEDDATA(
 		bool,
@@ -40,6 +40,7 @@
 #include "IECoreScene/TypedObjectParameter.h"
 
 #include "IECore/CompoundParameter.h"
+#include "IECore/DeferredMessageHandler.h"
 #include "IECore/DespatchTypedData.h"
 #include "IECore/Interpolator.h"
 #include "IECore/Math.h"
@@ -51,6 +52,8 @@
 
 #include "OpenEXR/ImathFrame.h"
 
+#include "tbb/tbb.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -452,7 +455,10 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 	resampledPoints.reserve( vPoints );
 
 	V3fVectorData::ValueType resampledTangents;
-	resampledPoints.reserve( vPoints );
+	resampledTangents.reserve( vPoints );
+
+	const size_t numSegments = curves->numSegments( curveIndex );
+	const size_t numVertices = curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
 
 	/// \todo Make adaptive
 	for ( unsigned v = 0; v < vPoints; v ++)
@@ -463,23 +469,23 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 		/// Make sure we don't fall off the end of the curve
 		if ( v == vPoints - 1 )
 		{
-			iSeg = curves->numSegments( curveIndex ) - 1;
+			iSeg = numSegments - 1;
 			fSeg = 1.0f - std::numeric_limits<float>::epsilon();
 		}
 		else
 		{
 			float curveParam = float(v) / ( vPoints - 1 );
-			fSeg = curveParam * curves->numSegments( curveIndex );
+			fSeg = curveParam * numSegments;
 			iSeg = (size_t)floor( fSeg );
 			fSeg = fSeg - iSeg;
 		}
 
 		size_t segmentStart = iSeg;
 
-		size_t i0 = std::min( segmentStart + 0, curves->variableSize( PrimitiveVariable::Vertex, curveIndex ) );
-		size_t i1 = std::min( segmentStart + 1, curves->variableSize( PrimitiveVariable::Vertex, curveIndex ) );
-		size_t i2 = std::min( segmentStart + 2, curves->variableSize( PrimitiveVariable::Vertex, curveIndex ) );
-		size_t i3 = std::min( segmentStart + 3, curves->variableSize( PrimitiveVariable::Vertex, curveIndex ) );
+		size_t i0 = std::min( segmentStart + 0, numVertices );
+		size_t i1 = std::min( segmentStart + 1, numVertices );
+		size_t i2 = std::min( segmentStart + 2, numVertices );
+		size_t i3 = std::min( segmentStart + 3, numVertices );
 
 		const Imath::V3f &p0 = p[ vertexOffset + i0 ];
 		const Imath::V3f &p1 = p[ vertexOffset + i1  ];
@@ -566,25 +572,50 @@ ObjectPtr CurveExtrudeOp::doOperation( const CompoundObject * operands )
 	assert( curves );
 	assert( curves->arePrimitiveVariablesValid() );
 
-	GroupPtr group = new Group();
-
 	const IntVectorData * verticesPerCurve = curves->verticesPerCurve();
 	assert( verticesPerCurve );
 
-	unsigned numCurves = verticesPerCurve->readable().size();
+	const unsigned numCurves = verticesPerCurve->readable().size();
+
+	std::vector<unsigned> vertexOffsets( numCurves );
+	std::vector<unsigned> varyingOffsets( numCurves );
 	unsigned vertexOffset = 0;
 	unsigned varyingOffset = 0;
 	for ( unsigned curveIndex = 0; curveIndex < numCurves; curveIndex++ )
 	{
-		int numVertices = curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
+		vertexOffsets[curveIndex] = vertexOffset;
+		varyingOffsets[curveIndex] = varyingOffset;
+		vertexOffset += curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
+		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	}
 
-		PatchMeshPrimitivePtr patchMesh = buildPatchMesh( curves, curveIndex, vertexOffset, varyingOffset );
-		assert( patchMesh );
+	// Each patch mesh depends only on its own curve, so we can build
+	// them all in parallel, before adding them to the group in order.
+	// Any warnings are collected and output on this thread afterwards,
+	// so that they reach the caller's message handler.
+	std::vector<PatchMeshPrimitivePtr> patchMeshes( numCurves );
+	DeferredMessageHandlerPtr messageHandler = new DeferredMessageHandler;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<unsigned>( 0, numCurves ),
+		[this, curves, &vertexOffsets, &varyingOffsets, &patchMeshes, &messageHandler]( const tbb::blocked_range<unsigned> &range )
+		{
+			MessageHandler::Scope messageScope( messageHandler.get() );
+			for ( unsigned curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+			{
+				patchMeshes[curveIndex] = buildPatchMesh( curves, curveIndex, vertexOffsets[curveIndex], varyingOffsets[curveIndex] );
+				assert( patchMeshes[curveIndex] );
+			}
+		},
+		taskGroupContext
+	);
 
-		group->addChild( patchMesh );
+	messageHandler->flush();
 
-		vertexOffset += numVertices;
-		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	GroupPtr group = new Group();
+	for ( const auto &patchMesh : patchMeshes )
+	{
+		group->addChild( patchMesh );
 	}
 
 	assert( group->children().size() == numCurves );
@@ -34,7 +34,7 @@
 
 #include "IECoreScene/CurveLineariser.h"
 
-#include "IECoreScene/CurvesPrimitiveEvaluator.h"
+#include "IECoreScene/private/CurveSample.h"
 
 #include "IECore/CompoundParameter.h"
 #include "IECore/FastFloat.h"
@@ -42,6 +42,8 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/tbb.h"
+
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Imath;
@@ -76,6 +78,125 @@ const FloatParameter * CurveLineariser::verticesPerSegmentParameter() const
 	return parameters()->parameter<FloatParameter>( "verticesPerSegment" );
 }
 
+namespace
+{
+
+// An interpolated primitive variable to be resampled, along with the
+// new data being generated for it.
+struct Variable
+{
+	const PrimitiveVariable *input;
+	IECore::TypeId typeId;
+	DataPtr outputData;
+	void *output;
+};
+
+template<typename DataType>
+void addVariable( const PrimitiveVariable &primVar, size_t size, std::vector<Variable> &variables )
+{
+	typename DataType::Ptr outputData = new DataType;
+	outputData->writable().resize( size );
+
+	Variable v;
+	v.input = &primVar;
+	v.typeId = DataType::staticTypeId();
+	v.outputData = outputData;
+	v.output = outputData->baseWritable();
+	variables.push_back( v );
+}
+
+template<typename T>
+void resampleVariable( const Variable &variable, const std::vector<IECoreScene::Detail::CurveSample> &samples, size_t outputOffset )
+{
+	const PrimitiveVariable::IndexedView<T> input( *variable.input );
+	T *output = static_cast<T *>( variable.output ) + outputOffset;
+	if( variable.input->interpolation == PrimitiveVariable::Vertex )
+	{
+		for( const auto &sample : samples )
+		{
+			*output++ = sample.vertexValue<false, T>( input, sample.coefficients );
+		}
+	}
+	else
+	{
+		for( const auto &sample : samples )
+		{
+			*output++ = sample.varyingValue<T>( input );
+		}
+	}
+}
+
+template<bool periodic>
+void lineariseCurves(
+	const CurvesPrimitive *curves, const std::vector<int> &newVerticesPerCurve,
+	const std::vector<size_t> &newVertexOffsets, const std::vector<Variable> &variables
+)
+{
+	const std::vector<int> &verticesPerCurve = curves->verticesPerCurve()->readable();
+	const CubicBasisf &basis = curves->basis();
+
+	std::vector<unsigned> vertexOffsets( verticesPerCurve.size() );
+	std::vector<unsigned> varyingOffsets( verticesPerCurve.size() );
+	unsigned vertexOffset = 0;
+	unsigned varyingOffset = 0;
+	for( size_t curveIndex = 0; curveIndex < verticesPerCurve.size(); ++curveIndex )
+	{
+		vertexOffsets[curveIndex] = vertexOffset;
+		varyingOffsets[curveIndex] = varyingOffset;
+		vertexOffset += verticesPerCurve[curveIndex];
+		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	}
+
+	// Each curve writes to its own range of the preallocated output, so
+	// curves can be processed in parallel. Within a curve we compute the
+	// basis coefficients once for each new vertex, and then apply them to
+	// each variable in turn.
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, verticesPerCurve.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			std::vector<IECoreScene::Detail::CurveSample> samples;
+			for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+			{
+				const int numVertices = newVerticesPerCurve[curveIndex];
+				samples.resize( numVertices );
+
+				const float vStep = periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
+				for( int i = 0; i < numVertices; i++ )
+				{
+					const float v = std::min( vStep * i, 1.0f );
+					samples[i].init<false, periodic>( basis, verticesPerCurve[curveIndex], vertexOffsets[curveIndex], varyingOffsets[curveIndex], v );
+				}
+
+				for( const auto &variable : variables )
+				{
+					switch( variable.typeId )
+					{
+						case V3fVectorDataTypeId :
+							resampleVariable<V3f>( variable, samples, newVertexOffsets[curveIndex] );
+							break;
+						case FloatVectorDataTypeId :
+							resampleVariable<float>( variable, samples, newVertexOffsets[curveIndex] );
+							break;
+						case IntVectorDataTypeId :
+							resampleVariable<int>( variable, samples, newVertexOffsets[curveIndex] );
+							break;
+						case Color3fVectorDataTypeId :
+							resampleVariable<Color3f>( variable, samples, newVertexOffsets[curveIndex] );
+							break;
+						default :
+							assert( 0 ); // shouldn't get here
+					}
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
+} // namespace
+
 void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const CompoundObject * operands )
 {
 	if( curves->basis()==CubicBasisf::linear() )
@@ -83,12 +204,32 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 		return;
 	}
 
-	CurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( curves );
-	PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
+	// Compute the new topology up front, so that we know where each
+	// curve's vertices will live in the output.
+
+	const size_t numCurves = curves->numCurves();
+	const bool periodic = curves->periodic();
+	const float verticesPerSegment = operands->member<FloatData>( "verticesPerSegment" )->readable();
+
+	IntVectorDataPtr newVerticesPerCurveData = new IntVectorData();
+	std::vector<int> &newVerticesPerCurve = newVerticesPerCurveData->writable();
+	newVerticesPerCurve.resize( numCurves );
+
+	std::vector<size_t> newVertexOffsets( numCurves );
+	size_t numNewVertices = 0;
+	for( size_t curveIndex=0; curveIndex<numCurves; curveIndex++ )
+	{
+		int numVertices = fastFloatFloor( verticesPerSegment * (float)curves->numSegments( curveIndex ) );
+		newVerticesPerCurve[curveIndex] = std::max( numVertices, periodic ? 3 : 2 );
+		newVertexOffsets[curveIndex] = numNewVertices;
+		numNewVertices += newVerticesPerCurve[curveIndex];
+	}
+
+	// Allocate the output data for each variable we support.
 
-	std::vector<PrimitiveVariable> primitiveVariables;
-	std::vector<IECore::TypeId> primitiveVariableTypes;
-	std::vector<void *> primitiveVariableVectors;
+	std::vector<Variable> variables;
+	std::vector<PrimitiveVariable *> variablesToUpdate;
+	variables.reserve( curves->variables.size() );
 	for( PrimitiveVariableMap::iterator it=curves->variables.begin(); it!=curves->variables.end(); it++ )
 	{
 		switch( it->second.interpolation )
@@ -106,92 +247,45 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 		switch( it->second.data->typeId() )
 		{
 			case V3fVectorDataTypeId :
-			{
-				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
-				primitiveVariableTypes.push_back( V3fVectorDataTypeId );
-				std::vector<V3f> &v = static_cast<V3fVectorData *>( it->second.data.get() )->writable();
-				v.clear();
-				primitiveVariableVectors.push_back( &v );
+				addVariable<V3fVectorData>( it->second, numNewVertices, variables );
+				// Preserve the geometric interpretation of points, normals etc.
+				static_cast<V3fVectorData *>( variables.back().outputData.get() )->setInterpretation(
+					static_cast<const V3fVectorData *>( it->second.data.get() )->getInterpretation()
+				);
 				break;
-			}
 			case FloatVectorDataTypeId :
-			{
-				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
-				primitiveVariableTypes.push_back( FloatVectorDataTypeId );
-				std::vector<float> &v = static_cast<FloatVectorData *>( it->second.data.get() )->writable();
-				v.clear();
-				primitiveVariableVectors.push_back( &v );
+				addVariable<FloatVectorData>( it->second, numNewVertices, variables );
 				break;
-			}
 			case IntVectorDataTypeId :
-			{
-				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
-				primitiveVariableTypes.push_back( IntVectorDataTypeId );
-				std::vector<int> &v = static_cast<IntVectorData *>( it->second.data.get() )->writable();
-				v.clear();
-				primitiveVariableVectors.push_back( &v );
+				addVariable<IntVectorData>( it->second, numNewVertices, variables );
 				break;
-			}
 			case Color3fVectorDataTypeId :
-			{
-				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
-				primitiveVariableTypes.push_back( Color3fVectorDataTypeId );
-				std::vector<Color3f> &v = static_cast<Color3fVectorData *>( it->second.data.get() )->writable();
-				v.clear();
-				primitiveVariableVectors.push_back( &v );
+				addVariable<Color3fVectorData>( it->second, numNewVertices, variables );
 				break;
-			}
 			default :
 				msg(
 					Msg::Warning,
 					"CurveLineariser::modifyTypedPrimitive",
 					boost::format( "Ignoring primitive variable \"%s\" with unsupported type \"%s\"" ) % it->first % it->second.data->typeName()
 				);
+				continue;
 		}
+		variablesToUpdate.push_back( &it->second );
 	}
 
-	size_t numCurves = curves->numCurves();
-	bool periodic = curves->periodic();
-
-	IntVectorDataPtr newVerticesPerCurveData = new IntVectorData();
-	std::vector<int> &newVerticesPerCurve = newVerticesPerCurveData->writable();
-	newVerticesPerCurve.resize( numCurves );
-
-	float verticesPerSegment = operands->member<FloatData>( "verticesPerSegment" )->readable();
-
-	for( size_t curveIndex=0; curveIndex<numCurves; curveIndex++ )
+	if( periodic )
 	{
-		int numVertices = fastFloatFloor( verticesPerSegment * (float)curves->numSegments( curveIndex ) );
-		numVertices = std::max( numVertices, periodic ? 3 : 2 );
-
-		float vStep = periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
-		for( int i=0; i<numVertices; i++ )
-		{
-			float v = std::min( vStep * i, 1.0f );
-			evaluator->pointAtV( curveIndex, v, evaluatorResult.get() );
-			for( size_t j=0; j<primitiveVariables.size(); j++ )
-			{
-				switch( primitiveVariableTypes[j] )
-				{
-					case V3fVectorDataTypeId :
-						static_cast<std::vector<V3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->vectorPrimVar( primitiveVariables[j] ) );
-						break;
-					case FloatVectorDataTypeId :
-						static_cast<std::vector<float> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->floatPrimVar( primitiveVariables[j] ) );
-						break;
-					case IntVectorDataTypeId :
-						static_cast<std::vector<int> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->intPrimVar( primitiveVariables[j] ) );
-						break;
-					case Color3fVectorDataTypeId :
-						static_cast<std::vector<Color3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->colorPrimVar( primitiveVariables[j] ) );
-						break;
-					default :
-						assert( 0 ); // shouldn't get here
-				}
-			}
-		}
+		lineariseCurves<true>( curves, newVerticesPerCurve, newVertexOffsets, variables );
+	}
+	else
+	{
+		lineariseCurves<false>( curves, newVerticesPerCurve, newVertexOffsets, variables );
+	}
 
-		newVerticesPerCurve[curveIndex] = numVertices;
+	for( size_t i = 0; i < variables.size(); ++i )
+	{
+		variablesToUpdate[i]->data = variables[i].outputData;
+		variablesToUpdate[i]->indices = nullptr;
 	}
 
 	curves->setTopology( newVerticesPerCurveData, CubicBasisf::linear(), periodic );
@@ -34,7 +34,7 @@
 
 #include "IECoreScene/CurveTangentsOp.h"
 
-#include "IECoreScene/CurvesPrimitiveEvaluator.h"
+#include "IECoreScene/private/CurveSample.h"
 
 #include "IECore/CompoundParameter.h"
 #include "IECore/Convert.h"
@@ -43,8 +43,11 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/tbb.h"
+
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -80,42 +83,29 @@ struct CurveTangentsOp::CalculateTangents
 {
 	typedef void ReturnType;
 
-	CalculateTangents( const vector<int> &vertsPerCurve, CurvesPrimitiveEvaluatorPtr evaluator )
-		:	m_vertsPerCurve( vertsPerCurve ), m_evaluator( evaluator )
+	CalculateTangents( const vector<int> &vertsPerCurve, const CubicBasisf &basis, bool periodic )
+		:	m_vertsPerCurve( vertsPerCurve ), m_basis( basis ), m_periodic( periodic )
 	{
-
+		m_vertexOffsets.reserve( m_vertsPerCurve.size() );
+		int offset = 0;
+		for( vector<int>::const_iterator it = m_vertsPerCurve.begin(), eIt = m_vertsPerCurve.end(); it != eIt; ++it )
+		{
+			m_vertexOffsets.push_back( offset );
+			offset += *it;
+		}
 	}
 
 	template<typename T>
 	ReturnType operator()( T * data )
 	{
-		typedef typename T::ValueType VecContainer;
-
-		const VecContainer &points = data->readable();
-
-		unsigned numElements = points.size();
-
-		typename T::Ptr vD = new T();
-		vTangentsData = vD;
-
-		VecContainer &vTangents = vD->writable();
-		vTangents.resize( numElements );
-
-		PrimitiveEvaluator::ResultPtr result = m_evaluator->createResult();
-
-		unsigned pIndex = 0;
-		for( size_t curveIndex = 0; curveIndex < m_vertsPerCurve.size() ; curveIndex++ )
+		const bool linear = m_basis == CubicBasisf::linear();
+		if( linear )
+		{
+			m_periodic ? calculate<T, true, true>( data ) : calculate<T, true, false>( data );
+		}
+		else
 		{
-			float v;
-			float vStep = 1.0f / m_vertsPerCurve[curveIndex];
-
-			for( int i = 0; i < m_vertsPerCurve[curveIndex]; i++ )
-			{
-				v = min( 1.0f, i * vStep );
-				m_evaluator->pointAtV( curveIndex, v, result.get() );
-				vTangents[ pIndex + i ] = result->vTangent().normalized();
-			}
-			pIndex += m_vertsPerCurve[curveIndex];
+			m_periodic ? calculate<T, false, true>( data ) : calculate<T, false, false>( data );
 		}
 	}
 
@@ -124,8 +114,57 @@ struct CurveTangentsOp::CalculateTangents
 
 	private :
 
+		template<typename T, bool linear, bool periodic>
+		void calculate( T * data )
+		{
+			typedef typename T::ValueType VecContainer;
+			typedef typename VecContainer::value_type Vec;
+			// Integer vectors are accumulated as floats.
+			typedef typename std::conditional<std::is_integral<typename Vec::BaseType>::value, float, typename Vec::BaseType>::type RealType;
+			typedef Imath::Vec3<RealType> RealVec;
+
+			const VecContainer &points = data->readable();
+
+			typename T::Ptr vD = new T();
+			vTangentsData = vD;
+
+			VecContainer &vTangents = vD->writable();
+			vTangents.resize( points.size() );
+
+			// Each curve writes only to its own range of vertices, so we
+			// can process them all in parallel, evaluating the basis
+			// directly rather than going via a CurvesPrimitiveEvaluator.
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, m_vertsPerCurve.size() ),
+				[this, &points, &vTangents]( const tbb::blocked_range<size_t> &range )
+				{
+					Detail::CurveSample sample;
+					for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+					{
+						const int numVertices = m_vertsPerCurve[curveIndex];
+						const int offset = m_vertexOffsets[curveIndex];
+						const float vStep = 1.0f / numVertices;
+						for( int i = 0; i < numVertices; i++ )
+						{
+							sample.init<linear, periodic>( m_basis, numVertices, offset, 0, min( 1.0f, i * vStep ) );
+							RealVec tangent( 0 );
+							for( int c = 0; c < ( linear ? 2 : 4 ); ++c )
+							{
+								tangent += RealVec( points[sample.vertexDataIndices[c]] ) * (RealType)sample.derivativeCoefficients[c];
+							}
+							vTangents[offset + i] = Vec( tangent.normalized() );
+						}
+					}
+				},
+				taskGroupContext
+			);
+		}
+
 		const vector<int> &m_vertsPerCurve;
-		CurvesPrimitiveEvaluatorPtr m_evaluator;
+		const CubicBasisf &m_basis;
+		bool m_periodic;
+		vector<int> m_vertexOffsets;
 
 };
 
@@ -158,9 +197,7 @@ void CurveTangentsOp::modifyTypedPrimitive( CurvesPrimitive *curves, const Compo
 	DataCastOpPtr dco = new DataCastOp();
 	dco->targetTypeParameter()->setNumericValue( FloatVectorDataTypeId );
 
-	CurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( curves );
-
-	CalculateTangents f( vertsPerCurve->readable(), evaluator );
+	CalculateTangents f( vertsPerCurve->readable(), curves->basis(), curves->periodic() );
 
 	despatchTypedData<CalculateTangents, TypeTraits::IsVec3VectorTypedData, HandleErrors>( pData, f );
 
@@ -35,6 +35,7 @@
 #include "IECoreScene/CurvesPrimitiveEvaluator.h"
 
 #include "IECoreScene/CurvesPrimitive.h"
+#include "IECoreScene/private/CurveSample.h"
 
 #include "IECore/Exception.h"
 #include "IECore/FastFloat.h"
@@ -44,6 +45,10 @@
 
 #include "OpenEXR/ImathFun.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Imath;
@@ -222,82 +227,20 @@ void CurvesPrimitiveEvaluator::Result::init( unsigned curveIndex, float v, const
 	m_curveIndex = curveIndex;
 	m_v = v;
 
-	int numVertices = evaluator->m_verticesPerCurve[curveIndex];
-	const CubicBasisf &basis = evaluator->m_curvesPrimitive->basis();
-
-	unsigned numSegments = 0;
-	if( linear )
-	{
-		if( periodic )
-		{
-			numSegments = numVertices;
-		}
-		else
-		{
-			numSegments = numVertices - 1;
-		}
-	}
-	else
-	{
-		if( periodic )
-		{
-			numSegments = numVertices / basis.step;
-		}
-		else
-		{
-			numSegments = (numVertices - 4 ) / basis.step + 1;
-		}
-	}
-
-	float vv = v * numSegments;
-	unsigned segment = min( (unsigned)fastFloatFloor( vv ), numSegments - 1 );
-	m_segmentV = vv - segment;
-
-	unsigned o = evaluator->m_vertexDataOffsets[m_curveIndex];
-	unsigned i = segment * basis.step;
+	Detail::CurveSample sample;
+	sample.init<linear, periodic>(
+		evaluator->m_curvesPrimitive->basis(),
+		evaluator->m_verticesPerCurve[curveIndex],
+		evaluator->m_vertexDataOffsets[curveIndex],
+		evaluator->m_varyingDataOffsets[curveIndex],
+		v
+	);
 
-	if( linear )
-	{
-		m_coefficients[0] = 1.0f - m_segmentV;
-		m_coefficients[1] = m_segmentV;
-		m_derivativeCoefficients[0] = 1.0f;
-		m_derivativeCoefficients[1] = -1.0f;
-		m_vertexDataIndices[0] = m_varyingDataIndices[0] = o + i;
-		if( periodic )
-		{
-			m_vertexDataIndices[1] = m_varyingDataIndices[1] = o + ( ( i + 1 ) % numVertices );
-		}
-		else
-		{
-			m_vertexDataIndices[1] = m_varyingDataIndices[1] = m_vertexDataIndices[0] + 1;
-		}
-	}
-	else
-	{
-		basis.coefficients( m_segmentV, m_coefficients );
-		basis.derivativeCoefficients( m_segmentV, m_derivativeCoefficients );
-
-		if( periodic )
-		{
-			m_vertexDataIndices[0] = o + i;
-			m_vertexDataIndices[1] = o + ( ( i + 1 ) % numVertices );
-			m_vertexDataIndices[2] = o + ( ( i + 2 ) % numVertices );
-			m_vertexDataIndices[3] = o + ( ( i + 3 ) % numVertices );
-
-			m_varyingDataIndices[0] = evaluator->m_varyingDataOffsets[m_curveIndex] + segment;
-			m_varyingDataIndices[1] = evaluator->m_varyingDataOffsets[m_curveIndex] + ( segment % numSegments );
-		}
-		else
-		{
-			m_vertexDataIndices[0] = evaluator->m_vertexDataOffsets[m_curveIndex] + segment * basis.step;
-			m_vertexDataIndices[1] = m_vertexDataIndices[0] + 1;
-			m_vertexDataIndices[2] = m_vertexDataIndices[1] + 1;
-			m_vertexDataIndices[3] = m_vertexDataIndices[2] + 1;
-
-			m_varyingDataIndices[0] = evaluator->m_varyingDataOffsets[m_curveIndex] + segment;
-			m_varyingDataIndices[1] = m_varyingDataIndices[0] + 1;
-		}
-	}
+	m_segmentV = sample.segmentV;
+	std::copy( sample.coefficients, sample.coefficients + 4, m_coefficients );
+	std::copy( sample.derivativeCoefficients, sample.derivativeCoefficients + 4, m_derivativeCoefficients );
+	std::copy( sample.vertexDataIndices, sample.vertexDataIndices + 4, m_vertexDataIndices );
+	std::copy( sample.varyingDataIndices, sample.varyingDataIndices + 2, m_varyingDataIndices );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -308,6 +251,10 @@ struct CurvesPrimitiveEvaluator::Line
 {
 	public :
 
+		Line()
+		{
+		}
+
 		Line( const V3f &p1, const V3f &p2, unsigned curveIndex, float vMin, float vMax )
 			:	m_lineSegment( p1, p2 ), m_curveIndex( curveIndex ), m_vMin( vMin ), m_vMax( vMax )
 		{
@@ -416,6 +363,10 @@ bool CurvesPrimitiveEvaluator::closestPoint( const Imath::V3f &p, PrimitiveEvalu
 	// the cast is to make the tree members mutable, but i'd rather keep them immutable so that the compiler tells us if
 	// we do anything wrong during the query.
 	const_cast<CurvesPrimitiveEvaluator *>( this )->buildTree();
+	if( m_treeLines.empty() )
+	{
+		return false;
+	}
 
 	unsigned curveIndex = 0;
 	float v = -1;
@@ -433,10 +384,10 @@ void CurvesPrimitiveEvaluator::closestPointWalk( Box3fTree::NodeIndex nodeIndex,
 	const Box3fTree::Node &node = m_tree.node( nodeIndex );
 	if( node.isLeaf() )
 	{
-		Box3fTree::Iterator *permLast = node.permLast();
-		for( Box3fTree::Iterator *perm = node.permFirst(); perm!=permLast; perm++ )
+		const Line *linesEnd = m_treeLines.data() + ( node.permLast() - m_tree.permutation() );
+		for( const Line *lineIt = m_treeLines.data() + ( node.permFirst() - m_tree.permutation() ); lineIt != linesEnd; ++lineIt )
 		{
-			const Line &line = m_treeLines[*perm - m_treeBounds.begin()];
+			const Line &line = *lineIt;
 
 			float t;
 			V3f cp = line.lineSegment().closestPointTo( p, t );
@@ -656,60 +607,159 @@ void CurvesPrimitiveEvaluator::buildTree()
 		return;
 	}
 
-	bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
-	const std::vector<V3f> &p = static_cast<const V3fVectorData *>( m_p.data.get() )->readable();
-	PrimitiveEvaluator::ResultPtr result = createResult();
+	// Isolation prevents this thread from picking up unrelated tasks
+	// while we wait for the parallel build, as they could need the
+	// same lock.
+	tbb::this_task_arena::isolate(
+		[this] {
+			const bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
+			const std::vector<V3f> &p = static_cast<const V3fVectorData *>( m_p.data.get() )->readable();
 
-	size_t numCurves = m_curvesPrimitive->numCurves();
-	for( size_t curveIndex = 0; curveIndex<numCurves; curveIndex++ )
-	{
-		if( linear )
-		{
-			int numVertices = m_verticesPerCurve[curveIndex];
-			int vertIndex = m_vertexDataOffsets[curveIndex];
-			float prevV = 0.0f;
-			for( int i=0; i<numVertices; i++, vertIndex++ )
+			// We know how many lines each curve will generate, so can allocate
+			// them all up front and then generate the curves in parallel.
+
+			const size_t numCurves = m_curvesPrimitive->numCurves();
+			std::vector<size_t> lineOffsets( numCurves + 1, 0 );
+			for( size_t curveIndex = 0; curveIndex < numCurves; curveIndex++ )
 			{
-				float v = clamp( (float)i/(float)(numVertices-1), 0.0f, 1.0f );
-				if( i!=0 )
-				{
-					Box3f b;
-					b.extendBy( p[vertIndex-1] );
-					b.extendBy( p[vertIndex] );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line(  p[vertIndex-1], p[vertIndex], curveIndex, prevV, v ) );
-				}
-				prevV = v;
+				const int numSamples = linear ? m_verticesPerCurve[curveIndex] : m_curvesPrimitive->numSegments( curveIndex ) * Line::linesPerCurveSegment();
+				lineOffsets[curveIndex+1] = lineOffsets[curveIndex] + std::max( numSamples - 1, 0 );
 			}
+
+			m_treeBounds.resize( lineOffsets.back() );
+			std::vector<Line> lines( lineOffsets.back() );
+
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, numCurves ),
+				[&]( const tbb::blocked_range<size_t> &r ) {
+					PrimitiveEvaluator::ResultPtr result = createResult();
+					for( size_t curveIndex = r.begin(); curveIndex != r.end(); ++curveIndex )
+					{
+						size_t lineIndex = lineOffsets[curveIndex];
+						if( linear )
+						{
+							int numVertices = m_verticesPerCurve[curveIndex];
+							int vertIndex = m_vertexDataOffsets[curveIndex];
+							float prevV = 0.0f;
+							for( int i=0; i<numVertices; i++, vertIndex++ )
+							{
+								float v = clamp( (float)i/(float)(numVertices-1), 0.0f, 1.0f );
+								if( i!=0 )
+								{
+									Box3f &b = m_treeBounds[lineIndex];
+									b.extendBy( p[vertIndex-1] );
+									b.extendBy( p[vertIndex] );
+									lines[lineIndex++] = Line( p[vertIndex-1], p[vertIndex], curveIndex, prevV, v );
+								}
+								prevV = v;
+							}
+						}
+						else
+						{
+							unsigned numSegments = m_curvesPrimitive->numSegments( curveIndex );
+							int steps = numSegments * Line::linesPerCurveSegment();
+							V3f prevP( 0 );
+							float prevV = 0;
+							for( int i=0; i<steps; i++ )
+							{
+								float v = clamp( (float)i/(float)(steps-1), 0.0f, 1.0f );
+								pointAtV( curveIndex, v, result.get() );
+								V3f p = result->point();
+								if( i!=0 )
+								{
+									Box3f &b = m_treeBounds[lineIndex];
+									b.extendBy( prevP );
+									b.extendBy( p );
+									lines[lineIndex++] = Line( prevP, p, curveIndex, prevV, v );
+								}
+
+								prevP = p;
+								prevV = v;
+							}
+						}
+					}
+				},
+				taskGroupContext
+			);
+
+			m_tree.init( m_treeBounds.begin(), m_treeBounds.end() );
+
+			// Reorder the lines to match the permutation used by the tree, so
+			// that the lines for each leaf are contiguous.
+
+			m_treeLines.resize( lines.size() );
+			const Box3fTree::Iterator *permutation = m_tree.permutation();
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, lines.size() ),
+				[&]( const tbb::blocked_range<size_t> &r ) {
+					for( size_t i = r.begin(); i != r.end(); ++i )
+					{
+						m_treeLines[i] = lines[permutation[i] - m_treeBounds.begin()];
+					}
+				},
+				taskGroupContext
+			);
 		}
-		else
+	);
+
+	m_haveTree = true;
+}
+
+void CurvesPrimitiveEvaluator::batchClosestPoint(
+	const Imath::V3f *points, size_t numPoints,
+	int *curveIndices, float *v, Imath::V3f *positions,
+	float maxDistance
+) const
+{
+	if( m_verticesPerCurve.size() )
+	{
+		const_cast<CurvesPrimitiveEvaluator *>( this )->buildTree();
+	}
+
+	if( m_treeLines.empty() )
+	{
+		if( curveIndices )
 		{
-			unsigned numSegments = m_curvesPrimitive->numSegments( curveIndex );
-			int steps = numSegments * Line::linesPerCurveSegment();
-			V3f prevP( 0 );
-			float prevV = 0;
-			for( int i=0; i<steps; i++ )
+			std::fill( curveIndices, curveIndices + numPoints, -1 );
+		}
+		return;
+	}
+
+	const float maxDistSquared = maxDistance < sqrt( limits<float>::max() ) ? maxDistance * maxDistance : limits<float>::max();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			ResultPtr result = positions ? boost::static_pointer_cast<Result>( createResult() ) : nullptr;
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				float v = clamp( (float)i/(float)(steps-1), 0.0f, 1.0f );
-				pointAtV( curveIndex, v, result.get() );
-				V3f p = result->point();
-				if( i!=0 )
+				unsigned curveIndex = 0;
+				float curveV = -1;
+				float distSquared = maxDistSquared;
+				closestPointWalk( m_tree.rootIndex(), points[i], curveIndex, curveV, distSquared );
+				if( curveIndices )
 				{
-					Box3f b;
-					b.extendBy( prevP );
-					b.extendBy( p );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line( prevP, p, curveIndex, prevV, v ) );
+					curveIndices[i] = curveV < 0 ? -1 : curveIndex;
+				}
+				if( curveV < 0 )
+				{
+					continue;
+				}
+				if( v )
+				{
+					v[i] = curveV;
+				}
+				if( positions )
+				{
+					(result.get()->*result->m_init)( curveIndex, curveV, this );
+					positions[i] = result->point();
 				}
-
-				prevP = p;
-				prevV = v;
 			}
-		}
-	}
-
-	m_tree.init( m_treeBounds.begin(), m_treeBounds.end() );
-	m_haveTree = true;
+		},
+		taskGroupContext
+	);
 }
 
 const std::vector<int> &CurvesPrimitiveEvaluator::verticesPerCurve() const
@@ -33,7 +33,6 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
-#include "IECoreScene/MeshPrimitiveEvaluator.h"
 #include "IECoreScene/PrimitiveVariable.h"
 
 #include "IECore/PointDistribution.h"
@@ -88,124 +87,93 @@ MeshPrimitivePtr processMesh( const MeshPrimitive *mesh, const std::string &dens
 	return result;
 }
 
-struct Emitter
+// Evaluates the density mask at a barycentric position on a triangle,
+// matching the interpolation performed by MeshPrimitiveEvaluator.
+class DensityEvaluator
 {
+
 	public :
 
-		Emitter( MeshPrimitiveEvaluator *evaluator, const PrimitiveVariable &densityVar, std::vector<Imath::V3f> &positions, size_t triangleIndex, const Imath::V2f &v0, const Imath::V2f &v1, const Imath::V2f &v2 )
-			: m_meshEvaluator( evaluator ), m_densityVar( densityVar ), m_p( positions ), m_triangleIndex( triangleIndex ), m_v0( v0 ), m_v1( v1 ), m_v2( v2 )
+		DensityEvaluator( const PrimitiveVariable &densityVar )
+			:	m_interpolation( densityVar.interpolation ), m_constant( 1.0f )
 		{
-			m_evaluatorResult = boost::static_pointer_cast<MeshPrimitiveEvaluator::Result>( m_meshEvaluator->createResult() );
+			if( const FloatData *constantData = runTimeCast<const FloatData>( densityVar.data.get() ) )
+			{
+				m_interpolation = PrimitiveVariable::Constant;
+				m_constant = constantData->readable();
+			}
+			else
+			{
+				m_view = PrimitiveVariable::IndexedView<float>( densityVar );
+				if( m_interpolation == PrimitiveVariable::Constant )
+				{
+					m_constant = m_view[0];
+				}
+			}
 		}
 
-		void operator() ( const Imath::V2f pos, float densityThreshold )
+		float operator()( size_t triangleIndex, const int *vertexIds, const V3f &bary ) const
 		{
-			Imath::V3f bary;
-			if( triangleContainsPoint( m_v0, m_v1, m_v2, pos, bary ) )
+			switch( m_interpolation )
 			{
-				m_meshEvaluator->barycentricPosition( m_triangleIndex, bary, m_evaluatorResult.get() );
-				if ( m_evaluatorResult->floatPrimVar( m_densityVar ) >= densityThreshold )
-				{
-					m_p.push_back( m_evaluatorResult->point() );
-				}
+				case PrimitiveVariable::Uniform :
+					return m_view[triangleIndex];
+				case PrimitiveVariable::Vertex :
+				case PrimitiveVariable::Varying :
+					return m_view[vertexIds[0]] * bary[0] + m_view[vertexIds[1]] * bary[1] + m_view[vertexIds[2]] * bary[2];
+				case PrimitiveVariable::FaceVarying :
+					return m_view[triangleIndex*3] * bary[0] + m_view[triangleIndex*3+1] * bary[1] + m_view[triangleIndex*3+2] * bary[2];
+				default :
+					return m_constant;
 			}
 		}
 
 	private :
 
-		MeshPrimitiveEvaluator *m_meshEvaluator;
-		const PrimitiveVariable &m_densityVar;
-		std::vector<Imath::V3f> &m_p;
-		size_t m_triangleIndex;
-		Imath::V2f m_v0;
-		Imath::V2f m_v1;
-		Imath::V2f m_v2;
-
-		MeshPrimitiveEvaluator::ResultPtr m_evaluatorResult;
+		PrimitiveVariable::Interpolation m_interpolation;
+		float m_constant;
+		PrimitiveVariable::IndexedView<float> m_view;
 
 };
 
-struct Generator
+// Collects the candidate points that fall within a triangle, along with the
+// density threshold each must pass. These are then evaluated together in a
+// single loop, rather than one at a time as the distribution is walked.
+struct CandidateCollector
 {
-	public :
-
-		Generator( MeshPrimitiveEvaluator *evaluator, const std::vector<Imath::V2f> &uvs, bool faceVaryingUVs, const std::vector<float> &faceArea, const std::vector<float> &textureArea, float density, const PrimitiveVariable &densityVar, Imath::V2f offset )
-			: m_meshEvaluator( evaluator ), m_uvs( uvs ), m_faceVaryingUVs( faceVaryingUVs ), m_faceArea( faceArea ), m_textureArea( textureArea ), m_density( density ), m_densityVar( densityVar ), m_offset( offset ), m_positions()
-		{
-		}
-
-		Generator( Generator &that, tbb::split )
-			: m_meshEvaluator( that.m_meshEvaluator ), m_uvs( that.m_uvs ), m_faceVaryingUVs( that.m_faceVaryingUVs ), m_faceArea( that.m_faceArea ), m_textureArea( that.m_textureArea ), m_density( that.m_density ), m_densityVar( that.m_densityVar ), m_offset( that.m_offset ), m_positions()
-		{
-		}
-
-		void operator()( const tbb::blocked_range<size_t> &r )
-		{
-			for ( size_t i=r.begin(); i!=r.end(); ++i )
-			{
-				float textureDensity = m_density * m_faceArea[i] / m_textureArea[i];
-
-				size_t v0I = i * 3;
-				size_t v1I = v0I + 1;
-				size_t v2I = v1I + 1;
-
-				Imath::V2f uv0, uv1, uv2;
-			
-				if( m_faceVaryingUVs )
-				{
-					uv0 = m_uvs[v0I];
-					uv1 = m_uvs[v1I];
-					uv2 = m_uvs[v2I];
-				}
-				else
-				{
-					const std::vector<int> &ids = m_meshEvaluator->mesh()->vertexIds()->readable();
-					uv0 = m_uvs[ids[v0I]];
-					uv1 = m_uvs[ids[v1I]];
-					uv2 = m_uvs[ids[v2I]];
-				}
-
-				uv0 += m_offset;
-				uv1 += m_offset;
-				uv2 += m_offset;
-
-				Imath::Box2f uvBounds;
-				uvBounds.extendBy( uv0 );
-				uvBounds.extendBy( uv1 );
-				uvBounds.extendBy( uv2 );
 
-				Emitter emitter( m_meshEvaluator, m_densityVar, m_positions, i, uv0, uv1, uv2 );
-				PointDistribution::defaultInstance()( uvBounds, textureDensity, emitter );
-			}
-		}
-
-		void join( Generator &that )
-		{
-			size_t numThisPoints = this->m_positions.size();
-			this->m_positions.resize( numThisPoints + that.m_positions.size() );
-			std::copy( that.m_positions.begin(), that.m_positions.end(), this->m_positions.begin() + numThisPoints );
-		}
+	CandidateCollector( const V2f &uv0, const V2f &uv1, const V2f &uv2, std::vector<V3f> &barycentrics, std::vector<float> &thresholds )
+		:	m_uv0( uv0 ), m_uv1( uv1 ), m_uv2( uv2 ), m_barycentrics( barycentrics ), m_thresholds( thresholds )
+	{
+	}
 
-		std::vector<Imath::V3f> &positions()
+	void operator()( const V2f pos, float densityThreshold )
+	{
+		V3f bary;
+		if( triangleContainsPoint( m_uv0, m_uv1, m_uv2, pos, bary ) )
 		{
-			return m_positions;
+			m_barycentrics.push_back( bary );
+			m_thresholds.push_back( densityThreshold );
 		}
+	}
 
 	private :
 
-		MeshPrimitiveEvaluator *m_meshEvaluator;
-		const std::vector<Imath::V2f> &m_uvs;
-		bool m_faceVaryingUVs;
-		const std::vector<float> &m_faceArea;
-		const std::vector<float> &m_textureArea;
-		float m_density;
-		const PrimitiveVariable &m_densityVar;
-		Imath::V2f m_offset;
-
-		std::vector<Imath::V3f> m_positions;
+		const V2f m_uv0;
+		const V2f m_uv1;
+		const V2f m_uv2;
+		std::vector<V3f> &m_barycentrics;
+		std::vector<float> &m_thresholds;
 
 };
 
+// Faces are processed in fixed size blocks, each of which generates its
+// points independently. Because the blocks don't depend on the number of
+// threads or the order in which they are processed, and the results are
+// concatenated in face order, the output is identical however the work
+// is scheduled.
+const size_t g_facesPerBlock = 64;
+
 } // namespace
 
 PointsPrimitivePtr MeshAlgo::distributePoints( const MeshPrimitive *mesh, float density, const Imath::V2f &offset, const std::string &densityMask, const std::string &uvSet, const std::string &position )
@@ -216,7 +184,12 @@ PointsPrimitivePtr MeshAlgo::distributePoints( const MeshPrimitive *mesh, float
 	}
 
 	MeshPrimitivePtr updatedMesh = processMesh( mesh, densityMask, uvSet, position );
-	MeshPrimitiveEvaluatorPtr meshEvaluator = new MeshPrimitiveEvaluator( updatedMesh );
+
+	const V3fVectorData *pData = updatedMesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex );
+	if( !pData )
+	{
+		throw InvalidArgumentException( "MeshAlgo::distributePoints : MeshPrimitive has no \"P\" primitive variable of type V3fVectorData." );
+	}
 
 	bool faceVaryingUVs = true;
 	ConstV2fVectorDataPtr uvData = updatedMesh->expandedVariableData<V2fVectorData>( uvSet, PrimitiveVariable::FaceVarying, false /* throwOnInvalid*/ );
@@ -234,17 +207,98 @@ PointsPrimitivePtr MeshAlgo::distributePoints( const MeshPrimitive *mesh, float
 
 	const std::vector<float> &faceArea = updatedMesh->variableData<FloatVectorData>( "faceArea", PrimitiveVariable::Uniform )->readable();
 	const std::vector<float> &textureArea = updatedMesh->variableData<FloatVectorData>( "textureArea", PrimitiveVariable::Uniform )->readable();
-	const PrimitiveVariable &densityVar = updatedMesh->variables.find( densityMask )->second;
+	const DensityEvaluator densityEvaluator( updatedMesh->variables.find( densityMask )->second );
 
-	size_t numFaces = updatedMesh->verticesPerFace()->readable().size();
-	Generator gen( meshEvaluator.get(), uvData->readable(), faceVaryingUVs, faceArea, textureArea, density, densityVar, offset );
+	const std::vector<V3f> &p = pData->readable();
+	const std::vector<V2f> &uvs = uvData->readable();
+	const std::vector<int> &vertexIds = updatedMesh->vertexIds()->readable();
+	const PointDistribution &pointDistribution = PointDistribution::defaultInstance();
+
+	const size_t numFaces = updatedMesh->verticesPerFace()->readable().size();
+	const size_t numBlocks = ( numFaces + g_facesPerBlock - 1 ) / g_facesPerBlock;
+	std::vector<std::vector<V3f>> blockPositions( numBlocks );
 
 	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
-	tbb::auto_partitioner partitioner;
-	tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, numFaces ), gen, partitioner, taskGroupContext );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &r ) {
+
+			std::vector<V3f> barycentrics;
+			std::vector<float> thresholds;
+
+			for( size_t block = r.begin(); block != r.end(); ++block )
+			{
+				std::vector<V3f> &positions = blockPositions[block];
+				for( size_t i = block * g_facesPerBlock, e = std::min( i + g_facesPerBlock, numFaces ); i < e; ++i )
+				{
+					const float textureDensity = density * faceArea[i] / textureArea[i];
+					const int *triangleVertexIds = &vertexIds[i*3];
+
+					V2f uv0, uv1, uv2;
+					if( faceVaryingUVs )
+					{
+						uv0 = uvs[i*3];
+						uv1 = uvs[i*3+1];
+						uv2 = uvs[i*3+2];
+					}
+					else
+					{
+						uv0 = uvs[triangleVertexIds[0]];
+						uv1 = uvs[triangleVertexIds[1]];
+						uv2 = uvs[triangleVertexIds[2]];
+					}
+
+					uv0 += offset;
+					uv1 += offset;
+					uv2 += offset;
+
+					Box2f uvBounds;
+					uvBounds.extendBy( uv0 );
+					uvBounds.extendBy( uv1 );
+					uvBounds.extendBy( uv2 );
+
+					barycentrics.clear();
+					thresholds.clear();
+					CandidateCollector collector( uv0, uv1, uv2, barycentrics, thresholds );
+					pointDistribution( uvBounds, textureDensity, collector );
+
+					const V3f &p0 = p[triangleVertexIds[0]];
+					const V3f &p1 = p[triangleVertexIds[1]];
+					const V3f &p2 = p[triangleVertexIds[2]];
+					for( size_t j = 0, numCandidates = barycentrics.size(); j < numCandidates; ++j )
+					{
+						if( densityEvaluator( i, triangleVertexIds, barycentrics[j] ) >= thresholds[j] )
+						{
+							positions.push_back( trianglePoint( p0, p1, p2, barycentrics[j] ) );
+						}
+					}
+				}
+			}
+		},
+		taskGroupContext
+	);
 
-	V3fVectorDataPtr pData = new V3fVectorData();
-	pData->writable().swap( gen.positions() );
+	std::vector<size_t> blockOffsets( numBlocks + 1, 0 );
+	for( size_t i = 0; i < numBlocks; ++i )
+	{
+		blockOffsets[i+1] = blockOffsets[i] + blockPositions[i].size();
+	}
+
+	V3fVectorDataPtr resultData = new V3fVectorData();
+	std::vector<V3f> &result = resultData->writable();
+	result.resize( blockOffsets.back() );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numBlocks ),
+		[&]( const tbb::blocked_range<size_t> &r ) {
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				std::copy( blockPositions[i].begin(), blockPositions[i].end(), result.begin() + blockOffsets[i] );
+				std::vector<V3f>().swap( blockPositions[i] );
+			}
+		},
+		taskGroupContext
+	);
 
-	return new PointsPrimitive( pData );
+	return new PointsPrimitive( resultData );
 }
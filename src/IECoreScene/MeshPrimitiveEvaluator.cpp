@@ -49,6 +49,10 @@ IECORE_POP_DEFAULT_VISIBILITY
 #include "OpenEXR/ImathBoxAlgo.h"
 #include "OpenEXR/ImathLineAlgo.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace IECore;
@@ -211,7 +215,330 @@ const V3i &MeshPrimitiveEvaluator::Result::vertexIds() const
 	return m_vertexIds;
 }
 
-MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_uvTree(nullptr), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_haveAverageNormals( false )
+// A bounding volume hierarchy used for the batched queries. Unlike the
+// TriangleBoundTree, the nodes are stored in depth-first order, with the
+// first child immediately following its parent, and the triangle vertices
+// are stored directly in the order they are visited by the leaves. This
+// keeps the memory accessed by each query as compact as possible.
+class MeshPrimitiveEvaluator::BVH
+{
+
+	public :
+
+		BVH( const std::vector<V3f> &p, const std::vector<int> &vertexIds, const TriangleBoundVector &bounds )
+		{
+			const size_t numTriangles = bounds.size();
+			if( !numTriangles )
+			{
+				return;
+			}
+
+			std::vector<unsigned int> order( numTriangles );
+			std::vector<V3f> centroids( numTriangles );
+			for( size_t i = 0; i < numTriangles; ++i )
+			{
+				order[i] = i;
+				centroids[i] = bounds[i].center();
+			}
+
+			m_nodes.reserve( 2 * ( numTriangles / g_maxLeafSize + 1 ) );
+			build( order.begin(), order.end(), bounds, centroids, 0 );
+
+			m_triangles.reserve( numTriangles );
+			for( const auto &index : order )
+			{
+				Triangle t;
+				t.p0 = p[vertexIds[index*3]];
+				t.p1 = p[vertexIds[index*3+1]];
+				t.p2 = p[vertexIds[index*3+2]];
+				t.index = index;
+				m_triangles.push_back( t );
+			}
+		}
+
+		// Returns the index of the closest triangle within `sqrt( maxDistSqrd )`,
+		// or -1 if there is none.
+		int closestPoint( const V3f &p, float maxDistSqrd, V3f &bary ) const
+		{
+			int result = -1;
+			if( m_nodes.empty() )
+			{
+				return result;
+			}
+
+			unsigned int stack[g_maxDepth];
+			size_t stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while( stackSize )
+			{
+				const Node &node = m_nodes[stack[--stackSize]];
+				if( distanceSquared( node.bound, p ) >= maxDistSqrd )
+				{
+					// We found a closer triangle since this
+					// node was pushed.
+					continue;
+				}
+
+				if( node.numTriangles )
+				{
+					for( const Triangle *t = &m_triangles[node.index], *e = t + node.numTriangles; t != e; ++t )
+					{
+						V3f b;
+						const float dSqrd = triangleClosestBarycentric( t->p0, t->p1, t->p2, p, b );
+						if( dSqrd < maxDistSqrd )
+						{
+							maxDistSqrd = dSqrd;
+							bary = b;
+							result = t->index;
+						}
+					}
+					continue;
+				}
+
+				// Push the furthest child first, so that we visit
+				// the nearest first and can cull more of the other.
+				unsigned int first = &node - m_nodes.data() + 1;
+				unsigned int second = node.index;
+				float dFirst = distanceSquared( m_nodes[first].bound, p );
+				float dSecond = distanceSquared( m_nodes[second].bound, p );
+				if( dSecond < dFirst )
+				{
+					std::swap( first, second );
+					std::swap( dFirst, dSecond );
+				}
+				if( dSecond < maxDistSqrd )
+				{
+					stack[stackSize++] = second;
+				}
+				if( dFirst < maxDistSqrd )
+				{
+					stack[stackSize++] = first;
+				}
+			}
+
+			return result;
+		}
+
+		// Returns the index of the closest triangle hit by the ray within
+		// `maxDistance`, or -1 if there is none. `dir` must be normalised.
+		int intersectionPoint( const V3f &origin, const V3f &dir, float maxDistance, V3f &bary, float &distance ) const
+		{
+			int result = -1;
+			if( m_nodes.empty() )
+			{
+				return result;
+			}
+
+			const V3f invDir( 1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z );
+
+			unsigned int stack[g_maxDepth];
+			float stackDistances[g_maxDepth];
+			size_t stackSize = 0;
+
+			float tRoot;
+			if( !intersects( m_nodes[0].bound, origin, invDir, maxDistance, tRoot ) )
+			{
+				return result;
+			}
+			stack[stackSize] = 0;
+			stackDistances[stackSize++] = tRoot;
+
+			while( stackSize )
+			{
+				--stackSize;
+				if( stackDistances[stackSize] > maxDistance )
+				{
+					// We found a closer hit since this
+					// node was pushed.
+					continue;
+				}
+
+				const Node &node = m_nodes[stack[stackSize]];
+				if( node.numTriangles )
+				{
+					for( const Triangle *t = &m_triangles[node.index], *e = t + node.numTriangles; t != e; ++t )
+					{
+						float u, v, tHit;
+						if( intersects( *t, origin, dir, u, v, tHit ) && tHit < maxDistance )
+						{
+							maxDistance = tHit;
+							bary = V3f( 1.0f - u - v, u, v );
+							distance = tHit;
+							result = t->index;
+						}
+					}
+					continue;
+				}
+
+				// As for closestPoint(), visit the nearest child first.
+				unsigned int first = &node - m_nodes.data() + 1;
+				unsigned int second = node.index;
+				float tFirst, tSecond;
+				bool hitFirst = intersects( m_nodes[first].bound, origin, invDir, maxDistance, tFirst );
+				bool hitSecond = intersects( m_nodes[second].bound, origin, invDir, maxDistance, tSecond );
+				if( hitFirst && hitSecond && tSecond < tFirst )
+				{
+					std::swap( first, second );
+					std::swap( tFirst, tSecond );
+				}
+				else if( hitSecond && !hitFirst )
+				{
+					std::swap( first, second );
+					std::swap( tFirst, tSecond );
+					std::swap( hitFirst, hitSecond );
+				}
+				if( hitSecond )
+				{
+					stack[stackSize] = second;
+					stackDistances[stackSize++] = tSecond;
+				}
+				if( hitFirst )
+				{
+					stack[stackSize] = first;
+					stackDistances[stackSize++] = tFirst;
+				}
+			}
+
+			return result;
+		}
+
+	private :
+
+		// Maximum number of triangles per leaf.
+		static const size_t g_maxLeafSize = 4;
+		// Splitting at the median guarantees a balanced tree, so this
+		// is more than sufficient for any mesh we can index with ints.
+		static const size_t g_maxDepth = 64;
+
+		struct Node
+		{
+			Box3f bound;
+			// For branches, the index of the second child, the first child
+			// being stored immediately after this node. For leaves, the
+			// index of the first triangle.
+			unsigned int index;
+			// Zero for branches.
+			unsigned int numTriangles;
+		};
+
+		struct Triangle
+		{
+			V3f p0;
+			V3f p1;
+			V3f p2;
+			int index;
+		};
+
+		typedef std::vector<unsigned int>::iterator OrderIterator;
+
+		void build( OrderIterator begin, OrderIterator end, const TriangleBoundVector &bounds, const std::vector<V3f> &centroids, size_t triangleOffset )
+		{
+			const size_t nodeIndex = m_nodes.size();
+			m_nodes.push_back( Node() );
+
+			Box3f bound;
+			Box3f centroidBound;
+			for( OrderIterator it = begin; it != end; ++it )
+			{
+				bound.extendBy( bounds[*it] );
+				centroidBound.extendBy( centroids[*it] );
+			}
+			m_nodes[nodeIndex].bound = bound;
+
+			const size_t size = end - begin;
+			if( size <= g_maxLeafSize )
+			{
+				m_nodes[nodeIndex].index = triangleOffset;
+				m_nodes[nodeIndex].numTriangles = size;
+				return;
+			}
+
+			// Split at the median centroid along the longest axis.
+			const unsigned int axis = centroidBound.majorAxis();
+			OrderIterator middle = begin + size / 2;
+			std::nth_element(
+				begin, middle, end,
+				[&centroids, axis]( unsigned int a, unsigned int b ) {
+					return centroids[a][axis] < centroids[b][axis];
+				}
+			);
+
+			build( begin, middle, bounds, centroids, triangleOffset );
+			m_nodes[nodeIndex].index = m_nodes.size();
+			m_nodes[nodeIndex].numTriangles = 0;
+			build( middle, end, bounds, centroids, triangleOffset + ( middle - begin ) );
+		}
+
+		static float distanceSquared( const Box3f &box, const V3f &p )
+		{
+			return ( closestPointInBox( p, box ) - p ).length2();
+		}
+
+		// Slab test. Comparisons are arranged so that the NaNs generated
+		// by rays lying in the plane of a slab are ignored.
+		static bool intersects( const Box3f &box, const V3f &origin, const V3f &invDir, float maxDistance, float &tNear )
+		{
+			tNear = 0.0f;
+			float tFar = maxDistance;
+			for( int i = 0; i < 3; ++i )
+			{
+				float t1 = ( box.min[i] - origin[i] ) * invDir[i];
+				float t2 = ( box.max[i] - origin[i] ) * invDir[i];
+				if( t1 > t2 )
+				{
+					std::swap( t1, t2 );
+				}
+				if( t1 > tNear )
+				{
+					tNear = t1;
+				}
+				if( t2 < tFar )
+				{
+					tFar = t2;
+				}
+			}
+			return tNear <= tFar;
+		}
+
+		// Moller-Trumbore ray-triangle test. Like the IECore::triangleRayIntersection()
+		// test used by intersectionPoint(), this accepts hits on both sides of the triangle.
+		static bool intersects( const Triangle &t, const V3f &origin, const V3f &dir, float &u, float &v, float &tHit )
+		{
+			const V3f e1 = t.p1 - t.p0;
+			const V3f e2 = t.p2 - t.p0;
+			const V3f pVec = dir % e2;
+			const float det = e1 ^ pVec;
+			if( det == 0.0f )
+			{
+				return false;
+			}
+
+			const float invDet = 1.0f / det;
+			const V3f tVec = origin - t.p0;
+			u = ( tVec ^ pVec ) * invDet;
+			if( u < 0.0f || u > 1.0f )
+			{
+				return false;
+			}
+
+			const V3f qVec = tVec % e1;
+			v = ( dir ^ qVec ) * invDet;
+			if( v < 0.0f || u + v > 1.0f )
+			{
+				return false;
+			}
+
+			tHit = ( e2 ^ qVec ) * invDet;
+			return tHit >= 0.0f;
+		}
+
+		std::vector<Node> m_nodes;
+		std::vector<Triangle> m_triangles;
+
+};
+
+MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_uvTree(nullptr), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_bvh( nullptr ), m_haveAverageNormals( false )
 {
 	if (! mesh )
 	{
@@ -323,6 +650,9 @@ MeshPrimitiveEvaluator::~MeshPrimitiveEvaluator()
 
 	delete m_uvTree;
 	m_uvTree = nullptr;
+
+	delete m_bvh;
+	m_bvh = nullptr;
 }
 
 ConstPrimitivePtr MeshPrimitiveEvaluator::primitive() const
@@ -1272,6 +1602,104 @@ void MeshPrimitiveEvaluator::intersectionPointsWalk( TriangleBoundTree::NodeInde
 	}
 }
 
+const MeshPrimitiveEvaluator::BVH *MeshPrimitiveEvaluator::bvh() const
+{
+	if( m_bvh )
+	{
+		return m_bvh;
+	}
+
+	BVHMutex::scoped_lock lock( m_bvhMutex );
+	if( !m_bvh )
+	{
+		// another thread may have built the BVH while we waited for the mutex
+		m_bvh = new BVH( m_verts->readable(), *m_meshVertexIds, m_triangles );
+	}
+
+	return m_bvh;
+}
+
+void MeshPrimitiveEvaluator::batchClosestPoint(
+	const Imath::V3f *points, size_t numPoints,
+	int *triangleIndices, Imath::V3f *barycentricCoordinates, Imath::V3f *positions,
+	float maxDistance
+) const
+{
+	const BVH *bvh = this->bvh();
+	const std::vector<V3f> &p = m_verts->readable();
+	const float maxDistSqrd = maxDistance < sqrt( limits<float>::max() ) ? maxDistance * maxDistance : limits<float>::max();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				V3f bary;
+				const int triangleIndex = bvh->closestPoint( points[i], maxDistSqrd, bary );
+				if( triangleIndices )
+				{
+					triangleIndices[i] = triangleIndex;
+				}
+				if( triangleIndex < 0 )
+				{
+					continue;
+				}
+				if( barycentricCoordinates )
+				{
+					barycentricCoordinates[i] = bary;
+				}
+				if( positions )
+				{
+					const int *vertexIds = &(*m_meshVertexIds)[triangleIndex*3];
+					positions[i] = trianglePoint( p[vertexIds[0]], p[vertexIds[1]], p[vertexIds[2]], bary );
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
+void MeshPrimitiveEvaluator::batchIntersectionPoint(
+	const Imath::V3f *origins, const Imath::V3f *directions, size_t numRays,
+	int *triangleIndices, Imath::V3f *barycentricCoordinates, Imath::V3f *positions,
+	float maxDistance
+) const
+{
+	const BVH *bvh = this->bvh();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numRays ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const V3f direction = directions[i].normalized();
+				V3f bary;
+				float distance;
+				const int triangleIndex = bvh->intersectionPoint( origins[i], direction, maxDistance, bary, distance );
+				if( triangleIndices )
+				{
+					triangleIndices[i] = triangleIndex;
+				}
+				if( triangleIndex < 0 )
+				{
+					continue;
+				}
+				if( barycentricCoordinates )
+				{
+					barycentricCoordinates[i] = bary;
+				}
+				if( positions )
+				{
+					positions[i] = origins[i] + direction * distance;
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
 const Imath::Box2f MeshPrimitiveEvaluator::uvBound() const
 {
 	if( !m_uvTree )
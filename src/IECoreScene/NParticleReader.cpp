@@ -133,6 +133,7 @@ bool NParticleReader::open()
 
 		m_frames->writable().clear();
 		frameToRootChildren.clear();
+		m_channels.clear();
 
 		// single frame per file
 		if ( m_header.startTime == m_header.endTime && (headerIt+1)->groupName().id() == kMYCH )
@@ -206,23 +207,26 @@ unsigned long NParticleReader::numParticles()
 	return numParticles;
 }
 
-void NParticleReader::attributeNames( std::vector<std::string> &names )
+const NParticleReader::ChannelIndex *NParticleReader::channels( const char *context )
 {
-	names.clear();
-	if( !open() )
+	int frameIndex = m_frameParameter->getNumericValue();
+	int frame = m_frames->readable()[frameIndex];
+
+	std::map<int, ChannelIndex>::const_iterator channelsIt = m_channels.find( frame );
+	if( channelsIt != m_channels.end() )
 	{
-		return;
+		return &channelsIt->second;
 	}
 
-	int frameIndex = m_frameParameter->getNumericValue();
-	int frame = m_frames->readable()[frameIndex];
 	std::map<int, IFFFile::Chunk::ChunkIterator>::const_iterator frameIt = frameToRootChildren.find( frame );
 	if( frameIt == frameToRootChildren.end() )
 	{
-		msg( Msg::Warning, "NParticleReader::attributeNames()", boost::format( "Frame '%d' (index '%d') does not exist in '%s'." ) % frame % frameIndex % m_iffFileName );
-		return;
+		msg( Msg::Warning, context, boost::format( "Frame '%d' (index '%d') does not exist in '%s'." ) % frame % frameIndex % m_iffFileName );
+		return nullptr;
 	}
 
+	ChannelIndex &result = m_channels[frame];
+
 	IFFFile::Chunk::ChunkIterator child = frameIt->second;
 	IFFFile::Chunk::ChunkIterator it = child->childrenBegin();
 
@@ -232,9 +236,31 @@ void NParticleReader::attributeNames( std::vector<std::string> &names )
 		{
 			std::string channelName;
 			it->read( channelName );
-			names.push_back( channelName );
+			result.push_back( ChannelIndex::value_type( channelName, it ) );
 		}
 	}
+
+	return &result;
+}
+
+void NParticleReader::attributeNames( std::vector<std::string> &names )
+{
+	names.clear();
+	if( !open() )
+	{
+		return;
+	}
+
+	const ChannelIndex *index = channels( "NParticleReader::attributeNames()" );
+	if( !index )
+	{
+		return;
+	}
+
+	for( ChannelIndex::const_iterator it = index->begin(); it != index->end(); ++it )
+	{
+		names.push_back( it->first );
+	}
 }
 
 const IntVectorData * NParticleReader::frameTimes()
@@ -293,33 +319,21 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 		return nullptr;
 	}
 
-	int frameIndex = m_frameParameter->getNumericValue();
-	int frame = m_frames->readable()[frameIndex];
-	std::map<int, IFFFile::Chunk::ChunkIterator>::const_iterator frameIt = frameToRootChildren.find( frame );
-	if( frameIt == frameToRootChildren.end() )
+	const ChannelIndex *index = channels( "NParticleReader::readAttribute()" );
+	if( !index )
 	{
-		msg( Msg::Warning, "NParticleReader::readAttribute()", boost::format( "Frame '%d' (index '%d') does not exist in '%s'." ) % frame % frameIndex % m_iffFileName );
 		return nullptr;
 	}
 
 	bool foundAttr = false;
-	std::string channelName;
 	IFFFile::Chunk::ChunkIterator attrIt;
-	IFFFile::Chunk::ChunkIterator cache = frameIt->second;
-	IFFFile::Chunk::ChunkIterator it = cache->childrenBegin();
-
-	for ( ; it != cache->childrenEnd(); it++ )
+	for( ChannelIndex::const_iterator channelIt = index->begin(); channelIt != index->end(); ++channelIt )
 	{
-		if ( it->type().id() == kCHNM )
+		if( channelIt->first == name )
 		{
-			it->read( channelName );
-
-			if ( name.compare( channelName ) == 0 )
-			{
-				attrIt = it;
-				foundAttr = true;
-				break;
-			}
+			attrIt = channelIt->second;
+			foundAttr = true;
+			break;
 		}
 	}
 
@@ -328,6 +342,9 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 		return nullptr;
 	}
 
+	// channels() has already verified that the frame exists.
+	IFFFile::Chunk::ChunkIterator cache = frameToRootChildren.find( m_frames->readable()[m_frameParameter->getNumericValue()] )->second;
+	IFFFile::Chunk::ChunkIterator it = attrIt;
 	for ( it++; it < attrIt+2 && it != cache->childrenEnd(); it++ )
 	{
 		int id = it->type().id();
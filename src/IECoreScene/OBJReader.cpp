@@ -32,329 +32,748 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-
 #include "IECoreScene/OBJReader.h"
 
 #include "IECoreScene/MeshPrimitive.h"
 
-#include "IECore/CompoundData.h"
 #include "IECore/CompoundParameter.h"
+#include "IECore/Exception.h"
 #include "IECore/FileNameParameter.h"
-#include "IECore/MessageHandler.h"
 #include "IECore/NullObject.h"
-#include "IECore/NumericParameter.h"
 #include "IECore/ObjectParameter.h"
 #include "IECore/SimpleTypedData.h"
-#include "IECore/TypedParameter.h"
 #include "IECore/VectorTypedData.h"
 
-#include "boost/bind.hpp"
-#include "boost/version.hpp"
+#include "boost/filesystem/operations.hpp"
+#include "boost/format.hpp"
+#include "boost/iostreams/device/mapped_file.hpp"
 
-#if BOOST_VERSION >= 103600
-#define BOOST_SPIRIT_USE_OLD_NAMESPACE
-#include "boost/spirit/include/classic.hpp"
-#else
-#include "boost/spirit.hpp"
-#endif
+#include "tbb/tbb.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <iostream>
-#include <iterator>
+#include <limits>
 
 using namespace std;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Imath;
-using namespace boost;
-using namespace boost::spirit;
 
 IE_CORE_DEFINERUNTIMETYPED(OBJReader);
 
-// syntactic sugar for specifying our grammar
-typedef boost::spirit::rule<boost::spirit::phrase_scanner_t> srule;
-
 const Reader::ReaderDescription<OBJReader> OBJReader::m_readerDescription("obj");
 
-OBJReader::OBJReader( const std::string &fileName )
-	: Reader( "Alias Wavefront OBJ 3D data reader", new ObjectParameter("result", "the loaded 3D object", new
-	NullObject, MeshPrimitive::staticTypeId()))
+//////////////////////////////////////////////////////////////////////////
+// Parsing utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
 {
-	m_fileNameParameter->setTypedValue( fileName );
-}
 
-bool OBJReader::canRead( const string &fileName )
+// We aim for chunks of roughly this many bytes, so that there is
+// enough work to amortise the overhead of each task, but still
+// plenty of parallelism for large files.
+const size_t g_targetChunkSize = 1024 * 1024;
+
+// Used in the index arrays to mark face vertices which don't
+// reference a normal or texture coordinate.
+const int g_noIndex = std::numeric_limits<int>::min();
+
+inline bool isSpace( char c )
 {
-	// there really are no magic numbers, .obj is a simple ascii text file
+	return c == ' ' || c == '\t' || c == '\r';
+}
 
-	// so: enforce at least that the file has '.obj' extension
-	if(fileName.rfind(".obj") != fileName.length() - 4)
-		return false;
+inline const char *skipSpace( const char *p, const char *end )
+{
+	while( p != end && isSpace( *p ) )
+	{
+		++p;
+	}
+	return p;
+}
 
-	// attempt to open the file
-	ifstream in(fileName.c_str());
-	return in.is_open();
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
 }
 
-ObjectPtr OBJReader::doOperation(const CompoundObject * operands)
+// Parses a floating point number starting at `p`, returning a pointer
+// to the character after the number, or nullptr if no number could be
+// parsed. Numbers with up to 19 significant digits and moderate exponents
+// are assembled directly, which is several times faster than strtod(),
+// and accurate to within the precision of a float. Anything else falls
+// back to strtod().
+const char *parseFloat( const char *p, const char *end, float &result )
 {
-	// for now we are going to retrieve vertex, texture, normal coordinates, faces.
-	// later (when we have the primitives), we will handle a larger subset of the
-	// OBJ format
+	static const double g_powersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
 
-	IntVectorDataPtr vpf = new IntVectorData();
-	m_vpf = &vpf->writable();
+	const char *start = p;
 
-	IntVectorDataPtr vids = new IntVectorData();
-	m_vids = &vids->writable();
+	bool negative = false;
+	if( p != end && ( *p == '-' || *p == '+' ) )
+	{
+		negative = *p == '-';
+		++p;
+	}
 
-	V3fVectorDataPtr vertices = new V3fVectorData();
-	m_vertices = &vertices->writable();
+	uint64_t mantissa = 0;
+	int numDigits = 0;
+	int exponent = 0;
+	bool haveDigits = false;
 
- 	// separate texture coordinates
-	FloatVectorDataPtr sTextureCoordinates = new FloatVectorData();
-	m_sTextureCoordinates = &sTextureCoordinates->writable();
+	for( ; p != end && isDigit( *p ); ++p )
+	{
+		haveDigits = true;
+		if( numDigits < 19 )
+		{
+			mantissa = mantissa * 10 + ( *p - '0' );
+			numDigits += mantissa != 0;
+		}
+		else
+		{
+			exponent++;
+		}
+	}
 
-	FloatVectorDataPtr tTextureCoordinates = new FloatVectorData();
-	m_tTextureCoordinates = &tTextureCoordinates->writable();
+	if( p != end && *p == '.' )
+	{
+		++p;
+		for( ; p != end && isDigit( *p ); ++p )
+		{
+			haveDigits = true;
+			if( numDigits < 19 )
+			{
+				mantissa = mantissa * 10 + ( *p - '0' );
+				numDigits += mantissa != 0;
+				exponent--;
+			}
+		}
+	}
 
-	// build normals
-	V3fVectorDataPtr normals = new V3fVectorData();
-	m_normals = &normals->writable();
+	if( !haveDigits )
+	{
+		// Might be "inf" or "nan", which we leave to strtod(). The file
+		// isn't null terminated, so we must give it a copy.
+		char buffer[32];
+		const size_t length = std::min<size_t>( end - start, sizeof( buffer ) - 1 );
+		memcpy( buffer, start, length );
+		buffer[length] = 0;
+		char *strtodEnd = nullptr;
+		const double d = strtod( buffer, &strtodEnd );
+		if( strtodEnd == buffer )
+		{
+			return nullptr;
+		}
+		result = d;
+		return start + ( strtodEnd - buffer );
+	}
 
-	// parse the file
-	parseOBJ();
+	if( p != end && ( *p == 'e' || *p == 'E' ) )
+	{
+		const char *e = p + 1;
+		bool negativeExponent = false;
+		if( e != end && ( *e == '-' || *e == '+' ) )
+		{
+			negativeExponent = *e == '-';
+			++e;
+		}
+		if( e != end && isDigit( *e ) )
+		{
+			int explicitExponent = 0;
+			for( ; e != end && isDigit( *e ); ++e )
+			{
+				if( explicitExponent < 10000 )
+				{
+					explicitExponent = explicitExponent * 10 + ( *e - '0' );
+				}
+			}
+			exponent += negativeExponent ? -explicitExponent : explicitExponent;
+			p = e;
+		}
+	}
 
-	// create our MeshPrimitive
-	MeshPrimitivePtr mesh = new MeshPrimitive( vpf, vids, "linear", vertices );
-	if( sTextureCoordinates->readable().size() )
+	double d = mantissa;
+	if( exponent >= -22 && exponent <= 22 )
 	{
-		mesh->variables.insert(PrimitiveVariableMap::value_type("s", PrimitiveVariable( PrimitiveVariable::FaceVarying, sTextureCoordinates)));
+		d = exponent < 0 ? d / g_powersOfTen[-exponent] : d * g_powersOfTen[exponent];
+	}
+	else
+	{
+		d *= std::pow( 10.0, exponent );
+	}
+
+	result = negative ? -d : d;
+	return p;
+}
 
+// Parses an integer starting at `p`, returning a pointer to the character
+// after it, or nullptr if there is no integer.
+inline const char *parseInt( const char *p, const char *end, int &result )
+{
+	bool negative = false;
+	if( p != end && ( *p == '-' || *p == '+' ) )
+	{
+		negative = *p == '-';
+		++p;
 	}
-	if( tTextureCoordinates->readable().size() )
+
+	if( p == end || !isDigit( *p ) )
 	{
-		mesh->variables.insert(PrimitiveVariableMap::value_type("t", PrimitiveVariable(  PrimitiveVariable::FaceVarying, tTextureCoordinates)));
+		return nullptr;
 	}
-	if( normals->readable().size() )
+
+	int i = 0;
+	for( ; p != end && isDigit( *p ); ++p )
 	{
-		mesh->variables.insert(PrimitiveVariableMap::value_type("N", PrimitiveVariable(  PrimitiveVariable::FaceVarying, normals)));
+		i = i * 10 + ( *p - '0' );
 	}
-	return mesh;
+
+	result = negative ? -i : i;
+	return p;
 }
 
+// The results of parsing a single chunk of the file. Indices are
+// converted to be zero based, but indices which were specified
+// relative to the current element count are relative to the start
+// of the chunk, because we don't know how many elements preceded it
+// until all chunks have been parsed. The positions of such indices
+// are recorded so that they can be fixed up later.
+struct Chunk
+{
+
+	Chunk()
+		:	begin( nullptr ), end( nullptr ), haveTextureCoordinateIds( false ), haveNormalIds( false )
+	{
+	}
 
-// parse a vertex
-void OBJReader::parseVertex(const char * begin, const char * end)
+	const char *begin;
+	const char *end;
+
+	std::vector<V3f> positions;
+	std::vector<V3f> textureCoordinates;
+	std::vector<V3f> normals;
+
+	std::vector<int> verticesPerFace;
+	std::vector<int> vertexIds;
+	std::vector<int> textureCoordinateIds;
+	std::vector<int> normalIds;
+
+	std::vector<size_t> relativeVertexIds;
+	std::vector<size_t> relativeTextureCoordinateIds;
+	std::vector<size_t> relativeNormalIds;
+
+	bool haveTextureCoordinateIds;
+	bool haveNormalIds;
+
+	// Offsets of this chunk's data within the merged arrays.
+	size_t positionOffset;
+	size_t textureCoordinateOffset;
+	size_t normalOffset;
+	size_t faceOffset;
+	size_t faceVertexOffset;
+
+};
+
+class ChunkParser
 {
-	vector<float> vec;
-	srule vertex = "v" >> real_p[append(vec)] >> real_p[append(vec)] >> real_p[append(vec)];
-	parse(begin, vertex, space_p);
-
-	// build v
-	V3f v;
-	v[0] = vec[0];
- 	v[1] = vec[1];
- 	v[2] = vec[2];
-
-	// add this vertex
-	m_vertices->push_back(v);
-}
 
-// parse a texture coordinate
-void OBJReader::parseTextureCoordinate(const char * begin, const char * end)
+	public :
+
+		ChunkParser( Chunk &chunk, bool readNormals, bool readTextureCoordinates )
+			:	m_chunk( chunk ), m_readNormals( readNormals ), m_readTextureCoordinates( readTextureCoordinates )
+		{
+		}
+
+		void parse()
+		{
+			const char *p = m_chunk.begin;
+			while( p < m_chunk.end )
+			{
+				const char *lineEnd = static_cast<const char *>( memchr( p, '\n', m_chunk.end - p ) );
+				if( !lineEnd )
+				{
+					lineEnd = m_chunk.end;
+				}
+				parseLine( p, lineEnd );
+				p = lineEnd + 1;
+			}
+		}
+
+	private :
+
+		void parseLine( const char *p, const char *end )
+		{
+			p = skipSpace( p, end );
+			if( end - p < 2 )
+			{
+				return;
+			}
+
+			// see
+			// http://paulbourke.net/dataformats/obj/
+			//
+			// We only support the polygonal subset of the format, and
+			// ignore grouping, materials and anything else we don't
+			// understand.
+
+			if( p[0] == 'v' )
+			{
+				if( isSpace( p[1] ) )
+				{
+					m_chunk.positions.push_back( parseVector( p + 1, end, 3, "vertex" ) );
+				}
+				else if( p[1] == 't' && m_readTextureCoordinates )
+				{
+					m_chunk.textureCoordinates.push_back( parseVector( p + 2, end, 1, "texture coordinate" ) );
+				}
+				else if( p[1] == 'n' && m_readNormals )
+				{
+					m_chunk.normals.push_back( parseVector( p + 2, end, 3, "normal" ) );
+				}
+			}
+			else if( p[0] == 'f' && isSpace( p[1] ) )
+			{
+				parseFace( p + 1, end );
+			}
+		}
+
+		// Parses up to three components, of which at least `minComponents`
+		// must be present. Any missing components are set to 0.
+		V3f parseVector( const char *p, const char *end, int minComponents, const char *type )
+		{
+			V3f result( 0 );
+			for( int i = 0; i < 3; ++i )
+			{
+				p = skipSpace( p, end );
+				const char *next = p != end ? parseFloat( p, end, result[i] ) : nullptr;
+				if( !next )
+				{
+					if( i < minComponents )
+					{
+						throw IECore::Exception( boost::str( boost::format( "OBJReader : Invalid %s \"%s\"" ) % type % string( p, end ) ) );
+					}
+					break;
+				}
+				p = next;
+			}
+			return result;
+		}
+
+		void parseFace( const char *p, const char *end )
+		{
+			int numVertices = 0;
+			int numTextureCoordinates = 0;
+			int numNormals = 0;
+
+			while( true )
+			{
+				p = skipSpace( p, end );
+				if( p == end || *p == '#' )
+				{
+					break;
+				}
+
+				// v, v/vt, v//vn or v/vt/vn
+
+				// Zero is never a valid index, so we use it to denote
+				// texture coordinates and normals which aren't specified.
+				int vertexId = 0, textureCoordinateId = 0, normalId = 0;
+				p = parseInt( p, end, vertexId );
+				if( !p || !vertexId )
+				{
+					throw IECore::Exception( "OBJReader : Invalid face specification" );
+				}
+
+				if( p != end && *p == '/' )
+				{
+					++p;
+					if( p != end && *p != '/' )
+					{
+						p = parseInt( p, end, textureCoordinateId );
+						if( !p || !textureCoordinateId )
+						{
+							throw IECore::Exception( "OBJReader : Invalid face specification" );
+						}
+					}
+					if( p != end && *p == '/' )
+					{
+						++p;
+						p = parseInt( p, end, normalId );
+						if( !p || !normalId )
+						{
+							throw IECore::Exception( "OBJReader : Invalid face specification" );
+						}
+					}
+				}
+
+				addIndex( vertexId, m_chunk.positions.size(), m_chunk.vertexIds, m_chunk.relativeVertexIds );
+				numVertices++;
+
+				if( m_readTextureCoordinates )
+				{
+					if( textureCoordinateId )
+					{
+						addIndex( textureCoordinateId, m_chunk.textureCoordinates.size(), m_chunk.textureCoordinateIds, m_chunk.relativeTextureCoordinateIds );
+						numTextureCoordinates++;
+					}
+					else
+					{
+						m_chunk.textureCoordinateIds.push_back( g_noIndex );
+					}
+				}
+
+				if( m_readNormals )
+				{
+					if( normalId )
+					{
+						addIndex( normalId, m_chunk.normals.size(), m_chunk.normalIds, m_chunk.relativeNormalIds );
+						numNormals++;
+					}
+					else
+					{
+						m_chunk.normalIds.push_back( g_noIndex );
+					}
+				}
+			}
+
+			// OBJ requires that each face consistently uses one of the
+			// vertex/texture/normal encodings for all its vertices.
+			if(
+				( numTextureCoordinates && numTextureCoordinates != numVertices ) ||
+				( numNormals && numNormals != numVertices )
+			)
+			{
+				throw IECore::Exception( "OBJReader : Invalid face specification" );
+			}
+
+			if( numVertices )
+			{
+				m_chunk.verticesPerFace.push_back( numVertices );
+				m_chunk.haveTextureCoordinateIds = m_chunk.haveTextureCoordinateIds || numTextureCoordinates;
+				m_chunk.haveNormalIds = m_chunk.haveNormalIds || numNormals;
+			}
+		}
+
+		// OBJ indices are one based, and negative indices are relative
+		// to the number of elements specified so far.
+		inline void addIndex( int index, size_t numElements, std::vector<int> &indices, std::vector<size_t> &relativeIndices )
+		{
+			if( index > 0 )
+			{
+				indices.push_back( index - 1 );
+			}
+			else
+			{
+				relativeIndices.push_back( indices.size() );
+				indices.push_back( (int)numElements + index );
+			}
+		}
+
+		Chunk &m_chunk;
+		const bool m_readNormals;
+		const bool m_readTextureCoordinates;
+
+};
+
+void splitChunks( const char *begin, const char *end, std::vector<Chunk> &chunks )
 {
-	vector<float> vec;
-	srule vertex = "vt" >> real_p[append(vec)] >> real_p[append(vec)] >> *(real_p[append(vec)]);
-	parse(begin, vertex, space_p);
-
-	// build v
-	V3f vt;
-	vt[0] = vec[0];
- 	vt[1] = vec[1];
-	vt[2] = vec.size() == 3 ? vec[2] : 0.0f;
-
-	// add this texture coordinate
-	m_introducedTextureCoordinates.push_back(vt);
+	const size_t size = end - begin;
+	const size_t numChunks = std::max<size_t>( 1, size / g_targetChunkSize );
+
+	const char *chunkBegin = begin;
+	for( size_t i = 1; i <= numChunks && chunkBegin < end; ++i )
+	{
+		const char *chunkEnd = end;
+		if( i < numChunks )
+		{
+			// Align the end of the chunk with the end of a line.
+			chunkEnd = std::max( begin + ( size * i ) / numChunks, chunkBegin );
+			const char *newline = static_cast<const char *>( memchr( chunkEnd, '\n', end - chunkEnd ) );
+			chunkEnd = newline ? newline + 1 : end;
+		}
+
+		chunks.push_back( Chunk() );
+		chunks.back().begin = chunkBegin;
+		chunks.back().end = chunkEnd;
+		chunkBegin = chunkEnd;
+	}
 }
 
-// parse a normal
-void OBJReader::parseNormal(const char * begin, const char * end)
+void fixRelativeIndices( std::vector<int> &indices, const std::vector<size_t> &relativeIndices, size_t offset )
 {
-	vector<float> vec;
-	srule vertex = "vn" >> real_p[append(vec)] >> real_p[append(vec)] >> real_p[append(vec)];
-	parse(begin, vertex, space_p);
-
-	// build v
-	V3f vn;
-	vn[0] = vec[0];
-	vn[1] = vec[1];
-	vn[2] = vec[2];
-
-	// add this normal
-	m_introducedNormals.push_back(vn);
+	for( auto i : relativeIndices )
+	{
+		indices[i] += offset;
+	}
 }
 
-// parse face
-void OBJReader::parseFace(const char * begin, const char * end)
+inline int validIndex( int index, size_t size, const char *type )
 {
-	vector<int> vec;
-	vector<int> tvec;
-	vector<int> nvec;
-
-	srule entry = int_p[append(vec)] >>
-		(
-			("/" >> (int_p[append(tvec)] | epsilon_p) >> "/" >> (int_p[append(nvec)] | epsilon_p))
-			| epsilon_p
-		);
-
-	srule face = "f"  >> entry >> entry >> entry >> *(entry);
-	parse(begin, face, space_p);
-
-	// push back the degree of the face
-	m_vpf->push_back(vec.size());
-
-	// merge in the edges.  we index from 0, so shift them down.
-	// also, vertices may be indexed negatively, in which case they are relative to
-	// the current set of vertices
-	for(vector<int>::const_iterator i = vec.begin(); i != vec.end(); ++i)
+	if( index < 0 || (size_t)index >= size )
 	{
-		m_vids->push_back(*i > 0 ? *i - 1 : m_vertices->size() + *i);
+		throw IECore::Exception( boost::str( boost::format( "OBJReader : Invalid %s index %d" ) % type % ( index + 1 ) ) );
 	}
+	return index;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// OBJReader
+//////////////////////////////////////////////////////////////////////////
 
+OBJReader::OBJReader( const std::string &fileName )
+	: Reader( "Alias Wavefront OBJ 3D data reader", new ObjectParameter("result", "the loaded 3D object", new
+	NullObject, MeshPrimitive::staticTypeId()))
+{
+	m_fileNameParameter->setTypedValue( fileName );
+
+	m_readNormalsParameter = new BoolParameter(
+		"readNormals",
+		"When this is off, normals are not loaded.",
+		true
+	);
+
+	m_readTextureCoordinatesParameter = new BoolParameter(
+		"readTextureCoordinates",
+		"When this is off, texture coordinates are not loaded.",
+		true
+	);
+
+	parameters()->addParameter( m_readNormalsParameter );
+	parameters()->addParameter( m_readTextureCoordinatesParameter );
+}
+
+bool OBJReader::canRead( const string &fileName )
+{
+	// there really are no magic numbers, .obj is a simple ascii text file
+
+	// so: enforce at least that the file has '.obj' extension
+	if(fileName.rfind(".obj") != fileName.length() - 4)
+		return false;
+
+	// attempt to open the file
+	ifstream in(fileName.c_str());
+	return in.is_open();
+}
 
-	// merge in texture coordinates and normals, if present
-	// OBJ format requires an encoding for faces which uses one of the vertex/texture/normal specifications
-	// consistently across the entire face.  eg. we can have all v/vt/vn, or all v//vn, or all v, but not
-	// v//vn then v/vt/vn ...
-	if(!nvec.empty())
+BoolParameter *OBJReader::readNormalsParameter()
+{
+	return m_readNormalsParameter.get();
+}
+
+const BoolParameter *OBJReader::readNormalsParameter() const
+{
+	return m_readNormalsParameter.get();
+}
+
+BoolParameter *OBJReader::readTextureCoordinatesParameter()
+{
+	return m_readTextureCoordinatesParameter.get();
+}
+
+const BoolParameter *OBJReader::readTextureCoordinatesParameter() const
+{
+	return m_readTextureCoordinatesParameter.get();
+}
+
+ObjectPtr OBJReader::doOperation(const CompoundObject * operands)
+{
+	const bool readNormals = operands->member<BoolData>( "readNormals" )->readable();
+	const bool readTextureCoordinates = operands->member<BoolData>( "readTextureCoordinates" )->readable();
+
+	// Map the file and parse it in parallel, one chunk at a time.
+
+	boost::system::error_code error;
+	const uintmax_t fileSize = boost::filesystem::file_size( fileName(), error );
+	if( error )
 	{
-		if(nvec.size() != vec.size())
-			throw Exception("invalid face specification");
+		throw IECore::IOException( boost::str( boost::format( "OBJReader : Unable to open \"%s\" : %s" ) % fileName() % error.message() ) );
+	}
 
-		// copy in these references to normal vectors to the mesh's normal vector
-		for(vector<int>::const_iterator i = nvec.begin(); i != nvec.end(); ++i)
+	boost::iostreams::mapped_file_source file;
+	std::vector<Chunk> chunks;
+	if( fileSize )
+	{
+		try
 		{
-			m_normals->push_back(m_introducedNormals[*i > 0 ? *i - 1 : m_introducedNormals.size() + *i]);
+			file.open( fileName() );
 		}
-	}
-	// otherwise, check if we have specified normals in some previous face
-	// if so, and no normals were given here (examples, encoders that do this?), pump in
-	// default normal.  the default normal defined here is the zero normal, which is by
-	// definition orthogonal to every other vector.  this might result in odd lighting.
-	else
-	{
-		V3f zero(0.0f, 0.0f, 0.0f);
-		for(unsigned int i = 0; i < nvec.size(); ++i)
+		catch( const std::exception &e )
 		{
-			m_normals->push_back(zero);
+			throw IECore::IOException( boost::str( boost::format( "OBJReader : Unable to open \"%s\" : %s" ) % fileName() % e.what() ) );
 		}
+		splitChunks( file.data(), file.data() + file.size(), chunks );
 	}
 
-	//
-	// merge in texture coordinates, if present
-	//
-	if(!tvec.empty())
-	{
-		if(tvec.size() != vec.size())
-			throw Exception("invalid face specification");
-
-		for(unsigned int i = 0; i < tvec.size(); ++i)
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, chunks.size(), 1 ),
+		[&chunks, readNormals, readTextureCoordinates]( const tbb::blocked_range<size_t> &range )
 		{
-			int index = tvec[i] > 0 ? tvec[i] - 1 : m_introducedTextureCoordinates.size() + tvec[i];
-			m_sTextureCoordinates->push_back(m_introducedTextureCoordinates[index][0]);
-			m_tTextureCoordinates->push_back(m_introducedTextureCoordinates[index][1]);
-		}
-	}
-	else
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				ChunkParser( chunks[i], readNormals, readTextureCoordinates ).parse();
+			}
+		},
+		taskGroupContext
+	);
+
+	// Compute where each chunk's data lives in the merged arrays.
+
+	size_t numPositions = 0, numTextureCoordinates = 0, numNormals = 0, numFaces = 0, numFaceVertices = 0;
+	bool haveTextureCoordinateIds = false, haveNormalIds = false;
+	for( auto &chunk : chunks )
 	{
-		for(unsigned int i = 0; i < tvec.size(); ++i)
-		{
-			m_sTextureCoordinates->push_back(0.0f);
-			m_tTextureCoordinates->push_back(0.0f);
-		}
+		chunk.positionOffset = numPositions;
+		chunk.textureCoordinateOffset = numTextureCoordinates;
+		chunk.normalOffset = numNormals;
+		chunk.faceOffset = numFaces;
+		chunk.faceVertexOffset = numFaceVertices;
+
+		numPositions += chunk.positions.size();
+		numTextureCoordinates += chunk.textureCoordinates.size();
+		numNormals += chunk.normals.size();
+		numFaces += chunk.verticesPerFace.size();
+		numFaceVertices += chunk.vertexIds.size();
+
+		haveTextureCoordinateIds = haveTextureCoordinateIds || chunk.haveTextureCoordinateIds;
+		haveNormalIds = haveNormalIds || chunk.haveNormalIds;
 	}
-}
 
-void OBJReader::parseGroup(const char *begin, const char *end)
-{
-	// set current group
-	vector<string> groupNames;
-	srule grouping = "g" >> *(lexeme_d[alnum_p >> *(alnum_p)][append(groupNames)]);
+	// Merge the vertex data, so that we can look up the values referenced
+	// by each face.
+
+	V3fVectorDataPtr positionsData = new V3fVectorData;
+	std::vector<V3f> &positions = positionsData->writable();
+	positions.resize( numPositions );
 
-	parse(begin, grouping, space_p);
+	std::vector<V3f> textureCoordinates( haveTextureCoordinateIds ? numTextureCoordinates : 0 );
+	std::vector<V3f> normals( haveNormalIds ? numNormals : 0 );
 
-	// from 'http://local.wasp.uwa.edu.au/~pbourke/dataformats/obj/':
-	// The default group name is default.
-	if(groupNames.empty())
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, chunks.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Chunk &chunk = chunks[i];
+				std::copy( chunk.positions.begin(), chunk.positions.end(), positions.begin() + chunk.positionOffset );
+				if( haveTextureCoordinateIds )
+				{
+					std::copy( chunk.textureCoordinates.begin(), chunk.textureCoordinates.end(), textureCoordinates.begin() + chunk.textureCoordinateOffset );
+				}
+				if( haveNormalIds )
+				{
+					std::copy( chunk.normals.begin(), chunk.normals.end(), normals.begin() + chunk.normalOffset );
+				}
+				std::vector<V3f>().swap( chunk.positions );
+				std::vector<V3f>().swap( chunk.textureCoordinates );
+				std::vector<V3f>().swap( chunk.normals );
+			}
+		},
+		taskGroupContext
+	);
+
+	// Merge the faces, expanding normals and texture coordinates into
+	// FaceVarying data. Face vertices which don't specify a normal or
+	// texture coordinate receive zero values.
+
+	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
+	std::vector<int> &verticesPerFace = verticesPerFaceData->writable();
+	verticesPerFace.resize( numFaces );
+
+	IntVectorDataPtr vertexIdsData = new IntVectorData;
+	std::vector<int> &vertexIds = vertexIdsData->writable();
+	vertexIds.resize( numFaceVertices );
+
+	FloatVectorDataPtr sData = new FloatVectorData;
+	FloatVectorDataPtr tData = new FloatVectorData;
+	std::vector<float> &s = sData->writable();
+	std::vector<float> &t = tData->writable();
+	if( haveTextureCoordinateIds )
 	{
-		groupNames.push_back("default");
+		s.resize( numFaceVertices );
+		t.resize( numFaceVertices );
 	}
 
-	// \todo associate mesh objects with group names
-}
+	V3fVectorDataPtr normalsData = new V3fVectorData( std::vector<V3f>(), GeometricData::Normal );
+	std::vector<V3f> &faceVaryingNormals = normalsData->writable();
+	if( haveNormalIds )
+	{
+		faceVaryingNormals.resize( numFaceVertices );
+	}
 
-void OBJReader::parseOBJ() {
-
-	srule comment = comment_p("#");
-
-	// see
-	// http://local.wasp.uwa.edu.au/~pbourke/dataformats/obj/
-
-	// vertices
-	srule vertex         = ("v"  >> real_p >> real_p >> real_p) [bind(&OBJReader::parseVertex,            this, _1, _2)];
-	srule vertex_texture = ("vt" >> real_p >> real_p)           [bind(&OBJReader::parseTextureCoordinate, this, _1, _2)];
-	srule vertex_normal  = ("vn" >> real_p >> real_p >> real_p) [bind(&OBJReader::parseNormal,            this, _1, _2)];
-	//srule vertex_parameter_space  = "vp" >> real_p >> real_p >> real_p;
-
-	// srule cs_types = ("bmatrix" | "bezier" | "bspline" | "cardinal" | "taylor");
-	// srule vertex_curve_or_surface = "cstype" >> "rat" >> cs_types;
-	// srule vertex_degree  = "deg" >> real_p >> real_p;
-	// srule vertex_basis_matrix  = "bmat";
-	// srule vertex_step_size  = "step" >> int_p >> int_p;
-	srule vertex_type = vertex | vertex_texture | vertex_normal;
-
-	// elements
-	srule point = "p" >> real_p >> *(real_p);
-	srule  line = "l" >> int_p >> int_p >> *(int_p);
-	srule  face = (ch_p('f') >> *(anychar_p))[bind(&OBJReader::parseFace, this, _1, _2)];
-	// srule curve = "curv";
-	// srule curve_2d = "curv2";
-	// srule surface = "surf";
-	srule element = point | line | face;
-
- 	// free-form curve / surface statements
-	// srule parameter = "parm";
-	// srule trim_loop = "trim";
-	// srule hole_loop = "hole";
-	// srule special_curve = "scrv";
-	// srule special_point = "sp";
-	// srule end_statement = "end";
-
-	// connectivity
-	//srule connect = "con";
-
-	// grouping
-	srule group_name = ("g" >> *(anychar_p))[bind(&OBJReader::parseGroup, this, _1, _2)];
-	//	srule smoothing_group = "s";
-	//	srule merging_group = "mg";
-	srule object_name = "o" >> int_p;
-	srule grouping = group_name | object_name;
-
-	// display and render attributes
-	// srule bevel_interpretation = "bevel";
-	// srule color_interpolation = "c_interp";
-	// srule dissolve_interpolation = "d_interp";
-	// srule level_of_detail = "lod";
-	// srule material_name = "usemtl";
-	// srule material_library = "mtllib";
-	// srule shadow_casting = "shadow_obj";
-	// srule ray_tracing = "trace_obj";
-	// srule curve_approximation_technique = "ctech";
-	// srule surface_approximation_technique = "stech";
-
-	ifstream in(fileName().c_str());
-	string str;
-	while(getline(in, str))
-		parse(str.c_str(), vertex_type | element | grouping | comment, space_p);
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, chunks.size(), 1 ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Chunk &chunk = chunks[i];
+
+				std::copy( chunk.verticesPerFace.begin(), chunk.verticesPerFace.end(), verticesPerFace.begin() + chunk.faceOffset );
+
+				fixRelativeIndices( chunk.vertexIds, chunk.relativeVertexIds, chunk.positionOffset );
+				fixRelativeIndices( chunk.textureCoordinateIds, chunk.relativeTextureCoordinateIds, chunk.textureCoordinateOffset );
+				fixRelativeIndices( chunk.normalIds, chunk.relativeNormalIds, chunk.normalOffset );
+
+				int *vertexIdsOut = vertexIds.data() + chunk.faceVertexOffset;
+				for( size_t j = 0, e = chunk.vertexIds.size(); j < e; ++j )
+				{
+					vertexIdsOut[j] = validIndex( chunk.vertexIds[j], numPositions, "vertex" );
+				}
+
+				if( haveTextureCoordinateIds )
+				{
+					float *sOut = s.data() + chunk.faceVertexOffset;
+					float *tOut = t.data() + chunk.faceVertexOffset;
+					for( size_t j = 0, e = chunk.textureCoordinateIds.size(); j < e; ++j )
+					{
+						const int index = chunk.textureCoordinateIds[j];
+						if( index == g_noIndex )
+						{
+							sOut[j] = tOut[j] = 0.0f;
+							continue;
+						}
+						const V3f &st = textureCoordinates[validIndex( index, numTextureCoordinates, "texture coordinate" )];
+						sOut[j] = st[0];
+						tOut[j] = st[1];
+					}
+				}
+
+				if( haveNormalIds )
+				{
+					V3f *normalsOut = faceVaryingNormals.data() + chunk.faceVertexOffset;
+					for( size_t j = 0, e = chunk.normalIds.size(); j < e; ++j )
+					{
+						const int index = chunk.normalIds[j];
+						normalsOut[j] = index == g_noIndex ? V3f( 0 ) : normals[validIndex( index, numNormals, "normal" )];
+					}
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	// create our MeshPrimitive
+	MeshPrimitivePtr mesh = new MeshPrimitive( verticesPerFaceData, vertexIdsData, "linear", positionsData );
+	if( haveTextureCoordinateIds )
+	{
+		mesh->variables["s"] = PrimitiveVariable( PrimitiveVariable::FaceVarying, sData );
+		mesh->variables["t"] = PrimitiveVariable( PrimitiveVariable::FaceVarying, tData );
+	}
+	if( haveNormalIds )
+	{
+		mesh->variables["N"] = PrimitiveVariable( PrimitiveVariable::FaceVarying, normalsData );
+	}
+	return mesh;
 }
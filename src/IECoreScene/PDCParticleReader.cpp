@@ -37,14 +37,20 @@
 #include "IECoreScene/ParticleReader.inl"
 
 #include "IECore/ByteOrder.h"
+#include "IECore/DeferredMessageHandler.h"
 #include "IECore/FileNameParameter.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/Timer.h"
 #include "IECore/VectorTypedData.h"
 
+#include "boost/iostreams/device/mapped_file.hpp"
+
+#include "tbb/tbb.h"
+
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <fstream>
 
 using namespace IECore;
@@ -55,22 +61,43 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( PDCParticleReader );
 
+namespace
+{
+
+// Minimum number of elements copied by each task in readElements().
+const size_t g_grainSize = 65536;
+
+// Reads a single value from the header, returning false if the
+// file is truncated.
+template<typename T>
+bool readValue( const char *data, size_t size, size_t &position, T &value )
+{
+	if( position + sizeof( value ) > size )
+	{
+		return false;
+	}
+	memcpy( &value, data + position, sizeof( value ) );
+	position += sizeof( value );
+	return true;
+}
+
+} // namespace
+
 const Reader::ReaderDescription<PDCParticleReader> PDCParticleReader::m_readerDescription( "pdc" );
 
 PDCParticleReader::PDCParticleReader( )
-	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( nullptr ), m_idAttribute( nullptr )
+	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_idAttribute( nullptr )
 {
 }
 
 PDCParticleReader::PDCParticleReader( const std::string &fileName )
-	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( nullptr ), m_idAttribute( nullptr )
+	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_idAttribute( nullptr )
 {
 	m_fileNameParameter->setTypedValue( fileName );
 }
 
 PDCParticleReader::~PDCParticleReader()
 {
-	delete m_iStream;
 }
 
 bool PDCParticleReader::canRead( const std::string &fileName )
@@ -91,27 +118,39 @@ bool PDCParticleReader::canRead( const std::string &fileName )
 
 bool PDCParticleReader::open()
 {
-	if( !m_iStream || m_streamFileName!=fileName() )
+	if( !m_file || m_streamFileName!=fileName() )
 	{
-		delete m_iStream;
-		m_iStream = new ifstream( fileName().c_str() );
-		if( !m_iStream->is_open() || !m_iStream->good() )
+		m_streamFileName = fileName();
+		m_idAttribute = nullptr;
+		m_header.valid = false;
+		m_header.attributes.clear();
+
+		m_file.reset( new boost::iostreams::mapped_file_source );
+		try
+		{
+			m_file->open( fileName() );
+		}
+		catch( const std::exception & )
 		{
 			return false;
 		}
 
+		const char *data = m_file->data();
+		const size_t size = m_file->size();
+		size_t position = 0;
+
 		char pdc[4];
-		m_iStream->read( pdc, 4 );
-		if( strncmp( "PDC ", pdc, 4 ) )
+		if( !readValue( data, size, position, pdc ) || strncmp( "PDC ", pdc, 4 ) )
 		{
-			m_header.valid = false;
 			return false;
 		}
 
-		m_iStream->read( (char *)&m_header.version, sizeof( m_header.version ) );
-
 		int endian = 0;
-		m_iStream->read( (char *)&endian, sizeof( endian ) );
+		if( !readValue( data, size, position, m_header.version ) || !readValue( data, size, position, endian ) )
+		{
+			return false;
+		}
+
 		if( endian!=1 )
 		{
 			m_header.reverseBytes = true;
@@ -128,84 +167,85 @@ bool PDCParticleReader::open()
 		}
 
 		int unused = 0;
-		m_iStream->read( (char *)&unused, sizeof( unused ) );
-		m_iStream->read( (char *)&unused, sizeof( unused ) );
-
-		m_iStream->read( (char *)&m_header.numParticles, sizeof( m_header.numParticles ) );
-		if( m_header.reverseBytes )
+		int numAttributes = 0;
+		if( !readValue( data, size, position, unused ) || !readValue( data, size, position, unused ) || !readValue( data, size, position, m_header.numParticles ) || !readValue( data, size, position, numAttributes ) )
 		{
-			m_header.numParticles = reverseBytes( m_header.numParticles );
+			return false;
 		}
 
-		int numAttributes;
-		m_iStream->read( (char *)&numAttributes, sizeof( numAttributes ) );
 		if( m_header.reverseBytes )
 		{
+			m_header.numParticles = reverseBytes( m_header.numParticles );
 			numAttributes = reverseBytes( numAttributes );
 		}
+
 		for( int i=0; i<numAttributes; i++ )
 		{
 			int nameLength;
-			m_iStream->read( (char *)&nameLength, sizeof( nameLength ) );
+			if( !readValue( data, size, position, nameLength ) )
+			{
+				return false;
+			}
 			if( m_header.reverseBytes )
 			{
 				nameLength = reverseBytes( nameLength );
 			}
-			string attrName; char c;
-			for( int j=0; j<nameLength; j++ )
+			if( nameLength < 0 || position + nameLength > size )
 			{
-				m_iStream->read( &c, 1 );
-				attrName += c;
+				return false;
 			}
+			string attrName( data + position, nameLength );
+			position += nameLength;
+
 			if( attrName=="ghostFrames" )
 			{
 				// alias' own pdc files don't match their own spec.
 				// they have a junk attributes on the end with no
 				// type and no data. it's called ghostframes and
-				// we need to skip it to prevent our stream from
-				// going bad.
+				// we need to skip it to prevent us from reading
+				// off the end of the file.
 				assert( i==numAttributes-1 ); // we're assuming the bad attribute is always the last one
 				continue;
 			}
 			Record r;
-			m_iStream->read( (char *)&r.type, sizeof( r.type ) );
+			if( !readValue( data, size, position, r.type ) )
+			{
+				return false;
+			}
 			if( m_header.reverseBytes )
 			{
 				r.type = reverseBytes( r.type );
 			}
-			r.position = m_iStream->tellg();
+			r.position = position;
 			m_header.attributes[attrName] = r;
 			switch( r.type )
 			{
 				case Integer :
-					m_iStream->seekg( sizeof( int ), ios_base::cur );
+					position += sizeof( int );
 					break;
 				case IntegerArray :
-					m_iStream->seekg( sizeof( int ) * m_header.numParticles, ios_base::cur );
+					position += sizeof( int ) * m_header.numParticles;
 					break;
 				case Double :
-					m_iStream->seekg( sizeof( double ), ios_base::cur );
+					position += sizeof( double );
 					break;
 				case DoubleArray :
-					m_iStream->seekg( sizeof( double ) * m_header.numParticles, ios_base::cur );
+					position += sizeof( double ) * m_header.numParticles;
 					break;
 				case Vector :
-					m_iStream->seekg( sizeof( double ) * 3, ios_base::cur );
+					position += sizeof( double ) * 3;
 					break;
 				case VectorArray :
-					m_iStream->seekg( sizeof( double ) * 3 * m_header.numParticles, ios_base::cur );
+					position += sizeof( double ) * 3 * m_header.numParticles;
 					break;
 				default :
 					assert( r.type < 6 ); // unknown type
 			}
-
 		}
 
-		m_header.valid = m_iStream->good();
-		m_streamFileName = fileName();
-		m_idAttribute = nullptr;
+		m_header.valid = position <= size;
 	}
-	return m_iStream->good() && m_header.valid;
+	return m_header.valid;
 }
 
 unsigned long PDCParticleReader::numParticles()
@@ -231,19 +271,42 @@ void PDCParticleReader::attributeNames( std::vector<std::string> &names )
 }
 
 template<typename T>
-void PDCParticleReader::readElements( T *buffer, std::streampos pos, unsigned long n ) const
+void PDCParticleReader::readElements( T *buffer, size_t pos, unsigned long n ) const
 {
-	m_iStream->seekg( pos );
-	m_iStream->read( (char *)buffer, n * sizeof( T ) );
-	if( m_header.reverseBytes )
-	{
-		for( unsigned long i=0; i<n; i++ )
+	const char *data = m_file->data() + pos;
+	assert( pos + n * sizeof( T ) <= m_file->size() );
+
+	// Copying from the mapped file in parallel allows the page
+	// faults to be serviced concurrently, and the byte reversal
+	// is a simple loop the compiler can vectorise.
+	const bool reverse = m_header.reverseBytes;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, n, g_grainSize ),
+		[buffer, data, reverse]( const tbb::blocked_range<size_t> &range )
 		{
-			*buffer = reverseBytes( *buffer );
-			buffer++;
-		}
+			T *b = buffer + range.begin();
+			memcpy( b, data + range.begin() * sizeof( T ), range.size() * sizeof( T ) );
+			if( reverse )
+			{
+				for( size_t i = 0, e = range.size(); i < e; ++i )
+				{
+					b[i] = reverseBytes( b[i] );
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
+const Data * PDCParticleReader::filteringIdAttribute()
+{
+	const Data *idAttr = idAttribute();
+	if ( !idAttr && particlePercentage() < 100.0f )
+	{
+		msg( Msg::Warning, "PDCParticleReader::filterAttr", format( "Percentage filtering requested but file \"%s\" contains no particle Id attribute." ) % fileName() );
 	}
-	assert( m_iStream->good() );
+	return idAttr;
 }
 
 DataPtr PDCParticleReader::readAttribute( const std::string &name )
@@ -259,34 +322,83 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		return nullptr;
 	}
 
-	const Data *idAttr = idAttribute();
-	if ( !idAttr && particlePercentage() < 100.0f )
+	return readRecord( it->second, filteringIdAttribute() );
+}
+
+void PDCParticleReader::readAttributes( const std::vector<std::string> &names, std::vector<IECore::DataPtr> &data )
+{
+	data.clear();
+	data.resize( names.size() );
+	if( !open() )
 	{
-		msg( Msg::Warning, "PDCParticleReader::filterAttr", format( "Percentage filtering requested but file \"%s\" contains no particle Id attribute." ) % fileName() );
+		return;
 	}
 
+	// Find the records and load the ids up front on this thread, so that
+	// the parallel reads below don't modify any state, and so that any
+	// warnings go to the current message handler.
+	vector<const Record *> records( names.size(), nullptr );
+	const Data *idAttr = nullptr;
+	for( size_t i = 0; i < names.size(); ++i )
+	{
+		map<string, Record>::const_iterator it = m_header.attributes.find( names[i] );
+		if( it != m_header.attributes.end() )
+		{
+			records[i] = &it->second;
+			idAttr = filteringIdAttribute();
+		}
+	}
+
+	// Filtering may emit warnings from the worker threads, so we collect
+	// them and output them on this thread once the reads are complete.
+	DeferredMessageHandlerPtr messageHandler = new DeferredMessageHandler;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, names.size(), 1 ),
+		[this, &records, &data, idAttr, &messageHandler]( const tbb::blocked_range<size_t> &range )
+		{
+			MessageHandler::Scope messageScope( messageHandler.get() );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				if( records[i] )
+				{
+					data[i] = readRecord( *records[i], idAttr );
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	messageHandler->flush();
+}
+
+DataPtr PDCParticleReader::readRecord( const Record &record, const Data *idAttr ) const
+{
+	const unsigned long numParticles = m_header.numParticles;
+
 	DataPtr result = nullptr;
-	switch( it->second.type )
+	switch( record.type )
 	{
 		case Integer :
 			{
 				IntDataPtr d( new IntData );
-				readElements( &d->writable(), it->second.position, 1 );
+				readElements( &d->writable(), record.position, 1 );
 				result = d;
 			}
 			break;
 		case IntegerArray :
 			{
 				IntVectorDataPtr d( new IntVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
+				d->writable().resize( numParticles );
+				readElements( d->writable().data(), record.position, numParticles );
 				result = filterAttr<IntVectorData, IntVectorData>( d.get(), particlePercentage(), idAttr );
 			}
 			break;
 		case Double :
 			{
 				DoubleDataPtr d( new DoubleData );
-				readElements( &d->writable(), it->second.position, 1 );
+				readElements( &d->writable(), record.position, 1 );
 				switch( realType() )
 				{
 					case PDCParticleReader::RealType::Native :
@@ -302,8 +414,8 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		case DoubleArray :
 			{
 				DoubleVectorDataPtr d( new DoubleVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
+				d->writable().resize( numParticles );
+				readElements( d->writable().data(), record.position, numParticles );
 				switch( realType() )
 				{
 					case PDCParticleReader::RealType::Native :
@@ -319,7 +431,7 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		case Vector :
 			{
 				V3dDataPtr d( new V3dData );
-				readElements( (double *)&d->writable(), it->second.position, 3 );
+				readElements( (double *)&d->writable(), record.position, 3 );
 				switch( realType() )
 				{
 					case PDCParticleReader::RealType::Native :
@@ -349,8 +461,8 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 				/// us, as they seem to be whenever we're coding in maya. testing seems to show that
 				/// this resize problem only occurs with V3d, and not with V3f, or double, or even
 				/// a struct with 3 doubles in, or even a template struct with 3 doubles in.
-				d->writable().resize( numParticles(), V3d( 0 ) );
-				readElements( (double *)&d->writable()[0], it->second.position, numParticles() * 3 );
+				d->writable().resize( numParticles, V3d( 0 ) );
+				readElements( (double *)d->writable().data(), record.position, numParticles * 3 );
 				switch( realType() )
 				{
 					case PDCParticleReader::RealType::Native :
@@ -364,7 +476,7 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			}
 			break;
 		default :
-			assert( it->second.type < 6 ); // unknown type
+			assert( record.type < 6 ); // unknown type
 
 	}
 	return result;
@@ -390,14 +502,14 @@ const Data * PDCParticleReader::idAttribute()
 			{
 				DoubleVectorDataPtr doubleVec = new DoubleVectorData;
 				doubleVec->writable().resize( numParticles() );
-				readElements( &doubleVec->writable()[0], it->second.position, numParticles() );
+				readElements( doubleVec->writable().data(), it->second.position, numParticles() );
 				m_idAttribute = doubleVec;
 			}
 			if( it->second.type==IntegerArray )
 			{
 				IntVectorDataPtr intVec = new IntVectorData;
 				intVec->writable().resize( numParticles() );
-				readElements( &intVec->writable()[0], it->second.position, numParticles() );
+				readElements( intVec->writable().data(), it->second.position, numParticles() );
 				m_idAttribute = intVec;
 			}
 		}
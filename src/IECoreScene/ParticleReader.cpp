@@ -166,9 +166,11 @@ ObjectPtr ParticleReader::doOperation( const CompoundObject * operands )
 	// we start off with numParticles() in case there aren't any varying attributes in the cache at all, but replace it
 	// below as soon as we have a revised (percentage filtered) value.
 	bool haveNumPoints = false;
+	vector<DataPtr> attributeData;
+	readAttributes( attributes, attributeData );
 	for( vector<string>::const_iterator it = attributes.begin(); it!=attributes.end(); it++ )
 	{
-		DataPtr d = readAttribute( *it );
+		DataPtr d = attributeData[it - attributes.begin()];
 
 		if ( testTypedData<TypeTraits::IsVectorTypedData>( d.get() ) )
 		{
@@ -201,6 +203,16 @@ ObjectPtr ParticleReader::doOperation( const CompoundObject * operands )
 	return result;
 }
 
+void ParticleReader::readAttributes( const std::vector<std::string> &names, std::vector<IECore::DataPtr> &data )
+{
+	data.clear();
+	data.reserve( names.size() );
+	for( vector<string>::const_iterator it = names.begin(); it!=names.end(); it++ )
+	{
+		data.push_back( readAttribute( *it ) );
+	}
+}
+
 float ParticleReader::particlePercentage() const
 {
 	return m_percentageParameter->getNumericValue();
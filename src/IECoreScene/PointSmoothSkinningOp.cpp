@@ -50,6 +50,9 @@
 #include "IECore/VectorOps.h"
 #include "IECore/VectorTypedData.h"
 
+#include "OpenEXR/ImathMatrixAlgo.h"
+#include "OpenEXR/ImathQuat.h"
+
 #include "boost/format.hpp"
 
 #include "tbb/tbb.h"
@@ -98,12 +101,13 @@ PointSmoothSkinningOp::PointSmoothSkinningOp() :
 
 	IntParameter::PresetsContainer blendPresets;
 	blendPresets.push_back( IntParameter::Preset( "Linear", Linear ) );
+	blendPresets.push_back( IntParameter::Preset( "DualQuaternion", DualQuaternion ) );
 	m_blendParameter = new IntParameter(
 	        "blend",
 	        "Blending algorithm used to deform the mesh.",
 	        Linear,
 	        Linear,
-	        Linear,
+	        DualQuaternion,
 	        blendPresets,
 	        true
 	);
@@ -206,116 +210,340 @@ const IntVectorParameter * PointSmoothSkinningOp::refIndicesParameter() const
 	return m_refIndicesParameter.get();
 }
 
-struct PointSmoothSkinningOp::DeformPositions
+namespace
 {
+
+// Blends the skinning matrices linearly. Each matrix is stored as the 3x3
+// linear part followed by the translation, so that blending is a single
+// loop over 12 floats which the compiler can vectorise, and the blended
+// transform only needs to be applied once per point.
+class LinearBlend
+{
+
 	public :
 
-		DeformPositions( std::vector<V3f> &p_data, const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<float> &pointInfluenceWeights, const std::vector<M44f> &skin_data, const std::vector<int> &refId_data )
-			:	m_pData( p_data ), m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_pointInfluenceWeights( pointInfluenceWeights ), m_skinData(skin_data), m_refIdData(refId_data)
+		struct Transform
 		{
-		}
+			float m[12];
+		};
 
-		void operator()( const tbb::blocked_range<size_t> &r ) const
+		LinearBlend( const std::vector<M44f> &matrices )
+			:	m_transforms( matrices.size() )
 		{
-			for( size_t p_it=r.begin(); p_it!=r.end(); ++p_it )
+			for( size_t i = 0; i < matrices.size(); ++i )
 			{
-				V3f p_new(0,0,0);
-
-				V3f &p_value = m_pData[p_it];
-				int p_id;
-				if( m_refIdData.size() )
-				{
-					// get the actual index to look up in the smooth skinning data
-					p_id = m_refIdData[p_it];
-				}
-				else
+				float *t = m_transforms[i].m;
+				for( int r = 0; r < 4; ++r )
 				{
-					p_id = p_it;
+					for( int c = 0; c < 3; ++c )
+					{
+						t[r*3+c] = matrices[i][r][c];
+					}
 				}
+			}
+		}
 
-				int p_influence_count = m_pointInfluenceCounts[p_id];
-				int p_index_offset = m_pointIndexOffsets[p_id];
-
-				for (int p_influence_id = p_index_offset; p_influence_id < (p_index_offset+p_influence_count);
-						p_influence_id++)
+		void blend( const int *indices, const float *weights, int count, Transform &result ) const
+		{
+			std::fill( result.m, result.m + 12, 0.0f );
+			for( int i = 0; i < count; ++i )
+			{
+				const float *t = m_transforms[indices[i]].m;
+				const float w = weights[i];
+				for( int j = 0; j < 12; ++j )
 				{
-					int influence_id = m_pointInfluenceIndices[p_influence_id];
-					float weight = m_pointInfluenceWeights[p_influence_id];
-					p_new += p_value * m_skinData[influence_id] * weight;
+					result.m[j] += t[j] * w;
 				}
-				p_value = p_new;
 			}
 		}
 
+		static V3f transformPoint( const Transform &t, const V3f &p )
+		{
+			return V3f(
+				p.x * t.m[0] + p.y * t.m[3] + p.z * t.m[6] + t.m[9],
+				p.x * t.m[1] + p.y * t.m[4] + p.z * t.m[7] + t.m[10],
+				p.x * t.m[2] + p.y * t.m[5] + p.z * t.m[8] + t.m[11]
+			);
+		}
+
+		static V3f transformNormal( const Transform &t, const V3f &n )
+		{
+			return V3f(
+				n.x * t.m[0] + n.y * t.m[3] + n.z * t.m[6],
+				n.x * t.m[1] + n.y * t.m[4] + n.z * t.m[7],
+				n.x * t.m[2] + n.y * t.m[5] + n.z * t.m[8]
+			);
+		}
+
 	private :
 
-		std::vector<V3f> &m_pData;
-		const std::vector<int> &m_pointIndexOffsets;
-		const std::vector<int> &m_pointInfluenceCounts;
-		const std::vector<int> &m_pointInfluenceIndices;
-		const std::vector<float> &m_pointInfluenceWeights;
-		const std::vector<M44f> &m_skinData;
-		const std::vector<int> &m_refIdData;
+		std::vector<Transform> m_transforms;
 
 };
 
-struct PointSmoothSkinningOp::DeformNormals
+// Blends the rotation and translation of the skinning matrices as unit
+// dual quaternions. Each is stored as the real part ( r, x, y, z ) followed
+// by the dual part ( r, x, y, z ).
+class DualQuaternionBlend
 {
+
 	public :
 
-		DeformNormals( std::vector<V3f> &n_data, const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<float> &pointInfluenceWeights, const std::vector<M44f> &skin_data, const std::vector<int> &refId_data, std::vector<int> &vertexIndicesData )
-			:	m_nData( n_data ), m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_pointInfluenceWeights( pointInfluenceWeights ), m_skinData(skin_data), m_refIdData(refId_data), m_vertexIndicesData( vertexIndicesData )
+		struct Transform
+		{
+			float q[8];
+		};
+
+		DualQuaternionBlend( const std::vector<M44f> &matrices )
+			:	m_transforms( matrices.size() )
 		{
+			for( size_t i = 0; i < matrices.size(); ++i )
+			{
+				M44f rotationMatrix = matrices[i];
+				removeScalingAndShear( rotationMatrix, false );
+				const Quatf q = extractQuat( rotationMatrix ).normalized();
+				const V3f t = matrices[i].translation();
+
+				float *d = m_transforms[i].q;
+				d[0] = q.r;
+				d[1] = q.v.x;
+				d[2] = q.v.y;
+				d[3] = q.v.z;
+
+				const V3f dv = 0.5f * ( q.r * t + ( t % q.v ) );
+				d[4] = -0.5f * ( t ^ q.v );
+				d[5] = dv.x;
+				d[6] = dv.y;
+				d[7] = dv.z;
+			}
 		}
 
-		void operator()( const tbb::blocked_range<size_t> &r ) const
+		void blend( const int *indices, const float *weights, int count, Transform &result ) const
 		{
-			for( size_t n_it=r.begin(); n_it!=r.end(); ++n_it )
+			std::fill( result.q, result.q + 8, 0.0f );
+			if( !count )
+			{
+				result.q[0] = 1.0f;
+				return;
+			}
+
+			// q and -q represent the same rotation, so we flip each quaternion
+			// into the same hemisphere as the first to take the shortest path.
+			const float *pivot = m_transforms[indices[0]].q;
+			for( int i = 0; i < count; ++i )
+			{
+				const float *d = m_transforms[indices[i]].q;
+				const float dot = d[0] * pivot[0] + d[1] * pivot[1] + d[2] * pivot[2] + d[3] * pivot[3];
+				const float w = dot < 0.0f ? -weights[i] : weights[i];
+				for( int j = 0; j < 8; ++j )
+				{
+					result.q[j] += d[j] * w;
+				}
+			}
+
+			const float length = sqrtf( result.q[0] * result.q[0] + result.q[1] * result.q[1] + result.q[2] * result.q[2] + result.q[3] * result.q[3] );
+			if( length == 0.0f )
 			{
-				V3f n_new(0,0,0);
+				std::fill( result.q, result.q + 8, 0.0f );
+				result.q[0] = 1.0f;
+				return;
+			}
+
+			const float scale = 1.0f / length;
+			for( int j = 0; j < 8; ++j )
+			{
+				result.q[j] *= scale;
+			}
+		}
+
+		static V3f transformPoint( const Transform &t, const V3f &p )
+		{
+			const V3f v( t.q[1], t.q[2], t.q[3] );
+			const V3f dv( t.q[5], t.q[6], t.q[7] );
+			const V3f translation = 2.0f * ( t.q[0] * dv - t.q[4] * v + ( v % dv ) );
+			return rotate( t, p ) + translation;
+		}
+
+		static V3f transformNormal( const Transform &t, const V3f &n )
+		{
+			return rotate( t, n );
+		}
+
+	private :
+
+		static V3f rotate( const Transform &t, const V3f &p )
+		{
+			const V3f v( t.q[1], t.q[2], t.q[3] );
+			const V3f c = 2.0f * ( v % p );
+			return p + t.q[0] * c + ( v % c );
+		}
+
+		std::vector<Transform> m_transforms;
+
+};
+
+} // namespace
+
+// The influences for each point of the primitive being deformed, with the
+// reference indices already applied and zero weights removed, stored
+// contiguously in point order.
+struct PointSmoothSkinningOp::InfluenceWeights
+{
+
+	InfluenceWeights( const SmoothSkinningData *ssd, const IntVectorData *refIdData )
+		:	smoothSkinningData( ssd->copy() ), referenceIndices( refIdData->copy() )
+	{
+		const std::vector<int> &pointIndexOffsets = ssd->pointIndexOffsets()->readable();
+		const std::vector<int> &pointInfluenceCounts = ssd->pointInfluenceCounts()->readable();
+		const std::vector<int> &pointInfluenceIndices = ssd->pointInfluenceIndices()->readable();
+		const std::vector<float> &pointInfluenceWeights = ssd->pointInfluenceWeights()->readable();
+		const std::vector<int> &refIds = refIdData->readable();
 
-				V3f &n_value = m_nData[n_it];
-				V3f n_unw;
+		const size_t numPoints = refIds.size() ? refIds.size() : pointInfluenceCounts.size();
+		const int numSSDPoints = pointInfluenceCounts.size();
 
-				int n_id = n_it;
+		offsets.resize( numPoints + 1, 0 );
 
-				if( m_vertexIndicesData.size() )
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, numPoints ),
+			[&]( const tbb::blocked_range<size_t> &r ) {
+				for( size_t i = r.begin(); i != r.end(); ++i )
 				{
-					n_id = m_vertexIndicesData[n_id];
+					const int id = refIds.size() ? refIds[i] : i;
+					if( id < 0 || id >= numSSDPoints )
+					{
+						throw InvalidArgumentException( boost::str( boost::format( "Reference index %d is out of range for SmoothSkinningData with %d points" ) % id % numSSDPoints ) );
+					}
+					int count = 0;
+					for( int j = pointIndexOffsets[id], e = j + pointInfluenceCounts[id]; j < e; ++j )
+					{
+						count += pointInfluenceWeights[j] != 0.0f;
+					}
+					offsets[i+1] = count;
 				}
-				if( m_refIdData.size() )
+			},
+			taskGroupContext
+		);
+
+		for( size_t i = 0; i < numPoints; ++i )
+		{
+			offsets[i+1] += offsets[i];
+		}
+
+		indices.resize( offsets.back() );
+		weights.resize( offsets.back() );
+
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, numPoints ),
+			[&]( const tbb::blocked_range<size_t> &r ) {
+				for( size_t i = r.begin(); i != r.end(); ++i )
 				{
-					n_id = m_refIdData[n_id];
+					const int id = refIds.size() ? refIds[i] : i;
+					int k = offsets[i];
+					for( int j = pointIndexOffsets[id], e = j + pointInfluenceCounts[id]; j < e; ++j )
+					{
+						if( pointInfluenceWeights[j] != 0.0f )
+						{
+							indices[k] = pointInfluenceIndices[j];
+							weights[k++] = pointInfluenceWeights[j];
+						}
+					}
 				}
+			},
+			taskGroupContext
+		);
+	}
 
-				int n_influence_count = m_pointInfluenceCounts[n_id];
-				int n_index_offset = m_pointIndexOffsets[n_id];
+	bool matches( const SmoothSkinningData *otherSmoothSkinningData, const IntVectorData *otherReferenceIndices ) const
+	{
+		// These comparisons are cheap in the common case of reusing the same data,
+		// because the copies we hold share the underlying arrays.
+		return referenceIndices->isEqualTo( otherReferenceIndices ) && smoothSkinningData->isEqualTo( otherSmoothSkinningData );
+	}
 
-				for (int n_influence_id = n_index_offset; n_influence_id < (n_index_offset+n_influence_count);
-						n_influence_id++)
-				{
-					int influence_id = m_pointInfluenceIndices[n_influence_id];
-					float weight = m_pointInfluenceWeights[n_influence_id];
+	template<typename Blend>
+	void blend( const Blend &b, size_t point, typename Blend::Transform &transform ) const
+	{
+		const int offset = offsets[point];
+		b.blend( indices.data() + offset, weights.data() + offset, offsets[point+1] - offset, transform );
+	}
+
+	ConstSmoothSkinningDataPtr smoothSkinningData;
+	ConstIntVectorDataPtr referenceIndices;
+
+	std::vector<int> offsets;
+	std::vector<int> indices;
+	std::vector<float> weights;
 
-					m_skinData[influence_id].multDirMatrix(n_value,n_unw);
-					n_new += n_unw * weight;
+};
+
+namespace
+{
+
+// Deforms the positions, and optionally the normals, of each point using a
+// single blended transform per point.
+template<typename Blend, typename Weights>
+void deformPoints( const Blend &blend, const Weights &weights, std::vector<V3f> &positions, std::vector<V3f> *normals )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, positions.size() ),
+		[&]( const tbb::blocked_range<size_t> &r ) {
+			typename Blend::Transform transform;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				weights.blend( blend, i, transform );
+				positions[i] = Blend::transformPoint( transform, positions[i] );
+				if( normals )
+				{
+					(*normals)[i] = Blend::transformNormal( transform, (*normals)[i] );
 				}
-				n_value = n_new;
 			}
-		}
+		},
+		taskGroupContext
+	);
+}
 
-	private :
+// Deforms normals which are not stored per point, using `vertexIds` to map
+// from each normal to its point if provided.
+template<typename Blend, typename Weights>
+void deformNormals( const Blend &blend, const Weights &weights, std::vector<V3f> &normals, const std::vector<int> *vertexIds )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, normals.size() ),
+		[&]( const tbb::blocked_range<size_t> &r ) {
+			typename Blend::Transform transform;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				weights.blend( blend, vertexIds ? (*vertexIds)[i] : i, transform );
+				normals[i] = Blend::transformNormal( transform, normals[i] );
+			}
+		},
+		taskGroupContext
+	);
+}
 
-		std::vector<V3f> &m_nData;
-		const std::vector<int> &m_pointIndexOffsets;
-		const std::vector<int> &m_pointInfluenceCounts;
-		const std::vector<int> &m_pointInfluenceIndices;
-		const std::vector<float> &m_pointInfluenceWeights;
-		const std::vector<M44f> &m_skinData;
-		const std::vector<int> &m_refIdData;
-		const std::vector<int> &m_vertexIndicesData;
+template<typename Blend, typename Weights>
+void deform( const std::vector<M44f> &skinningMatrices, const Weights &weights, std::vector<V3f> &positions, std::vector<V3f> *normals, const std::vector<int> *normalVertexIds )
+{
+	const Blend blend( skinningMatrices );
+	if( normals && !normalVertexIds && normals->size() == positions.size() )
+	{
+		deformPoints( blend, weights, positions, normals );
+	}
+	else
+	{
+		deformPoints( blend, weights, positions, nullptr );
+		if( normals )
+		{
+			deformNormals( blend, weights, *normals, normalVertexIds );
+		}
+	}
+}
 
-};
+} // namespace
 
 void PointSmoothSkinningOp::modify( Object *input, const CompoundObject *operands )
 {
@@ -328,7 +556,8 @@ void PointSmoothSkinningOp::modify( Object *input, const CompoundObject *operand
     string normal_var = operands->member<StringData>( "normalVar" )->readable();
     SmoothSkinningDataPtr ssd = smoothSkinningDataParameter()->getTypedValue< SmoothSkinningData >( );
 	M44fVectorDataPtr def = runTimeCast<M44fVectorData>(deformationPoseParameter()->getValue( ));
-	const std::vector<int> &refId_data = operands->member<IntVectorData>( "referenceIndices" )->readable();
+	const IntVectorData *refIds = operands->member<IntVectorData>( "referenceIndices" );
+	const std::vector<int> &refId_data = refIds->readable();
 
 	// verify position and normal data
     if ( pt->variables.count(position_var)==0 )
@@ -376,16 +605,19 @@ void PointSmoothSkinningOp::modify( Object *input, const CompoundObject *operand
 		throw InvalidArgumentException( "Number of elements in SmoothSkinningData.influencePose does not match number of elements in deformationPose given to PointSmoothSkinningOp" );
 	}
 
-	// check if the smooth skinning data has changed since the last time the op was used;
-	// validating the ssd can be expensive and unnecessary for the case that the ssd is not changing
-	// so we are storing an internal copy of the ssd as a comparison is much faster than a complete validation
-	if ( ssd != m_prevSmoothSkinningData )
+	// check if the smooth skinning data or reference indices have changed since the last time
+	// the op was used; validating the ssd and rearranging the weights is unnecessary when
+	// deforming the same rig repeatedly, so we keep the results from last time and reuse them
+	if ( !m_influenceWeights || !m_influenceWeights->matches( ssd.get(), refIds ) )
 	{
+		m_influenceWeights.reset();
 		ssd->validate();
-		m_prevSmoothSkinningData = ssd;
+		m_influenceWeights.reset( new InfluenceWeights( ssd.get(), refIds ) );
 	}
 
 	// test n data
+	std::vector<V3f> *n_data = nullptr;
+	const std::vector<int> *n_vertexIds = nullptr;
 	if ( deform_n )
 	{
 		PrimitiveVariableMap::const_iterator it = pt->variables.find(normal_var);
@@ -395,19 +627,28 @@ void PointSmoothSkinningOp::modify( Object *input, const CompoundObject *operand
 			{
 				throw Exception("Normal variable on primitive is invalid!");
 			}
+			V3fVectorData *n = pt->variableData<V3fVectorData>(normal_var);
+			if( !n )
+			{
+				throw Exception("Could not get normal data from primitive!");
+			}
 			if (it->second.interpolation == PrimitiveVariable::FaceVarying )
 			{
 				MeshPrimitive *mesh = dynamic_cast<MeshPrimitive *>( pt );
 				if( !mesh )
 				{
-					V3fVectorData *n = pt->variableData<V3fVectorData>(normal_var);
 					int n_size = n->readable().size();
 					if ( p_size != n_size )
 					{
 						throw Exception("Position and normal variables must be the same length!");
 					}
 				}
+				else
+				{
+					n_vertexIds = &mesh->vertexIds()->readable();
+				}
 			}
+			n_data = &n->writable();
 		}
 		else
 		{
@@ -432,63 +673,18 @@ void PointSmoothSkinningOp::modify( Object *input, const CompoundObject *operand
 		++ip_it;
 	}
 
-
 	// iterate through all the points in the source primitive and deform using the weighted skinning matrices
-	if ( blend == Linear )
-	{
-		const std::vector<int> &pointIndexOffsets = ssd->pointIndexOffsets()->readable();
-		const std::vector<int> &pointInfluenceCounts = ssd->pointInfluenceCounts()->readable();
-		const std::vector<int> &pointInfluenceIndices = ssd->pointInfluenceIndices()->readable();
-		const std::vector<float> &pointInfluenceWeights = ssd->pointInfluenceWeights()->readable();
-
-		// deform our P
-		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
-		tbb::parallel_for(
-			tbb::blocked_range<size_t>( 0, p_size ),
-			DeformPositions( p_data, pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, pointInfluenceWeights, skin_data, refId_data ),
-			taskGroupContext
-		);
-
-		// deform our N
-		if ( deform_n )
-		{
-			PrimitiveVariableMap::const_iterator it = pt->variables.find(normal_var);
-			if ( it != pt->variables.end() )
-			{
-				V3fVectorData *n = pt->variableData<V3fVectorData>(normal_var);
-				std::vector<V3f> &n_data =  n->writable();
-
-				std::vector<int> vertexIndicesData;
-				if (it->second.interpolation == PrimitiveVariable::FaceVarying )
-				{
-					MeshPrimitive *mesh = dynamic_cast<MeshPrimitive *>( pt );
-					if( mesh )
-					{
-						vertexIndicesData = mesh->vertexIds()->readable();
-					}
-				}
-
-				tbb::parallel_for(
-					tbb::blocked_range<size_t>( 0, n_data.size() ),
-					DeformNormals(
-						n_data,
-						pointIndexOffsets,
-						pointInfluenceCounts,
-						pointInfluenceIndices,
-						pointInfluenceWeights,
-						skin_data,
-						refId_data,
-						vertexIndicesData
-					),
-					taskGroupContext
-				);
-			}
-        }
-	}
-	else
+	switch( blend )
 	{
-		// this should never happen
-		assert(0);
+		case Linear :
+			deform<LinearBlend>( skin_data, *m_influenceWeights, p_data, n_data, n_vertexIds );
+			break;
+		case DualQuaternion :
+			deform<DualQuaternionBlend>( skin_data, *m_influenceWeights, p_data, n_data, n_vertexIds );
+			break;
+		default :
+			// this should never happen
+			assert(0);
 	}
 
 }
@@ -39,6 +39,10 @@
 #include "IECore/Exception.h"
 #include "IECore/SimpleTypedData.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -46,6 +50,31 @@ using namespace IECoreScene;
 
 IE_CORE_DEFINERUNTIMETYPED( PointsPrimitiveEvaluator );
 
+namespace
+{
+
+void convertNeighbours( const std::vector<V3f> &points, const std::vector<size_t> &offsets, const std::vector<V3fTree::Neighbour> &neighbours, std::vector<int> &offsetsOut, std::vector<int> &pointIndices, std::vector<float> &distances )
+{
+	offsetsOut.assign( offsets.begin(), offsets.end() );
+	pointIndices.resize( neighbours.size() );
+	distances.resize( neighbours.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, neighbours.size() ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				pointIndices[i] = neighbours[i].point - points.begin();
+				distances[i] = sqrtf( neighbours[i].distSquared );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+} // namespace
+
 PrimitiveEvaluator::Description<PointsPrimitiveEvaluator> PointsPrimitiveEvaluator::g_evaluatorDescription;
 
 //////////////////////////////////////////////////////////////////////////
@@ -250,6 +279,26 @@ int PointsPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, cons
 	throw NotImplementedException( __PRETTY_FUNCTION__ );
 }
 
+void PointsPrimitiveEvaluator::batchNearestNNeighbours( const Imath::V3f *points, size_t numPoints, unsigned int numNeighbours, std::vector<int> &offsets, std::vector<int> &pointIndices, std::vector<float> &distances ) const
+{
+	const_cast<PointsPrimitiveEvaluator *>( this )->buildTree();
+
+	std::vector<size_t> neighbourOffsets;
+	std::vector<V3fTree::Neighbour> neighbours;
+	m_tree.batchNearestNNeighbours( points, points + numPoints, numNeighbours, neighbourOffsets, neighbours );
+	convertNeighbours( *m_pVector, neighbourOffsets, neighbours, offsets, pointIndices, distances );
+}
+
+void PointsPrimitiveEvaluator::batchPointsInRadius( const Imath::V3f *points, size_t numPoints, float radius, std::vector<int> &offsets, std::vector<int> &pointIndices, std::vector<float> &distances ) const
+{
+	const_cast<PointsPrimitiveEvaluator *>( this )->buildTree();
+
+	std::vector<size_t> neighbourOffsets;
+	std::vector<V3fTree::Neighbour> neighbours;
+	m_tree.batchNearestNeighbours( points, points + numPoints, radius, neighbourOffsets, neighbours );
+	convertNeighbours( *m_pVector, neighbourOffsets, neighbours, offsets, pointIndices, distances );
+}
+
 void PointsPrimitiveEvaluator::buildTree()
 {
 	if( m_haveTree )
@@ -264,6 +313,13 @@ void PointsPrimitiveEvaluator::buildTree()
 		return;
 	}
 
-	m_tree.init( m_pVector->begin(), m_pVector->end() );
+	// Large trees are built in parallel. Isolation prevents this thread
+	// from picking up unrelated tasks while it waits, as they could need
+	// the same lock.
+	tbb::this_task_arena::isolate(
+		[this] {
+			m_tree.init( m_pVector->begin(), m_pVector->end() );
+		}
+	);
 	m_haveTree = true;
 }
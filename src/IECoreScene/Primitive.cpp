@@ -40,6 +40,7 @@
 #include "IECore/VectorTypedData.h"
 
 #include "boost/algorithm/string.hpp"
+#include "boost/optional.hpp"
 
 #include <cassert>
 
@@ -330,6 +331,42 @@ void convertLegacyVariables( PrimitiveVariableMap &variables )
 	}
 }
 
+// Loads the named variables, skipping any that don't exist. Templated
+// on the context type only because Object::LoadContext is protected.
+template<typename LoadContext>
+void loadVariables( LoadContext *context, const IndexedIO *ioVariables, const IndexedIO::EntryIDList &names, PrimitiveVariableMap &variables )
+{
+	std::vector<boost::optional<PrimitiveVariable>> loaded( names.size() );
+	context->parallelLoad(
+		names.size(),
+		[context, ioVariables, &names, &loaded]( size_t n ) {
+			ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( names[n], IndexedIO::NullIfMissing );
+			if ( !ioPrimVar )
+			{
+				return;
+			}
+			int i;
+			ioPrimVar->read( g_interpolationEntry, i );
+
+			IntVectorDataPtr indices = nullptr;
+			if( ioPrimVar->hasEntry( g_indicesEntry ) )
+			{
+				indices = context->template loadLazily<IntVectorData>( ioPrimVar.get(), g_indicesEntry );
+			}
+
+			loaded[n] = PrimitiveVariable( (PrimitiveVariable::Interpolation)i, context->template loadLazily<Data>( ioPrimVar.get(), g_dataEntry ), indices );
+		}
+	);
+
+	for( size_t n = 0, e = names.size(); n < e; ++n )
+	{
+		if( loaded[n] )
+		{
+			variables.insert( PrimitiveVariableMap::value_type( names[n], *loaded[n] ) );
+		}
+	}
+}
+
 } // namespace
 
 void Primitive::load( IECore::Object::LoadContextPtr context )
@@ -352,23 +389,7 @@ void Primitive::load( IECore::Object::LoadContextPtr context )
 	variables.clear();
 	IndexedIO::EntryIDList names;
 	ioVariables->entryIds( names, IndexedIO::Directory );
-	IndexedIO::EntryIDList::const_iterator it;
-	for( it=names.begin(); it!=names.end(); it++ )
-	{
-		ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( *it );
-		int i;
-		ioPrimVar->read( g_interpolationEntry, i );
-
-		IntVectorDataPtr indices = nullptr;
-		if( ioPrimVar->hasEntry( g_indicesEntry ) )
-		{
-			indices = context->load<IntVectorData>( ioPrimVar.get(), g_indicesEntry );
-		}
-
-		variables.insert(
-			PrimitiveVariableMap::value_type( *it, PrimitiveVariable( (PrimitiveVariable::Interpolation)i, context->load<Data>( ioPrimVar.get(), g_dataEntry ), indices ) )
-		);
-	}
+	loadVariables( context.get(), ioVariables.get(), names, variables );
 
 	if( v < 2 )
 	{
@@ -401,26 +422,7 @@ PrimitiveVariableMap Primitive::loadPrimitiveVariables( const IndexedIO *ioInter
 	}
 
 	PrimitiveVariableMap variables;
-	for( const auto &name : names )
-	{
-		ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( name, IndexedIO::NullIfMissing );
-		if ( !ioPrimVar )
-		{
-			continue;
-		}
-		int i;
-		ioPrimVar->read( g_interpolationEntry, i );
-
-		IntVectorDataPtr indices = nullptr;
-		if( ioPrimVar->hasEntry( g_indicesEntry ) )
-		{
-			indices = context->load<IntVectorData>( ioPrimVar.get(), g_indicesEntry );
-		}
-
-		variables.insert(
-			PrimitiveVariableMap::value_type( name, PrimitiveVariable( (PrimitiveVariable::Interpolation)i, context->load<Data>( ioPrimVar.get(), g_dataEntry ), indices ) )
-		);
-	}
+	loadVariables( context.get(), ioVariables.get(), names, variables );
 
 	if( v < 2 )
 	{
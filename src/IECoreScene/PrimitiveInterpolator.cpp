@@ -32,10 +32,15 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "IECoreScene/Primitive.h"
+#include "IECoreScene/PrimitiveInterpolator.h"
 
 #include "IECore/DataAlgo.h"
+#include "IECore/Interpolator.h"
 #include "IECore/ObjectInterpolator.h"
+#include "IECore/TypeTraits.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -43,27 +48,182 @@ using namespace IECoreScene;
 namespace
 {
 
-PrimitivePtr interpolatePrimitive( const Primitive *y0, const Primitive *y1, double x )
+// Identifies the types which are stored as contiguous arrays of floating
+// point components, and which are interpolated component by component.
+// Arrays of these types can be interpolated by a simple loop over the
+// components, which the compiler can vectorise. ParameterType matches the
+// type used by the generic LinearInterpolator, so that results are identical.
+template<typename T>
+struct LerpTraits
+{
+	static const bool flat = false;
+};
+
+template<>
+struct LerpTraits<float>
+{
+	static const bool flat = true;
+	typedef float ComponentType;
+	typedef double ParameterType;
+};
+
+template<>
+struct LerpTraits<double>
+{
+	static const bool flat = true;
+	typedef double ComponentType;
+	typedef double ParameterType;
+};
+
+template<typename T>
+struct CompoundLerpTraits
+{
+	static const bool flat = std::is_floating_point<T>::value;
+	typedef T ComponentType;
+	typedef T ParameterType;
+};
+
+template<typename T>
+struct LerpTraits<Imath::Vec2<T>> : public CompoundLerpTraits<T> {};
+
+template<typename T>
+struct LerpTraits<Imath::Vec3<T>> : public CompoundLerpTraits<T> {};
+
+template<typename T>
+struct LerpTraits<Imath::Color3<T>> : public CompoundLerpTraits<T> {};
+
+template<typename T>
+struct LerpTraits<Imath::Color4<T>> : public CompoundLerpTraits<T> {};
+
+// Arrays smaller than this are interpolated serially.
+const size_t g_minParallelSize = 10000;
+
+template<typename C, typename P>
+void lerp( const C *y0, const C *y1, P x, size_t size, C *result )
 {
-	if(
-		y0->variableSize( PrimitiveVariable::Uniform ) != y1->variableSize( PrimitiveVariable::Uniform ) ||
-		y0->variableSize( PrimitiveVariable::Varying ) != y1->variableSize( PrimitiveVariable::Varying ) ||
-		y0->variableSize( PrimitiveVariable::Vertex ) != y1->variableSize( PrimitiveVariable::Vertex ) ||
-		y0->variableSize( PrimitiveVariable::FaceVarying ) != y1->variableSize( PrimitiveVariable::FaceVarying )
-	)
+	auto f = [y0, y1, x, result]( const tbb::blocked_range<size_t> &range ) {
+		for( size_t i = range.begin(); i != range.end(); ++i )
+		{
+			result[i] = static_cast<C>( y0[i] + ( y1[i] - y0[i] ) * x );
+		}
+	};
+
+	if( size < g_minParallelSize )
+	{
+		f( tbb::blocked_range<size_t>( 0, size ) );
+	}
+	else
+	{
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, size ), f, taskGroupContext );
+	}
+}
+
+struct IsInterpolable
+{
+
+	template<typename T>
+	bool operator()( const T *data, typename std::enable_if<TypeTraits::IsStrictlyInterpolable<T>::value>::type *enabler = nullptr ) const
+	{
+		return true;
+	}
+
+	bool operator()( const Data *data ) const
+	{
+		return false;
+	}
+
+};
+
+// Interpolates into `reusable` if it is of the right type and
+// we are its only owner, and otherwise into new data.
+struct DataInterpolator
+{
+
+	DataInterpolator( const Data *y1, double x, Data *reusable )
+		:	m_y1( y1 ), m_x( x ), m_reusable( reusable )
+	{
+	}
+
+	template<typename T>
+	DataPtr operator()( const T *y0, typename std::enable_if<TypeTraits::IsStrictlyInterpolable<T>::value>::type *enabler = nullptr ) const
+	{
+		typename T::Ptr result = runTimeCast<T>( m_reusable );
+		if( !result || result->refCount() > 2 )
+		{
+			// Reference count of 2 accounts for `result` itself and
+			// the map of reusable variables.
+			result = new T;
+		}
+
+		interpolate( y0, static_cast<const T *>( m_y1 ), result.get() );
+		return result;
+	}
+
+	DataPtr operator()( const Data *y0 ) const
 	{
 		return nullptr;
 	}
 
-	PrimitivePtr result = y0->copy();
+	private :
+
+		template<typename T>
+		void interpolate( const TypedData<std::vector<T>> *y0, const TypedData<std::vector<T>> *y1, TypedData<std::vector<T>> *result, typename std::enable_if<LerpTraits<T>::flat>::type *enabler = nullptr ) const
+		{
+			typedef typename LerpTraits<T>::ComponentType ComponentType;
+			typedef typename LerpTraits<T>::ParameterType ParameterType;
+
+			const std::vector<T> &y0Readable = y0->readable();
+			std::vector<T> &resultWritable = result->writable();
+			resultWritable.resize( y0Readable.size() );
+
+			const size_t numComponents = sizeof( T ) / sizeof( ComponentType );
+			lerp(
+				reinterpret_cast<const ComponentType *>( y0Readable.data() ),
+				reinterpret_cast<const ComponentType *>( y1->readable().data() ),
+				static_cast<ParameterType>( m_x ),
+				y0Readable.size() * numComponents,
+				reinterpret_cast<ComponentType *>( resultWritable.data() )
+			);
+
+			setGeometricInterpretation( result, getGeometricInterpretation( y0 ) );
+		}
 
+		template<typename T>
+		void interpolate( const T *y0, const T *y1, T *result, typename std::enable_if<!TypeTraits::IsVectorTypedData<T>::value || !LerpTraits<typename TypeTraits::VectorValueType<T>::type>::flat>::type *enabler = nullptr ) const
+		{
+			typename T::Ptr resultPtr = result;
+			LinearInterpolator<T>()( y0, y1, m_x, resultPtr );
+		}
+
+		const Data *m_y1;
+		double m_x;
+		Data *m_reusable;
+
+};
+
+struct Job
+{
+	PrimitiveVariable *primitiveVariable;
+	const Data *y0;
+	const Data *y1;
+	Data *reusable;
+	DataPtr result;
+};
+
+// Interpolates into `result`, which must already hold the topology and variables of `y0`.
+// Data from `reusableVariables` is reused where possible.
+bool interpolate( const Primitive *y0, const Primitive *y1, double x, Primitive *result, const PrimitiveVariableMap &reusableVariables )
+{
 	// Interpolate blindData
 	CompoundDataPtr interpolatedBlindData = boost::static_pointer_cast<CompoundData>(
 		linearObjectInterpolation( y0->blindData(), y1->blindData(), x )
 	);
 	result->blindData()->writable() = interpolatedBlindData->readable();
 
-	// Interpolate primitive variables
+	// Find the primitive variables to interpolate. We do this serially so that
+	// messages are emitted on the calling thread.
+	std::vector<Job> jobs;
 	for( const auto &namedPrimitiveVariable : y0->variables )
 	{
 		PrimitiveVariableMap::const_iterator it = y1->variables.find( namedPrimitiveVariable.first );
@@ -97,13 +257,9 @@ PrimitivePtr interpolatePrimitive( const Primitive *y0, const Primitive *y1, dou
 
 			if( y0PrimVar.indices && y1PrimVar.indices )
 			{
-				MurmurHash y0IndicesHash;
-				MurmurHash y1IndicesHash;
-
-				y0PrimVar.indices->hash( y0IndicesHash );
-				y1PrimVar.indices->hash( y1IndicesHash );
-
-				if( y0IndicesHash != y1IndicesHash )
+				// Indices are typically shared between samples, in which case
+				// this is just a pointer comparison.
+				if( !y0PrimVar.indices->isEqualTo( y1PrimVar.indices.get() ) )
 				{
 					msg(
 						MessageHandler::Level::Error,
@@ -125,18 +281,102 @@ PrimitivePtr interpolatePrimitive( const Primitive *y0, const Primitive *y1, dou
 				continue;
 			}
 
-			ObjectPtr interpolatedData = linearObjectInterpolation( y0Sample, y1Sample, x );
-			if( interpolatedData )
+			PrimitiveVariable &resultPrimVar = result->variables[namedPrimitiveVariable.first];
+			if( !dispatch( y0Sample, IsInterpolable() ) )
 			{
-				result->variables[namedPrimitiveVariable.first].data = boost::static_pointer_cast<Data>( interpolatedData );
+				// Not something we can interpolate ourselves, but there may
+				// be a custom interpolator registered for it.
+				ObjectPtr interpolatedData = linearObjectInterpolation( y0Sample, y1Sample, x );
+				if( interpolatedData )
+				{
+					resultPrimVar.data = boost::static_pointer_cast<Data>( interpolatedData );
+				}
+				continue;
 			}
+
+			PrimitiveVariableMap::const_iterator reusableIt = reusableVariables.find( namedPrimitiveVariable.first );
+			jobs.push_back( { &resultPrimVar, y0Sample, y1Sample, reusableIt != reusableVariables.end() ? reusableIt->second.data.get() : nullptr, nullptr } );
 		}
 	}
 
+	// Interpolate in parallel.
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, jobs.size(), 1 ),
+		[&jobs, x]( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Job &job = jobs[i];
+				job.result = dispatch( job.y0, DataInterpolator( job.y1, x, job.reusable ) );
+			}
+		},
+		taskGroupContext
+	);
 
-	return result;
+	for( const auto &job : jobs )
+	{
+		job.primitiveVariable->data = job.result;
+	}
+
+	return true;
+}
+
+bool compatible( const Primitive *y0, const Primitive *y1 )
+{
+	return
+		y0->variableSize( PrimitiveVariable::Uniform ) == y1->variableSize( PrimitiveVariable::Uniform ) &&
+		y0->variableSize( PrimitiveVariable::Varying ) == y1->variableSize( PrimitiveVariable::Varying ) &&
+		y0->variableSize( PrimitiveVariable::Vertex ) == y1->variableSize( PrimitiveVariable::Vertex ) &&
+		y0->variableSize( PrimitiveVariable::FaceVarying ) == y1->variableSize( PrimitiveVariable::FaceVarying )
+	;
+}
+
+PrimitivePtr interpolatePrimitive( const Primitive *y0, const Primitive *y1, double x )
+{
+	return linearPrimitiveInterpolation( y0, y1, x );
 }
 
 IECore::InterpolatorDescription<IECoreScene::Primitive> g_description( interpolatePrimitive );
 
 } // namespace
+
+PrimitivePtr IECoreScene::linearPrimitiveInterpolation( const Primitive *y0, const Primitive *y1, double x )
+{
+	if( !compatible( y0, y1 ) )
+	{
+		return nullptr;
+	}
+
+	// The copy shares its topology and primitive variables with y0,
+	// and the interpolated variables are then replaced with new data.
+	PrimitivePtr result = y0->copy();
+	interpolate( y0, y1, x, result.get(), PrimitiveVariableMap() );
+	return result;
+}
+
+bool IECoreScene::linearPrimitiveInterpolation( const Primitive *y0, const Primitive *y1, double x, Primitive *result )
+{
+	if( result == y0 || result == y1 )
+	{
+		throw InvalidArgumentException( "linearPrimitiveInterpolation : Result must not be one of the inputs" );
+	}
+
+	if( result->typeId() != y0->typeId() )
+	{
+		throw InvalidArgumentException( "linearPrimitiveInterpolation : Result type does not match input type" );
+	}
+
+	if( !compatible( y0, y1 ) )
+	{
+		return false;
+	}
+
+	// Take ownership of the current variables so we can reuse their data,
+	// then take the topology and remaining variables from y0. This is cheap
+	// because the copied data is shared rather than duplicated.
+	PrimitiveVariableMap reusableVariables;
+	reusableVariables.swap( result->variables );
+	result->Object::copyFrom( y0 );
+
+	return interpolate( y0, y1, x, result, reusableVariables );
+}
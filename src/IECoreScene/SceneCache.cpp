@@ -2440,6 +2440,10 @@ IECore::PathMatcher SceneCache::readSet( const Name &name, bool includeDescendan
 	// load the new sets
 	set.addPaths( reader->readSet( name, includeDescendantSets ) );
 
+	// Sets read from caches are typically large, and queried far
+	// more often than they are edited.
+	set.compact();
+
 	return set;
 }
 
@@ -324,7 +324,7 @@ bool SmoothSkinningData::isEqualTo(  const IECore::Object *other ) const
 		return false;
 	}
 
-	if(	!m_influencePose->isEqualTo( tOther->m_influencePose.get() ) )
+	if(	!m_pointIndexOffsets->isEqualTo( tOther->m_pointIndexOffsets.get() ) )
 	{
 		return false;
 	}
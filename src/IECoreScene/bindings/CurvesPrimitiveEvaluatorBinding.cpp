@@ -83,6 +83,22 @@ IntVectorDataPtr varyingDataOffsets( const CurvesPrimitiveEvaluator &e )
 	return new IntVectorData( e.varyingDataOffsets() );
 }
 
+boost::python::tuple batchClosestPoint( const CurvesPrimitiveEvaluator &e, const V3fVectorData *points, float maxDistance )
+{
+	const size_t size = points->readable().size();
+	IntVectorDataPtr curveIndices = new IntVectorData( std::vector<int>( size ) );
+	FloatVectorDataPtr v = new FloatVectorData( std::vector<float>( size, 0.0f ) );
+	V3fVectorDataPtr positions = new V3fVectorData( std::vector<V3f>( size, V3f( 0 ) ) );
+
+	e.batchClosestPoint(
+		points->readable().data(), size,
+		curveIndices->writable().data(), v->writable().data(), positions->writable().data(),
+		maxDistance
+	);
+
+	return boost::python::make_tuple( curveIndices, v, positions );
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -229,6 +245,7 @@ void bindCurvesPrimitiveEvaluator()
 		.def( "verticesPerCurve", &verticesPerCurve )
 		.def( "vertexDataOffsets", &vertexDataOffsets )
 		.def( "varyingDataOffsets", &varyingDataOffsets )
+		.def( "batchClosestPoint", &batchClosestPoint, ( arg( "points" ), arg( "maxDistance" ) = Imath::limits<float>::max() ) )
 	;
 
 	RefCountedClass<CurvesPrimitiveEvaluator::Result, PrimitiveEvaluator::Result>( "Result" )
@@ -39,6 +39,7 @@
 #include "IECoreScene/MeshAlgo.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "boost/python/suite/indexing/container_utils.hpp"
 
@@ -81,10 +82,110 @@ struct StdPairToTupleConverter
 typedef boost::python::list (*Fn)(const MeshPrimitive *mesh, const PrimitiveVariable &primitiveVariable);
 
 
+PrimitiveVariable calculateNormals( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation interpolation, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateNormals( mesh, interpolation, position );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangents( const MeshPrimitive *mesh, const std::string &uvSet, bool orthoTangents, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateTangents( mesh, uvSet, orthoTangents, position );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromUV( const MeshPrimitive *mesh, const std::string &uvSet, const std::string &position, bool orthoTangents, bool leftHanded )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateTangentsFromUV( mesh, uvSet, position, orthoTangents, leftHanded );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromFirstEdge( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateTangentsFromFirstEdge( mesh, position, normal, orthoTangents, leftHanded );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromTwoEdges( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateTangentsFromTwoEdges( mesh, position, normal, orthoTangents, leftHanded );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangentsFromPrimitiveCentroid( const MeshPrimitive *mesh, const std::string &position, const std::string &normal, bool orthoTangents, bool leftHanded )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateTangentsFromPrimitiveCentroid( mesh, position, normal, orthoTangents, leftHanded );
+}
+
+PrimitiveVariable calculateFaceArea( const MeshPrimitive *mesh, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateFaceArea( mesh, position );
+}
+
+PrimitiveVariable calculateFaceTextureArea( const MeshPrimitive *mesh, const std::string &uvSet, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateFaceTextureArea( mesh, uvSet, position );
+}
+
+std::pair<PrimitiveVariable, PrimitiveVariable> calculateDistortion( const MeshPrimitive *mesh, const std::string &uvSet, const std::string &referencePosition, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::calculateDistortion( mesh, uvSet, referencePosition, position );
+}
+
+void resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable &primitiveVariable, PrimitiveVariable::Interpolation interpolation )
+{
+	ScopedGILRelease gilRelease;
+	MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation );
+}
+
+MeshPrimitivePtr deleteFaces( const MeshPrimitive *mesh, const PrimitiveVariable &facesToDelete, bool invert )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::deleteFaces( mesh, facesToDelete, invert );
+}
+
+void reverseWinding( MeshPrimitive *mesh )
+{
+	ScopedGILRelease gilRelease;
+	MeshAlgo::reverseWinding( mesh );
+}
+
+void reorderVertices( MeshPrimitive *mesh, int id0, int id1, int id2 )
+{
+	ScopedGILRelease gilRelease;
+	MeshAlgo::reorderVertices( mesh, id0, id1, id2 );
+}
+
+PointsPrimitivePtr distributePoints( const MeshPrimitive *mesh, float density, const Imath::V2f &offset, const std::string &densityMask, const std::string &uvSet, const std::string &position )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::distributePoints( mesh, density, offset, densityMask, uvSet, position );
+}
+
+MeshPrimitivePtr triangulate( const MeshPrimitive *mesh, float tolerance, bool throwExceptions )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::triangulate( mesh, tolerance, throwExceptions );
+}
+
+std::pair<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr> connectedVertices( const MeshPrimitive *mesh )
+{
+	ScopedGILRelease gilRelease;
+	return MeshAlgo::connectedVertices( mesh );
+}
+
 boost::python::list segment(const MeshPrimitive *mesh, const PrimitiveVariable &primitiveVariable, const IECore::Data *segmentValues = nullptr)
 {
 	boost::python::list returnList;
-	std::vector<MeshPrimitivePtr> segmented = MeshAlgo::segment(mesh, primitiveVariable, segmentValues);
+	std::vector<MeshPrimitivePtr> segmented;
+	{
+		ScopedGILRelease gilRelease;
+		segmented = MeshAlgo::segment(mesh, primitiveVariable, segmentValues);
+	}
 	for (auto p : segmented)
 	{
 		returnList.append( p );
@@ -98,6 +199,7 @@ MeshPrimitivePtr merge( boost::python::list &l )
 {
 	std::vector<const MeshPrimitive *> meshes;
 	boost::python::container_utils::extend_container( meshes, l );
+	ScopedGILRelease gilRelease;
 	return MeshAlgo::merge( meshes );
 }
 
@@ -116,24 +218,24 @@ void bindMeshAlgo()
 	StdPairToTupleConverter<PrimitiveVariable, PrimitiveVariable>();
 	StdPairToTupleConverter<IECore::IntVectorDataPtr, IECore::IntVectorDataPtr>();
 
-	def( "calculateNormals", &MeshAlgo::calculateNormals, ( arg_( "mesh" ), arg_( "interpolation" ) = PrimitiveVariable::Vertex, arg_( "position" ) = "P" ) );
-	def( "calculateTangents", &MeshAlgo::calculateTangents, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "orthoTangents" ) = true, arg_( "position" ) = "P" ) );
-	def( "calculateTangentsFromUV", &MeshAlgo::calculateTangentsFromUV, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv",  arg_( "position" ) = "P", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
-	def( "calculateTangentsFromFirstEdge", &MeshAlgo::calculateTangentsFromFirstEdge, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
-	def( "calculateTangentsFromTwoEdges", &MeshAlgo::calculateTangentsFromTwoEdges, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
-	def( "calculateTangentsFromPrimitiveCentroid", &MeshAlgo::calculateTangentsFromPrimitiveCentroid, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
-	def( "calculateFaceArea", &MeshAlgo::calculateFaceArea, ( arg_( "mesh" ), arg_( "position" ) = "P" ) );
-	def( "calculateFaceTextureArea", &MeshAlgo::calculateFaceTextureArea, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "position" ) = "P" ) );
-	def( "calculateDistortion", &MeshAlgo::calculateDistortion, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "referencePosition" ) = "Pref", arg_( "position" ) = "P" ) );
-	def( "resamplePrimitiveVariable", &MeshAlgo::resamplePrimitiveVariable );
-	def( "deleteFaces", &MeshAlgo::deleteFaces, arg_( "invert" ) = false );
-	def( "reverseWinding", &MeshAlgo::reverseWinding );
-	def( "reorderVertices", &MeshAlgo::reorderVertices, ( arg_( "mesh" ), arg_( "id0" ), arg_( "id1" ), arg_( "id2" ) ) );
-	def( "distributePoints", &MeshAlgo::distributePoints, ( arg_( "mesh" ), arg_( "density" ) = 100.0, arg_( "offset" ) = Imath::V2f( 0 ), arg_( "densityMask" ) = "density", arg_( "uvSet" ) = "uv", arg_( "position" ) = "P" ) );
+	def( "calculateNormals", &::calculateNormals, ( arg_( "mesh" ), arg_( "interpolation" ) = PrimitiveVariable::Vertex, arg_( "position" ) = "P" ) );
+	def( "calculateTangents", &::calculateTangents, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "orthoTangents" ) = true, arg_( "position" ) = "P" ) );
+	def( "calculateTangentsFromUV", &::calculateTangentsFromUV, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv",  arg_( "position" ) = "P", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
+	def( "calculateTangentsFromFirstEdge", &::calculateTangentsFromFirstEdge, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
+	def( "calculateTangentsFromTwoEdges", &::calculateTangentsFromTwoEdges, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
+	def( "calculateTangentsFromPrimitiveCentroid", &::calculateTangentsFromPrimitiveCentroid, ( arg_( "mesh" ), arg_( "position" ) = "P", arg_( "normal" ) = "N", arg_( "orthoTangents" ) = true, arg_( "leftHanded" ) = false ) );
+	def( "calculateFaceArea", &::calculateFaceArea, ( arg_( "mesh" ), arg_( "position" ) = "P" ) );
+	def( "calculateFaceTextureArea", &::calculateFaceTextureArea, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "position" ) = "P" ) );
+	def( "calculateDistortion", &::calculateDistortion, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "referencePosition" ) = "Pref", arg_( "position" ) = "P" ) );
+	def( "resamplePrimitiveVariable", &::resamplePrimitiveVariable );
+	def( "deleteFaces", &::deleteFaces, arg_( "invert" ) = false );
+	def( "reverseWinding", &::reverseWinding );
+	def( "reorderVertices", &::reorderVertices, ( arg_( "mesh" ), arg_( "id0" ), arg_( "id1" ), arg_( "id2" ) ) );
+	def( "distributePoints", &::distributePoints, ( arg_( "mesh" ), arg_( "density" ) = 100.0, arg_( "offset" ) = Imath::V2f( 0 ), arg_( "densityMask" ) = "density", arg_( "uvSet" ) = "uv", arg_( "position" ) = "P" ) );
 	def( "segment", &::segment, segmentOverLoads() );
 	def( "merge", &::merge );
-	def( "triangulate", &MeshAlgo::triangulate, (arg_("mesh"), arg_("tolerance") =1e-6f, arg_("throwExceptions") = false) );
-	def( "connectedVertices", &MeshAlgo::connectedVertices );
+	def( "triangulate", &::triangulate, (arg_("mesh"), arg_("tolerance") =1e-6f, arg_("throwExceptions") = false) );
+	def( "connectedVertices", &::connectedVertices );
 }
 
 } // namespace IECoreSceneModule
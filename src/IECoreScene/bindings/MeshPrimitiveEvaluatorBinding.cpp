@@ -40,6 +40,9 @@
 
 #include "IECorePython/RefCountedBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "IECore/VectorTypedData.h"
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -53,15 +56,69 @@ namespace IECoreSceneModule
 static bool barycentricPosition( const MeshPrimitiveEvaluator &e, unsigned int t, const Imath::V3f &b, PrimitiveEvaluator::Result *r )
 {
 	e.validateResult( r );
+	ScopedGILRelease gilRelease;
 	return e.barycentricPosition( t, b, r );
 }
 
+static MeshPrimitiveEvaluatorPtr constructor( MeshPrimitivePtr mesh )
+{
+	// Construction builds an acceleration structure, which may
+	// take some time for large meshes.
+	ScopedGILRelease gilRelease;
+	return new MeshPrimitiveEvaluator( mesh );
+}
+
+static boost::python::tuple batchClosestPoint( const MeshPrimitiveEvaluator &e, const V3fVectorData *points, float maxDistance )
+{
+	const size_t size = points->readable().size();
+	IntVectorDataPtr triangleIndices = new IntVectorData( std::vector<int>( size ) );
+	V3fVectorDataPtr barycentricCoordinates = new V3fVectorData( std::vector<Imath::V3f>( size, Imath::V3f( 0 ) ) );
+	V3fVectorDataPtr positions = new V3fVectorData( std::vector<Imath::V3f>( size, Imath::V3f( 0 ) ) );
+
+	{
+		ScopedGILRelease gilRelease;
+		e.batchClosestPoint(
+			points->readable().data(), size,
+			triangleIndices->writable().data(), barycentricCoordinates->writable().data(), positions->writable().data(),
+			maxDistance
+		);
+	}
+
+	return boost::python::make_tuple( triangleIndices, barycentricCoordinates, positions );
+}
+
+static boost::python::tuple batchIntersectionPoint( const MeshPrimitiveEvaluator &e, const V3fVectorData *origins, const V3fVectorData *directions, float maxDistance )
+{
+	const size_t size = origins->readable().size();
+	if( directions->readable().size() != size )
+	{
+		throw InvalidArgumentException( "MeshPrimitiveEvaluator::batchIntersectionPoint : Number of origins and directions must match" );
+	}
+
+	IntVectorDataPtr triangleIndices = new IntVectorData( std::vector<int>( size ) );
+	V3fVectorDataPtr barycentricCoordinates = new V3fVectorData( std::vector<Imath::V3f>( size, Imath::V3f( 0 ) ) );
+	V3fVectorDataPtr positions = new V3fVectorData( std::vector<Imath::V3f>( size, Imath::V3f( 0 ) ) );
+
+	{
+		ScopedGILRelease gilRelease;
+		e.batchIntersectionPoint(
+			origins->readable().data(), directions->readable().data(), size,
+			triangleIndices->writable().data(), barycentricCoordinates->writable().data(), positions->writable().data(),
+			maxDistance
+		);
+	}
+
+	return boost::python::make_tuple( triangleIndices, barycentricCoordinates, positions );
+}
+
 void bindMeshPrimitiveEvaluator()
 {
 	object m = RunTimeTypedClass<MeshPrimitiveEvaluator>()
-		.def( init< MeshPrimitivePtr > () )
+		.def( "__init__", make_constructor( &constructor ) )
 		.def( "barycentricPosition", &barycentricPosition )
 		.def( "uvBound", &MeshPrimitiveEvaluator::uvBound )
+		.def( "batchClosestPoint", &batchClosestPoint, ( arg( "points" ), arg( "maxDistance" ) = Imath::limits<float>::max() ) )
+		.def( "batchIntersectionPoint", &batchIntersectionPoint, ( arg( "origins" ), arg( "directions" ), arg( "maxDistance" ) = Imath::limits<float>::max() ) )
 	;
 
 	{
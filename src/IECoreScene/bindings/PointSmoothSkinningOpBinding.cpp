@@ -63,6 +63,7 @@ void bindPointSmoothSkinningOp()
 
 	enum_< PointSmoothSkinningOp::Blend >( "Blend" )
 		.value( "Linear", PointSmoothSkinningOp::Linear )
+		.value( "DualQuaternion", PointSmoothSkinningOp::DualQuaternion )
 	;
 
 
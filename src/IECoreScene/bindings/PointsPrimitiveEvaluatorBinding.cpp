@@ -41,10 +41,42 @@
 
 #include "IECorePython/RunTimeTypedBinding.h"
 
+#include "IECore/VectorTypedData.h"
+
+using namespace IECore;
 using namespace IECorePython;
 using namespace IECoreScene;
 using namespace boost::python;
 
+namespace
+{
+
+boost::python::tuple batchNearestNNeighbours( const PointsPrimitiveEvaluator &e, const V3fVectorData *points, unsigned int numNeighbours )
+{
+	IntVectorDataPtr offsets = new IntVectorData;
+	IntVectorDataPtr pointIndices = new IntVectorData;
+	FloatVectorDataPtr distances = new FloatVectorData;
+	e.batchNearestNNeighbours(
+		points->readable().data(), points->readable().size(), numNeighbours,
+		offsets->writable(), pointIndices->writable(), distances->writable()
+	);
+	return boost::python::make_tuple( offsets, pointIndices, distances );
+}
+
+boost::python::tuple batchPointsInRadius( const PointsPrimitiveEvaluator &e, const V3fVectorData *points, float radius )
+{
+	IntVectorDataPtr offsets = new IntVectorData;
+	IntVectorDataPtr pointIndices = new IntVectorData;
+	FloatVectorDataPtr distances = new FloatVectorData;
+	e.batchPointsInRadius(
+		points->readable().data(), points->readable().size(), radius,
+		offsets->writable(), pointIndices->writable(), distances->writable()
+	);
+	return boost::python::make_tuple( offsets, pointIndices, distances );
+}
+
+} // namespace
+
 namespace IECoreSceneModule
 {
 
@@ -52,6 +84,8 @@ void bindPointsPrimitiveEvaluator()
 {
 	scope s = RunTimeTypedClass<PointsPrimitiveEvaluator>()
 		.def( init<PointsPrimitivePtr>() )
+		.def( "batchNearestNNeighbours", &batchNearestNNeighbours, ( arg( "points" ), arg( "numNeighbours" ) ) )
+		.def( "batchPointsInRadius", &batchPointsInRadius, ( arg( "points" ), arg( "radius" ) ) )
 	;
 
 	RefCountedClass<PointsPrimitiveEvaluator::Result, PrimitiveEvaluator::Result>( "Result" )
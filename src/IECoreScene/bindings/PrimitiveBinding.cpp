@@ -38,6 +38,7 @@
 
 #include "IECoreScene/Primitive.h"
 #include "IECoreScene/MeshPrimitive.h" // need to construct a concrete type to test
+#include "IECoreScene/PrimitiveInterpolator.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
 
@@ -261,6 +262,8 @@ static MurmurHash topologyHash( Primitive &p )
 void bindPrimitive()
 {
 	def( "testVariableIndexedView", &testVariableIndexedView );
+	def( "linearPrimitiveInterpolation", (PrimitivePtr (*)( const Primitive *, const Primitive *, double ))&linearPrimitiveInterpolation, ( arg( "y0" ), arg( "y1" ), arg( "x" ) ) );
+	def( "linearPrimitiveInterpolation", (bool (*)( const Primitive *, const Primitive *, double, Primitive * ))&linearPrimitiveInterpolation, ( arg( "y0" ), arg( "y1" ), arg( "x" ), arg( "result" ) ) );
 
 	RunTimeTypedClass<Primitive>()
 		.def( "variableSize", &Primitive::variableSize )
@@ -39,6 +39,7 @@
 #include "IECoreScene/PrimitiveEvaluator.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace IECore;
 using namespace IECorePython;
@@ -57,11 +58,13 @@ struct PrimitiveEvaluatorHelper
 			PyErr_SetString( PyExc_ValueError, "Null primitive" );
 			throw_error_already_set();
 		}
+		ScopedGILRelease gilRelease;
 		return PrimitiveEvaluator::create( primitive );
 	}
 
 	static float signedDistance( PrimitiveEvaluator &evaluator, const Imath::V3f &p, PrimitiveEvaluator::Result *result )
 	{
+		ScopedGILRelease gilRelease;
 
 		float distance = 0.0;
 		bool success = evaluator.signedDistance( p, distance, result );
@@ -77,6 +80,7 @@ struct PrimitiveEvaluatorHelper
 	{
 		evaluator.validateResult( result );
 
+		ScopedGILRelease gilRelease;
 		return evaluator.closestPoint( p, result );
 	}
 
@@ -84,6 +88,7 @@ struct PrimitiveEvaluatorHelper
 	{
 		evaluator.validateResult( result );
 
+		ScopedGILRelease gilRelease;
 		return evaluator.pointAtUV( uv, result );
 	}
 
@@ -91,6 +96,7 @@ struct PrimitiveEvaluatorHelper
 	{
 		evaluator.validateResult( result );
 
+		ScopedGILRelease gilRelease;
 		return evaluator.intersectionPoint( origin, direction, result );
 	}
 
@@ -98,13 +104,17 @@ struct PrimitiveEvaluatorHelper
 	{
 		evaluator.validateResult( result );
 
+		ScopedGILRelease gilRelease;
 		return evaluator.intersectionPoint( origin, direction, result, maxDist );
 	}
 
 	static list intersectionPoints( PrimitiveEvaluator& evaluator, const Imath::V3f &origin, const Imath::V3f &direction )
 	{
 		std::vector< PrimitiveEvaluator::ResultPtr > results;
-		evaluator.intersectionPoints( origin, direction, results );
+		{
+			ScopedGILRelease gilRelease;
+			evaluator.intersectionPoints( origin, direction, results );
+		}
 
 		list result;
 
@@ -119,7 +129,10 @@ struct PrimitiveEvaluatorHelper
 	static list intersectionPoints( PrimitiveEvaluator& evaluator, const Imath::V3f &origin, const Imath::V3f &direction, float maxDistance )
 	{
 		std::vector< PrimitiveEvaluator::ResultPtr > results;
-		evaluator.intersectionPoints( origin, direction, results, maxDistance );
+		{
+			ScopedGILRelease gilRelease;
+			evaluator.intersectionPoints( origin, direction, results, maxDistance );
+		}
 
 		list result;
 
@@ -41,6 +41,7 @@
 
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "boost/python/suite/indexing/container_utils.hpp"
 
@@ -66,7 +67,10 @@ inline list arrayToList( std::vector<IndexedIO::EntryID> &ids )
 static list childNames( const SceneInterface &m )
 {
 	SceneInterface::NameList n;
-	m.childNames( n );
+	{
+		ScopedGILRelease gilRelease;
+		m.childNames( n );
+	}
 	return arrayToList( n );
 }
 
@@ -90,9 +94,28 @@ static SceneInterfacePtr nonConstScene( SceneInterface &m, list l, SceneInterfac
 {
 	SceneInterface::Path p;
 	container_utils::extend_container( p, l );
+	ScopedGILRelease gilRelease;
 	return m.scene( p, b );
 }
 
+static SceneInterfacePtr nonConstChild( SceneInterface &m, const SceneInterface::Name &name, SceneInterface::MissingBehaviour b )
+{
+	ScopedGILRelease gilRelease;
+	return m.child( name, b );
+}
+
+static SceneInterfacePtr createChild( SceneInterface &m, const SceneInterface::Name &name )
+{
+	ScopedGILRelease gilRelease;
+	return m.createChild( name );
+}
+
+static SceneInterfacePtr create( const std::string &path, IndexedIO::OpenMode mode )
+{
+	ScopedGILRelease gilRelease;
+	return SceneInterface::create( path, mode );
+}
+
 static list attributeNames( const SceneInterface &m )
 {
 	SceneInterface::NameList a;
@@ -132,7 +155,11 @@ static dict readObjectPrimitiveVariables( const SceneInterface &m, list varNameL
 	SceneInterface::NameList v;
 	container_utils::extend_container( v, varNameList );
 
-	PrimitiveVariableMap varMap = m.readObjectPrimitiveVariables( v, time );
+	PrimitiveVariableMap varMap;
+	{
+		ScopedGILRelease gilRelease;
+		varMap = m.readObjectPrimitiveVariables( v, time );
+	}
 	dict result;
 	for( PrimitiveVariableMap::const_iterator it = varMap.begin(); it != varMap.end(); it++ )
 	{
@@ -144,7 +171,10 @@ static dict readObjectPrimitiveVariables( const SceneInterface &m, list varNameL
 list readTags( const SceneInterface &m, int filter )
 {
 	SceneInterface::NameList tags;
-	m.readTags( tags, filter );
+	{
+		ScopedGILRelease gilRelease;
+		m.readTags( tags, filter );
+	}
 	list result;
 	for( SceneInterface::NameList::const_iterator it = tags.begin(); it != tags.end(); it++ )
 	{
@@ -160,8 +190,21 @@ void writeTags( SceneInterface &m, list tagList )
 	m.writeTags( v );
 }
 
+Imath::Box3d readBound( SceneInterface &m, double time )
+{
+	ScopedGILRelease gilRelease;
+	return m.readBound( time );
+}
+
+void writeBound( SceneInterface &m, const Imath::Box3d &bound, double time )
+{
+	ScopedGILRelease gilRelease;
+	m.writeBound( bound, time );
+}
+
 DataPtr readTransform( SceneInterface &m, double time )
 {
+	ScopedGILRelease gilRelease;
 	ConstDataPtr t = m.readTransform( time );
 	if( t )
 	{
@@ -170,8 +213,21 @@ DataPtr readTransform( SceneInterface &m, double time )
 	return nullptr;
 }
 
+Imath::M44d readTransformAsMatrix( SceneInterface &m, double time )
+{
+	ScopedGILRelease gilRelease;
+	return m.readTransformAsMatrix( time );
+}
+
+void writeTransform( SceneInterface &m, const Data *transform, double time )
+{
+	ScopedGILRelease gilRelease;
+	m.writeTransform( transform, time );
+}
+
 ObjectPtr readAttribute( SceneInterface &m, const SceneInterface::Name &name, double time )
 {
+	ScopedGILRelease gilRelease;
 	ConstObjectPtr o = m.readAttribute( name, time );
 	if( o )
 	{
@@ -180,8 +236,15 @@ ObjectPtr readAttribute( SceneInterface &m, const SceneInterface::Name &name, do
 	return nullptr;
 }
 
+void writeAttribute( SceneInterface &m, const SceneInterface::Name &name, const Object *attribute, double time )
+{
+	ScopedGILRelease gilRelease;
+	m.writeAttribute( name, attribute, time );
+}
+
 ObjectPtr readObject( SceneInterface &m, double time )
 {
+	ScopedGILRelease gilRelease;
 	ConstObjectPtr o = m.readObject( time );
 	if( o )
 	{
@@ -190,8 +253,15 @@ ObjectPtr readObject( SceneInterface &m, double time )
 	return nullptr;
 }
 
+void writeObject( SceneInterface &m, const Object *object, double time )
+{
+	ScopedGILRelease gilRelease;
+	m.writeObject( object, time );
+}
+
 static MurmurHash sceneHash( SceneInterface &m, SceneInterface::HashType hashType, double time )
 {
+	ScopedGILRelease gilRelease;
 	MurmurHash h;
 	m.hash( hashType, time, h );
 	return h;
@@ -199,20 +269,36 @@ static MurmurHash sceneHash( SceneInterface &m, SceneInterface::HashType hashTyp
 
 static  list setNames( const SceneInterface &m, bool includeDescendantSets = true   )
 {
-	SceneInterface::NameList a = m.setNames( includeDescendantSets );
+	SceneInterface::NameList a;
+	{
+		ScopedGILRelease gilRelease;
+		a = m.setNames( includeDescendantSets );
+	}
 	return arrayToList( a );
 }
 
 static MurmurHash hashSet( SceneInterface &m, const SceneInterface::Name &name)
 {
+	ScopedGILRelease gilRelease;
 	MurmurHash h;
 	m.hashSet( name,  h );
 	return h;
 }
 
+static PathMatcher readSet( SceneInterface &m, const SceneInterface::Name &name, bool includeDescendantSets )
+{
+	ScopedGILRelease gilRelease;
+	return m.readSet( name, includeDescendantSets );
+}
+
+static void writeSet( SceneInterface &m, const SceneInterface::Name &name, const PathMatcher &set )
+{
+	ScopedGILRelease gilRelease;
+	m.writeSet( name, set );
+}
+
 void bindSceneInterface()
 {
-	SceneInterfacePtr (SceneInterface::*nonConstChild)(const SceneInterface::Name &, SceneInterface::MissingBehaviour) = &SceneInterface::child;
 
 	// make the SceneInterface class first
 	IECorePython::RunTimeTypedClass<SceneInterface> sceneInterfaceClass;
@@ -257,36 +343,36 @@ void bindSceneInterface()
 		.def( "pathAsString", pathAsString )
 		.def( "name", &SceneInterface::name )
 		.def( "hasBound", &SceneInterface::hasBound )
-		.def( "readBound", &SceneInterface::readBound )
-		.def( "writeBound", &SceneInterface::writeBound )
+		.def( "readBound", &readBound )
+		.def( "writeBound", &writeBound )
 		.def( "readTransform", &readTransform )
-		.def( "readTransformAsMatrix", &SceneInterface::readTransformAsMatrix )
-		.def( "writeTransform", &SceneInterface::writeTransform )
+		.def( "readTransformAsMatrix", &readTransformAsMatrix )
+		.def( "writeTransform", &writeTransform )
 		.def( "hasAttribute", &SceneInterface::hasAttribute )
 		.def( "attributeNames", attributeNames )
 		.def( "readAttribute", &readAttribute )
-		.def( "writeAttribute", &SceneInterface::writeAttribute )
+		.def( "writeAttribute", &writeAttribute )
 		.def( "hasTag", &SceneInterface::hasTag, ( arg( "name" ), arg( "filter" ) = SceneInterface::LocalTag ) )
 		.def( "readTags", readTags, ( arg( "filter" ) = SceneInterface::LocalTag ) )
 		.def( "writeTags", writeTags )
 		.def( "setNames", &setNames, ( arg_( "includeDescendantSets" ) = true ) )
-		.def( "writeSet", &SceneInterface::writeSet )
+		.def( "writeSet", &writeSet )
 		.def( "hashSet", &hashSet )
-		.def( "readSet", &SceneInterface::readSet, ( arg_("name"), arg_( "includeDescendantSets" ) = true ) )
+		.def( "readSet", &readSet, ( arg_("name"), arg_( "includeDescendantSets" ) = true ) )
 		.def( "readObject", &readObject )
 		.def( "readObjectPrimitiveVariables", &readObjectPrimitiveVariables )
-		.def( "writeObject", &SceneInterface::writeObject )
+		.def( "writeObject", &writeObject )
 		.def( "hasObject", &SceneInterface::hasObject )
 		.def( "hasChild", &SceneInterface::hasChild )
 		.def( "childNames", &childNames )
 		.def( "child", nonConstChild, ( arg( "name" ), arg( "missingBehaviour" ) = SceneInterface::ThrowIfMissing ) )
-		.def( "createChild", &SceneInterface::createChild )
+		.def( "createChild", &createChild )
 		.def( "scene", &nonConstScene, ( arg( "path" ), arg( "missingBehaviour" ) = SceneInterface::ThrowIfMissing ) )
 		.def( "hash", &sceneHash )
 
 		.def( "pathToString", pathToString ).staticmethod("pathToString")
 		.def( "stringToPath", stringToPath ).staticmethod("stringToPath")
-		.def( "create", SceneInterface::create ).staticmethod( "create" )
+		.def( "create", create ).staticmethod( "create" )
 		.def( "supportedExtensions", supportedExtensions, ( arg("modes") = IndexedIO::Read|IndexedIO::Write|IndexedIO::Append ) ).staticmethod( "supportedExtensions" )
 
 		.def_readonly("visibilityName", &SceneInterface::visibilityName )
@@ -46,6 +46,7 @@
 #include "boost/iostreams/stream.hpp"
 
 #include <algorithm>
+#include <sstream>
 
 using namespace IECore;
 using namespace IECoreVDB;
@@ -90,6 +91,64 @@ struct MurmurHashSink
 	MurmurHash &hash;
 };
 
+const IndexedIO::EntryID g_gridsEntry( "grids" );
+const IndexedIO::EntryID g_metadataEntry( "metadata" );
+const IndexedIO::EntryID g_gridEntry( "grid" );
+const IndexedIO::EntryID g_hashEntry( "hash" );
+const IndexedIO::EntryID g_topologyHashEntry( "topologyHash" );
+
+bool readOnly( const IndexedIO *io )
+{
+	const IndexedIO::OpenMode mode = io->openMode();
+	return ( mode & IndexedIO::Read ) && !( mode & ( IndexedIO::Write | IndexedIO::Append ) );
+}
+
+//! serialise a single grid using the vdb stream format, so it can be stored as a char array
+std::string writeGrid( openvdb::GridBase::ConstPtr grid, bool statsMetadata )
+{
+	std::ostringstream stream( std::ios_base::binary );
+	openvdb::io::Stream vdbStream( stream );
+	vdbStream.setGridStatsMetadataEnabled( statsMetadata );
+	vdbStream.write( openvdb::GridCPtrVec( 1, grid ) );
+	return stream.str();
+}
+
+std::string readBytes( const IndexedIO *container, const IndexedIO::EntryID &name )
+{
+	std::string result;
+	result.resize( container->entry( name ).arrayLength() );
+	char *p = &result[0];
+	container->read( name, p, result.size() );
+	return result;
+}
+
+openvdb::GridBase::Ptr readGrid( const IndexedIO *container, const IndexedIO::EntryID &name )
+{
+	std::istringstream stream( readBytes( container, name ), std::ios_base::binary );
+	// we do our own lazy loading, so disable the stream's, which copies to a temporary file.
+	openvdb::io::Stream vdbStream( stream, /* delayLoad = */ false );
+	openvdb::GridPtrVecPtr grids = vdbStream.getGrids();
+	if( !grids || grids->size() != 1 )
+	{
+		throw IECore::Exception( "VDBObject::load - expected a single grid" );
+	}
+	return grids->front();
+}
+
+void writeHash( IndexedIO *container, const IndexedIO::EntryID &name, const MurmurHash &h )
+{
+	const uint64_t hash[2] = { h.h1(), h.h2() };
+	container->write( name, hash, 2 );
+}
+
+MurmurHash readHash( const IndexedIO *container, const IndexedIO::EntryID &name )
+{
+	uint64_t hash[2];
+	uint64_t *hashPtr = hash;
+	container->read( name, hashPtr, 2 );
+	return MurmurHash( hash[0], hash[1] );
+}
+
 }
 
 IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( VDBObject );
@@ -352,16 +411,64 @@ void VDBObject::copyFrom( const IECore::Object *other, IECore::Object::CopyConte
 	m_unmodifiedFromFile = vdbObject->m_unmodifiedFromFile;
 }
 
+void VDBObject::topologyHash( IECore::MurmurHash &h ) const
+{
+	for( const auto& it : m_grids )
+	{
+		h.append( it.first );
+		h.append( it.second.topologyHash() );
+	}
+}
+
 void VDBObject::save( IECore::Object::SaveContext *context ) const
 {
 	IECoreScene::VisibleRenderable::save( context );
-	throw IECore::NotImplementedException( "VDBObject::save" );
+	IndexedIOPtr container = context->container( staticTypeName(), m_ioVersion );
+	IndexedIOPtr gridsContainer = container->subdirectory( g_gridsEntry, IndexedIO::CreateIfMissing );
+
+	for( const auto &it : m_grids )
+	{
+		it.second.save( gridsContainer->subdirectory( it.first, IndexedIO::CreateIfMissing ).get() );
+	}
 }
 
 void VDBObject::load( IECore::Object::LoadContextPtr context )
 {
 	IECoreScene::VisibleRenderable::load( context );
-	throw IECore::NotImplementedException( "VDBObject::load" );
+	openvdb::initialize(); // grid types must be registered before grids can be read.
+
+	unsigned int v = m_ioVersion;
+	ConstIndexedIOPtr container = context->container( staticTypeName(), v );
+	ConstIndexedIOPtr gridsContainer = container->subdirectory( g_gridsEntry );
+
+	m_grids.clear();
+	m_lockedFile.reset();
+	m_unmodifiedFromFile = false;
+
+	// as for vdb files, we only read the grid metadata up front, deferring
+	// reading of topology and voxel data until the grid is first accessed.
+	// this is only possible when the file can't be modified in the meantime.
+	const bool lazy = readOnly( container.get() );
+
+	IndexedIO::EntryIDList gridNames;
+	gridsContainer->entryIds( gridNames, IndexedIO::Directory );
+	for( const auto &name : gridNames )
+	{
+		ConstIndexedIOPtr gridContainer = gridsContainer->subdirectory( name );
+		if( lazy )
+		{
+			m_grids[name] = HashedGrid(
+				readGrid( gridContainer.get(), g_metadataEntry ),
+				std::make_shared<LockedContainer>( gridContainer ),
+				readHash( gridContainer.get(), g_hashEntry ),
+				readHash( gridContainer.get(), g_topologyHashEntry )
+			);
+		}
+		else
+		{
+			m_grids[name] = HashedGrid( readGrid( gridContainer.get(), g_gridEntry ), nullptr );
+		}
+	}
 }
 
 void VDBObject::memoryUsage( IECore::Object::MemoryAccumulator &acc ) const
@@ -407,6 +514,19 @@ openvdb::GridBase::Ptr VDBObject::HashedGrid::grid() const
 		m_grid = tmp->file->readGrid( m_grid->getName() );
 		m_lockedFile.reset();
 	}
+
+	auto tmpContainer = m_lockedContainer;
+	if( tmpContainer )
+	{
+		tbb::recursive_mutex::scoped_lock l( tmpContainer->mutex );
+
+		if( m_lockedContainer )
+		{
+			m_grid = readGrid( tmpContainer->container.get(), g_gridEntry );
+			m_lockedContainer.reset();
+		}
+	}
+
 	return m_grid;
 }
 
@@ -433,6 +553,32 @@ IECore::MurmurHash VDBObject::HashedGrid::hash() const
 	return m_hash;
 }
 
+IECore::MurmurHash VDBObject::HashedGrid::topologyHash() const
+{
+	if( !m_topologyHashValid )
+	{
+		openvdb::GridBase::ConstPtr g = grid();
+
+		m_topologyHash = IECore::MurmurHash();
+		m_topologyHash.append( g->type() );
+
+		MurmurHashSink sink( m_topologyHash );
+		boost::iostreams::stream<MurmurHashSink> hashStream( sink );
+
+		openvdb::io::StreamMetadata::Ptr streamMetadata ( new openvdb::io::StreamMetadata() );
+		openvdb::io::setStreamMetadataPtr( hashStream, streamMetadata );
+
+		// unlike hash(), we skip the metadata and the voxel buffers. The
+		// topology still includes the background and tile values.
+		g->writeTopology( hashStream );
+		g->writeTransform( hashStream );
+
+		m_topologyHashValid = true;
+	}
+
+	return m_topologyHash;
+}
+
 void VDBObject::HashedGrid::markedAsEdited()
 {
 	if( m_grid.use_count() > 1 )
@@ -440,5 +586,43 @@ void VDBObject::HashedGrid::markedAsEdited()
 		m_grid = m_grid->deepCopyGrid();
 		m_hash = IECore::MurmurHash();
 		m_hashValid = false;
+		m_topologyHash = IECore::MurmurHash();
+		m_topologyHashValid = false;
 	}
 }
+
+void VDBObject::HashedGrid::save( IECore::IndexedIO *container ) const
+{
+	auto tmpContainer = m_lockedContainer;
+	if( tmpContainer )
+	{
+		// not loaded yet, so we can copy the serialised grid
+		// across without reading the voxel data into memory.
+		tbb::recursive_mutex::scoped_lock l( tmpContainer->mutex );
+
+		if( m_lockedContainer )
+		{
+			const std::string metadata = readBytes( tmpContainer->container.get(), g_metadataEntry );
+			const std::string grid = readBytes( tmpContainer->container.get(), g_gridEntry );
+			container->write( g_metadataEntry, metadata.data(), metadata.size() );
+			container->write( g_gridEntry, grid.data(), grid.size() );
+			writeHash( container, g_hashEntry, hash() );
+			writeHash( container, g_topologyHashEntry, topologyHash() );
+			return;
+		}
+	}
+
+	openvdb::GridBase::Ptr g = grid();
+
+	// store the file stats metadata used by bound() alongside an empty tree,
+	// so that grids can be loaded and culled without reading any voxel data.
+	openvdb::GridBase::Ptr statsGrid = g->copyGrid();
+	statsGrid->addStatsMetadata();
+	const std::string metadata = writeGrid( statsGrid->copyGridWithNewTree(), false );
+	const std::string serialisedGrid = writeGrid( g, true );
+
+	container->write( g_metadataEntry, metadata.data(), metadata.size() );
+	container->write( g_gridEntry, serialisedGrid.data(), serialisedGrid.size() );
+	writeHash( container, g_hashEntry, hash() );
+	writeHash( container, g_topologyHashEntry, topologyHash() );
+}
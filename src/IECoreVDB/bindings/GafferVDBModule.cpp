@@ -149,6 +149,13 @@ void insertGrid( VDBObject::Ptr vdbObject, boost::python::object pyObject )
 	vdbObject->insertGrid( gridPtr );
 }
 
+IECore::MurmurHash topologyHash( VDBObject::Ptr vdbObject )
+{
+	IECore::MurmurHash h;
+	vdbObject->topologyHash( h );
+	return h;
+}
+
 } // namespace
 
 BOOST_PYTHON_MODULE( _IECoreVDB )
@@ -164,6 +171,7 @@ BOOST_PYTHON_MODULE( _IECoreVDB )
 		.def("insertGrid", &::insertGrid)
 		.def("unmodifiedFromFile", &VDBObject::unmodifiedFromFile)
 		.def("fileName", &VDBObject::fileName)
+		.def("topologyHash", &::topologyHash)
 		;
 
 }
@@ -33,6 +33,7 @@
 ##########################################################################
 
 import math
+import os
 import random
 import unittest
 import imath
@@ -121,6 +122,41 @@ class TestBoundedKDTreeBox3f(unittest.TestCase, TestBoundedKDTree):
 			self.doIntersectingRandomBounds(t)
 			self.doIntersectingBounds(t)
 
+	def testLargeTree( self ) :
+
+		# Large enough for the tree to be built in parallel.
+		random.seed( 0 )
+		self.bounds = IECore.Box3fVectorData()
+		for i in range( 0, 50000 ) :
+			p = imath.V3f( random.random(), random.random(), random.random() )
+			self.bounds.append( imath.Box3f( p, p + imath.V3f( random.random() * 0.01 ) ) )
+
+		tree = IECore.Box3fTree( self.bounds )
+
+		for i in range( 0, 20 ) :
+			b = self.makeRandomBound()
+			self.assertEqual(
+				set( tree.intersectingBounds( b ) ),
+				set( j for j, x in enumerate( self.bounds ) if x.intersects( b ) )
+			)
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testPerformance( self ) :
+
+		bounds = IECore.Box3fVectorData()
+		for i in range( 0, 2000000 ) :
+			p = imath.V3f( random.random(), random.random(), random.random() )
+			bounds.append( imath.Box3f( p, p + imath.V3f( 0.001 ) ) )
+
+		t = IECore.Timer()
+		tree = IECore.Box3fTree( bounds )
+		#print( "BUILD", t.stop() )
+
+		t = IECore.Timer()
+		for b in bounds[:100000] :
+			tree.intersectingBounds( b )
+		#print( "QUERY", t.stop() )
+
 
 class TestBoundedKDTreeBox3d(unittest.TestCase, TestBoundedKDTree):
 
@@ -32,6 +32,7 @@
 #
 ##########################################################################
 
+import os
 import unittest
 import sys
 import subprocess
@@ -223,6 +224,73 @@ class testCompoundObject( unittest.TestCase ) :
 				self.assertEqual( h, o.hash() )
 			h = o.hash()
 
+	def testLazyLoading( self ) :
+
+		o = IECore.CompoundObject( {
+			"small" : IECore.IntVectorData( range( 0, 10 ) ),
+			"large" : IECore.FloatVectorData( [ float( i ) for i in range( 0, 100000 ) ] ),
+			"strings" : IECore.StringVectorData( [ str( i ) for i in range( 0, 10000 ) ] ),
+		} )
+
+		self.addCleanup( IECore.Data.setLazyLoading, IECore.Data.getLazyLoading() )
+
+		# Hashes are only stored when saving with lazy loading enabled.
+		IECore.Data.setLazyLoading( True )
+		io = IECore.FileIndexedIO( "test/IECore/lazyLoading.fio", [], IECore.IndexedIO.OpenMode.Write )
+		o.save( io, "o" )
+		del io
+
+		IECore.Data.setLazyLoading( False )
+		io = IECore.FileIndexedIO( "test/IECore/lazyLoading.fio", [], IECore.IndexedIO.OpenMode.Read )
+		eager = IECore.Object.load( io, "o" )
+		self.assertEqual( eager, o )
+
+		IECore.Data.setLazyLoading( True )
+		lazy = IECore.Object.load( io, "o" )
+		del io
+
+		# The large arrays haven't been read yet, but their
+		# hashes are available from the file.
+		self.assertLess( lazy.memoryUsage(), eager.memoryUsage() )
+		self.assertEqual( lazy.hash(), o.hash() )
+		self.assertLess( lazy.memoryUsage(), eager.memoryUsage() )
+
+		# Accessing the data loads it.
+		self.assertEqual( lazy["large"], o["large"] )
+		self.assertEqual( lazy["strings"], o["strings"] )
+		self.assertEqual( lazy.memoryUsage(), eager.memoryUsage() )
+		self.assertEqual( lazy, o )
+
+		# And the loaded data is editable as usual.
+		lazy["large"].append( 1 )
+		self.assertNotEqual( lazy.hash(), o.hash() )
+
+		# Files which aren't opened read-only are loaded eagerly.
+		io = IECore.FileIndexedIO( "test/IECore/lazyLoading.fio", [], IECore.IndexedIO.OpenMode.Append )
+		self.assertEqual( IECore.Object.load( io, "o" ).memoryUsage(), eager.memoryUsage() )
+		del io
+
+		# Files saved without lazy loading don't store hashes, but
+		# can still be loaded lazily, with the hash being computed
+		# by loading the data.
+		io = IECore.FileIndexedIO( "test/IECore/lazyLoading.fio", [], IECore.IndexedIO.OpenMode.Write )
+		IECore.Data.setLazyLoading( False )
+		o.save( io, "o" )
+		del io
+
+		IECore.Data.setLazyLoading( True )
+		io = IECore.FileIndexedIO( "test/IECore/lazyLoading.fio", [], IECore.IndexedIO.OpenMode.Read )
+		lazy = IECore.Object.load( io, "o" )
+		del io
+		self.assertLess( lazy.memoryUsage(), eager.memoryUsage() )
+		self.assertEqual( lazy.hash(), o.hash() )
+		self.assertEqual( lazy, o )
+
+	def tearDown( self ) :
+
+		if os.path.isfile( "test/IECore/lazyLoading.fio" ) :
+			os.remove( "test/IECore/lazyLoading.fio" )
+
 if __name__ == "__main__":
         unittest.main()
 
@@ -32,6 +32,7 @@
 #
 ##########################################################################
 
+import os
 import random
 import unittest
 import imath
@@ -274,6 +275,74 @@ class TestKDTreeV3f(unittest.TestCase, TestKDTree):
 		for t in self.treeSizes:
 			self.doEnclosedPoints(t)
 
+	def testLargeTree( self ) :
+
+		# Large enough for the tree to be built in parallel.
+		self.makeTree( 50000 )
+
+		random.seed( 0 )
+		for i in range( 0, 20 ) :
+
+			p = imath.V3f( random.random(), random.random(), random.random() )
+			distances = [ ( x - p ).length2() for x in self.points ]
+
+			nearest = self.tree.nearestNeighbour( p )
+			self.assertEqual( distances[nearest], min( distances ) )
+
+			r = 0.05
+			self.assertEqual(
+				set( self.tree.nearestNeighbours( p, r ) ),
+				set( j for j, d in enumerate( distances ) if d < r * r )
+			)
+
+			b = imath.Box3f( p, p + imath.V3f( 0.1 ) )
+			self.assertEqual(
+				set( self.tree.enclosedPoints( b ) ),
+				set( j for j, x in enumerate( self.points ) if b.intersects( x ) )
+			)
+
+	def testBatchQueries( self ) :
+
+		for numPoints in self.treeSizes + [ 5000 ] :
+
+			self.makeTree( numPoints )
+			queries = IECore.V3fVectorData( [ imath.V3f( random.random(), random.random(), random.random() ) for i in range( 0, 100 ) ] )
+
+			offsets, indices, distances = self.tree.batchNearestNeighbours( queries, 0.1 )
+			self.assertEqual( len( offsets ), len( queries ) + 1 )
+			self.assertEqual( offsets[-1], len( indices ) )
+			self.assertEqual( len( distances ), len( indices ) )
+			for i, q in enumerate( queries ) :
+				self.assertEqual(
+					list( indices[offsets[i]:offsets[i+1]] ),
+					list( self.tree.nearestNeighbours( q, 0.1 ) )
+				)
+				for j in range( offsets[i], offsets[i+1] ) :
+					self.assertAlmostEqual( distances[j], ( self.points[indices[j]] - q ).length(), 5 )
+
+			offsets, indices, distances = self.tree.batchNearestNNeighbours( queries, 4 )
+			self.assertEqual( len( offsets ), len( queries ) + 1 )
+			for i, q in enumerate( queries ) :
+				self.assertEqual(
+					list( indices[offsets[i]:offsets[i+1]] ),
+					list( self.tree.nearestNNeighbours( q, 4 ) )
+				)
+				self.assertEqual( list( distances[offsets[i]:offsets[i+1]] ), sorted( distances[offsets[i]:offsets[i+1]] ) )
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testPerformance( self ) :
+
+		points = IECore.V3fVectorData( [ imath.V3f( random.random(), random.random(), random.random() ) for i in range( 0, 1000000 ) ] )
+
+		t = IECore.Timer()
+		tree = IECore.V3fTree( points )
+		#print( "BUILD", t.stop() )
+
+		t = IECore.Timer()
+		for p in points[:100000] :
+			tree.nearestNeighbour( p )
+		#print( "QUERY", t.stop() )
+
 class TestKDTreeV3d(unittest.TestCase, TestKDTree):
 
 	def makeTree(self, numPoints):
@@ -262,6 +262,72 @@ class TestObjectIO( unittest.TestCase ) :
 		self.assertTrue( dd['c']['d'].isSame( dd['links']['v3'] ) )
 		self.assertTrue( dd['c/d'].isSame( dd['links']['v3'] ) )
 
+	def testParallelLoading( self ) :
+
+		shared = IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 1000 ) ] )
+
+		o = IECore.CompoundObject()
+		for i in range( 0, 50 ) :
+			d = IECore.CompoundData()
+			for j in range( 0, 20 ) :
+				d[str(j)] = IECore.IntVectorData( range( i, i + j * 10 ) )
+			d["shared"] = shared
+			v = IECore.ObjectVector( [ IECore.StringData( str( j ) ) for j in range( 0, 10 ) ] + [ shared, d ] )
+			o[str(i)] = IECore.CompoundObject( { "data" : d, "vector" : v, "shared" : shared } )
+
+		fio = IECore.FileIndexedIO( "test/o.fio", [], IECore.IndexedIO.OpenMode.Write )
+		o.save( fio, "test" )
+		del fio
+
+		self.addCleanup( IECore.Object.setParallelLoading, IECore.Object.getParallelLoading() )
+		IECore.Object.setParallelLoading( True )
+
+		fio = IECore.FileIndexedIO( "test/o.fio", [], IECore.IndexedIO.OpenMode.Read )
+		for i in range( 0, 10 ) :
+
+			oo = IECore.Object.load( fio, "test" )
+			self.assertEqual( oo, o )
+
+			# References must still be resolved to a single instance.
+			s = oo["0"]["shared"]
+			for j in range( 0, 50 ) :
+				c = oo[str(j)]
+				self.assertTrue( c["shared"].isSame( s ) )
+				self.assertTrue( c["data"]["shared"].isSame( s ) )
+				self.assertTrue( c["vector"][10].isSame( s ) )
+				self.assertTrue( c["vector"][11].isSame( c["data"] ) )
+
+	def testSelfReferencingObject( self ) :
+
+		o = IECore.CompoundObject( {
+			"a" : IECore.IntData( 1 ),
+			"b" : IECore.CompoundObject( { "c" : IECore.StringData( "c" ) } ),
+		} )
+		o["self"] = o
+		o["b"]["parent"] = o
+
+		fio = IECore.FileIndexedIO( "test/o.fio", [], IECore.IndexedIO.OpenMode.Write )
+		o.save( fio, "test" )
+		del fio
+
+		self.addCleanup( IECore.Object.setParallelLoading, IECore.Object.getParallelLoading() )
+		for parallel in ( False, True ) :
+
+			IECore.Object.setParallelLoading( parallel )
+
+			# References back to an object which is still being
+			# loaded are loaded as null.
+			fio = IECore.FileIndexedIO( "test/o.fio", [], IECore.IndexedIO.OpenMode.Read )
+			oo = IECore.Object.load( fio, "test" )
+			self.assertEqual( set( oo.keys() ), { "a", "b", "self" } )
+			self.assertEqual( oo["a"], IECore.IntData( 1 ) )
+			self.assertEqual( set( oo["b"].keys() ), { "c", "parent" } )
+			self.assertEqual( oo["b"]["c"], IECore.StringData( "c" ) )
+
+		# Break the cycle so that `o` can be freed.
+		del o["self"]
+		del o["b"]["parent"]
+
 	def tearDown( self ) :
 
 		for f in [ "test/o.fio", "test/FileIndexedIOSlashes.fio" ] :
@@ -92,6 +92,23 @@ class PathMatcherDataTest( unittest.TestCase ) :
 
 		self.assertNotEqual( d1.hash(), d2.hash() )
 
+	def testHashIndependentOfConstruction( self ) :
+
+		paths = [ "/a", "/a/b", "/a/c/d", "/e/f", "/g*", "/h/.../i" ]
+
+		d1 = IECore.PathMatcherData( IECore.PathMatcher( paths ) )
+		d2 = IECore.PathMatcherData( IECore.PathMatcher( list( reversed( paths ) ) ) )
+		d3 = IECore.PathMatcherData( IECore.PathMatcher( IECore.StringVectorData( paths ) ) )
+		d4 = IECore.PathMatcherData( IECore.PathMatcher( paths ) )
+		d4.value.compact()
+
+		self.assertEqual( d1.hash(), d2.hash() )
+		self.assertEqual( d1.hash(), d3.hash() )
+		self.assertEqual( d1.hash(), d4.hash() )
+
+		d4.value.removePath( "/a/c/d" )
+		self.assertNotEqual( d1.hash(), d4.hash() )
+
 	def testRepr( self ) :
 
 		d1 = IECore.PathMatcherData(
@@ -130,5 +147,36 @@ class PathMatcherDataTest( unittest.TestCase ) :
 
 		self.assertEqual( d, d2 )
 
+	def testSaveAndLoadEdgeCases( self ) :
+
+		for paths in [
+			[],
+			[ "/" ],
+			[ "/", "/a" ],
+			[ "/a/*/b", "/red*/thing", "/x/.../y", "/..." ],
+			[ "/a/b/c/d/e/f/g/h" ],
+			[ "/a/%d/b%d" % ( i, j ) for i in range( 0, 100 ) for j in range( 0, 20 ) ],
+		] :
+
+			d = IECore.PathMatcherData( IECore.PathMatcher( paths ) )
+
+			saveIO = IECore.MemoryIndexedIO( IECore.CharVectorData(), IECore.IndexedIO.OpenMode.Write )
+			d.save( saveIO, "d" )
+
+			loadIO = IECore.MemoryIndexedIO( saveIO.buffer(), IECore.IndexedIO.OpenMode.Read )
+			d2 = IECore.Object.load( loadIO, "d" )
+
+			self.assertEqual( d, d2 )
+			self.assertEqual( d.hash(), d2.hash() )
+			self.assertEqual( d2.value.match( "/a/z/b" ), d.value.match( "/a/z/b" ) )
+
+			# Loaded data must be editable.
+			d2.value.addPath( "/new/path" )
+			self.assertEqual( d2.value.size(), d.value.size() + 1 )
+
+	def testLoadVersion0( self ) :
+
+		IECore.testPathMatcherDataLoadVersion0()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -35,6 +35,7 @@
 #
 ##########################################################################
 
+import os
 import unittest
 import random
 
@@ -976,5 +977,174 @@ class PathMatcherTest( unittest.TestCase ) :
 		m.clear()
 		self.assertEqual( m.size(), 0 )
 
+	def testCompact( self ) :
+
+		paths = self.generatePaths( seed = 1, depthRange = ( 3, 6 ), numChildrenRange = ( 2, 10 ) )
+		paths.extend( [ "/a/*/b", "/red*/thing", "/x/.../y" ] )
+
+		m = IECore.PathMatcher( paths )
+		c = IECore.PathMatcher( m )
+		c.compact()
+
+		self.assertEqual( c, m )
+		self.assertEqual( c.size(), m.size() )
+		self.assertEqual( c.paths(), m.paths() )
+
+		for path in paths + [ "/a/z/b", "/redBall/thing", "/x/1/2/y", "/x/1/2", "/notThere" ] :
+			self.assertEqual( c.match( path ), m.match( path ) )
+
+		# Compacting twice should be harmless.
+		c.compact()
+		self.assertEqual( c, m )
+
+	def testEditAfterCompact( self ) :
+
+		paths = self.generatePaths( seed = 2, depthRange = ( 3, 6 ), numChildrenRange = ( 2, 10 ) )
+
+		m = IECore.PathMatcher( paths )
+		c = IECore.PathMatcher( m )
+		c.compact()
+		cc = IECore.PathMatcher( c )
+
+		for path in paths[::3] :
+			self.assertEqual( c.removePath( path ), m.removePath( path ) )
+		self.assertEqual( c, m )
+
+		for path in paths[::5] :
+			self.assertEqual( c.addPath( path ), m.addPath( path ) )
+		self.assertEqual( c, m )
+
+		self.assertEqual( c.addPath( "/a/new/path" ), m.addPath( "/a/new/path" ) )
+		self.assertEqual( c.prune( paths[1] ), m.prune( paths[1] ) )
+		self.assertEqual( c, m )
+
+		# The copy made before editing must be unaffected.
+		self.assertEqual( cc, IECore.PathMatcher( paths ) )
+
+		cc.removePaths( IECore.PathMatcher( paths ) )
+		self.assertTrue( cc.isEmpty() )
+		cc.addPaths( IECore.PathMatcher( paths ) )
+		self.assertEqual( cc, IECore.PathMatcher( paths ) )
+
+	def testConstructFromStringVectorData( self ) :
+
+		paths = [ "/" + "/".join( p ) for p in self.generatePaths( seed = 3, depthRange = ( 2, 5 ), numChildrenRange = ( 5, 25 ) ) ]
+		paths.extend( [ "/", "", "/a/*/b", "/red*/thing", "/x/.../y" ] )
+		# Duplicates must be tolerated.
+		paths.extend( paths[::7] )
+		random.seed( 3 )
+		random.shuffle( paths )
+
+		m = IECore.PathMatcher()
+		for path in paths :
+			m.addPath( path )
+
+		b = IECore.PathMatcher( IECore.StringVectorData( paths ) )
+		self.assertEqual( b, m )
+		self.assertEqual( b.size(), m.size() )
+		self.assertEqual( set( b.paths() ), set( m.paths() ) )
+		for path in paths + [ "/a/z/b", "/redBall/thing", "/x/1/2/y", "/notThere" ] :
+			self.assertEqual( b.match( path ), m.match( path ) )
+
+		# Result must be editable.
+		for path in paths[::3] :
+			self.assertEqual( b.removePath( path ), m.removePath( path ) )
+		self.assertEqual( b, m )
+
+		self.assertEqual( IECore.PathMatcher( IECore.StringVectorData() ), IECore.PathMatcher() )
+		self.assertEqual( IECore.PathMatcher( IECore.StringVectorData( [ "" ] ) ), IECore.PathMatcher() )
+
+	def testSetAlgebraOnWideHierarchies( self ) :
+
+		# Enough children per location to exercise the
+		# parallel code paths.
+		paths1 = [ "/" + "/".join( p ) for p in self.generatePaths( seed = 4, depthRange = ( 2, 4 ), numChildrenRange = ( 10, 40 ) ) ]
+		paths2 = [ "/" + "/".join( p ) for p in self.generatePaths( seed = 5, depthRange = ( 2, 4 ), numChildrenRange = ( 10, 40 ) ) ]
+
+		s1 = set( paths1 )
+		s2 = set( paths2 )
+
+		for compact in ( False, True ) :
+
+			m1 = IECore.PathMatcher( paths1 )
+			m2 = IECore.PathMatcher( paths2 )
+			if compact :
+				m1.compact()
+				m2.compact()
+
+			u = IECore.PathMatcher( m1 )
+			self.assertEqual( u.addPaths( m2 ), bool( s2 - s1 ) )
+			self.assertEqual( set( u.paths() ), s1 | s2 )
+			self.assertFalse( u.addPaths( m2 ) )
+
+			self.assertEqual( set( m1.intersection( m2 ).paths() ), s1 & s2 )
+			self.assertEqual( m1.intersection( m1 ), m1 )
+
+			d = IECore.PathMatcher( m1 )
+			self.assertEqual( d.removePaths( m2 ), bool( s1 & s2 ) )
+			self.assertEqual( set( d.paths() ), s1 - s2 )
+
+			# Sources must be unaffected.
+			self.assertEqual( set( m1.paths() ), s1 )
+			self.assertEqual( set( m2.paths() ), s2 )
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testCompactLookupPerformance( self ) :
+
+		# 1000 groups of 1000 children gives us a million paths.
+		paths = IECore.StringVectorData()
+		for i in range( 0, 1000 ) :
+			for j in range( 0, 1000 ) :
+				paths.append( "/group%d/child%d" % ( i, j ) )
+
+		# Build incrementally, so that the matcher uses the regular
+		# representation and `compact()` has work to do. We hold the
+		# matcher in a PathMatcherData so we can measure its memory.
+		d = IECore.PathMatcherData()
+		t = IECore.Timer()
+		for path in paths :
+			d.value.addPath( path )
+		print( "build time: {0}s".format( t.stop() ) )
+
+		t = IECore.Timer()
+		for path in paths[::100] :
+			self.assertTrue( d.value.match( path ) & IECore.PathMatcher.Result.ExactMatch )
+		print( "lookup time: {0}s".format( t.stop() ) )
+
+		memoryBefore = d.memoryUsage()
+
+		t = IECore.Timer()
+		d.value.compact()
+		print( "compact time: {0}s".format( t.stop() ) )
+
+		memoryAfter = d.memoryUsage()
+		print( "memory: {0} bytes before compaction, {1} bytes after".format( memoryBefore, memoryAfter ) )
+		self.assertLess( memoryAfter, memoryBefore )
+
+		t = IECore.Timer()
+		for path in paths[::100] :
+			self.assertTrue( d.value.match( path ) & IECore.PathMatcher.Result.ExactMatch )
+		print( "compact lookup time: {0}s".format( t.stop() ) )
+
+	def testMemoryUsage( self ) :
+
+		m = IECore.PathMatcher()
+		for i in range( 0, 10 ) :
+			for j in range( 0, 10 ) :
+				m.addPath( "/a%d/b%d" % ( i, j ) )
+
+		d = IECore.PathMatcherData( m )
+		memory = d.memoryUsage()
+		self.assertGreater( memory, IECore.PathMatcherData().memoryUsage() )
+
+		# Compaction reduces memory usage without changing the contents.
+		d.value.compact()
+		self.assertLess( d.memoryUsage(), memory )
+		self.assertEqual( d.value, m )
+
+		# Copies share their paths, so shouldn't be counted twice.
+		c = IECore.CompoundObject( { "a" : d, "b" : d.copy() } )
+		self.assertLess( c.memoryUsage(), 2 * d.memoryUsage() )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -80,6 +80,41 @@ class TestTypedData( unittest.TestCase ) :
 		b.setInterpretation( IECore.GeometricData.Interpretation.Point )
 		self.assertNotEqual( a.hash(), b.hash() )
 
+	def testHashVersion( self ) :
+
+		self.assertEqual( IECore.Data.getHashVersion(), IECore.Data.HashVersion.SerialHash )
+		self.addCleanup( IECore.Data.setHashVersion, IECore.Data.getHashVersion() )
+
+		small = IECore.IntVectorData( range( 0, 1000 ) )
+		large = IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 500000 ) ] )
+		strings = IECore.StringVectorData( [ str( i ) for i in range( 0, 100000 ) ] )
+
+		serialHashes = [ d.hash() for d in ( small, large, strings ) ]
+
+		IECore.Data.setHashVersion( IECore.Data.HashVersion.ChunkedHash )
+		self.assertEqual( IECore.Data.getHashVersion(), IECore.Data.HashVersion.ChunkedHash )
+
+		chunkedHashes = [ d.hash() for d in ( small, large, strings ) ]
+
+		# Small arrays fit in a single chunk, and hash identically.
+		self.assertEqual( chunkedHashes[0], serialHashes[0] )
+		# Large ones don't.
+		self.assertNotEqual( chunkedHashes[1], serialHashes[1] )
+
+		# Chunked hashes must still be deterministic, and
+		# sensitive to changes in any chunk.
+
+		self.assertEqual( large.copy().hash(), chunkedHashes[1] )
+		self.assertEqual( strings.copy().hash(), chunkedHashes[2] )
+
+		for i in ( 0, 250000, 499999 ) :
+			l = large.copy()
+			l[i] = imath.V3f( -1 )
+			self.assertNotEqual( l.hash(), chunkedHashes[1] )
+
+		IECore.Data.setHashVersion( IECore.Data.HashVersion.SerialHash )
+		self.assertEqual( [ d.hash() for d in ( small, large, strings ) ], serialHashes )
+
 	def testHalfDataConstruction( self ) :
 
 		zeroHalf = IECore.HalfData( 0 )
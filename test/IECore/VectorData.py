@@ -1268,6 +1268,114 @@ class TestVectorDataToString( unittest.TestCase ) :
 		for i in range( 0, 255 ) :
 			self.assertEqual( six.indexbytes( s, i ), i )
 
+class TestVectorDataBuffer( unittest.TestCase ) :
+
+	def testReadOnly( self ) :
+
+		d = IECore.FloatVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+
+		self.assertTrue( m.readonly )
+		self.assertEqual( m.format, "f" )
+		self.assertEqual( m.itemsize, 4 )
+		self.assertEqual( m.shape, ( 3, ) )
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+		def f() :
+			m[0] = 10
+
+		self.assertRaises( TypeError, f )
+
+	def testReadWrite( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		d2 = d.copy()
+
+		m = memoryview( d.asReadWriteBuffer() )
+		self.assertFalse( m.readonly )
+		m[1] = 20
+
+		self.assertEqual( d, IECore.IntVectorData( [ 1, 20, 3 ] ) )
+		# Copy should have been unshared before the buffer was made.
+		self.assertEqual( d2, IECore.IntVectorData( [ 1, 2, 3 ] ) )
+
+	def testBufferOutlivesData( self ) :
+
+		d = IECore.DoubleVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+		del d
+
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+	def testBufferOutlivesModification( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+
+		# Reallocation and in-place writes must not affect the view.
+		d.append( 4 )
+		d.resize( 1000 )
+		d[0] = 10
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadWriteBuffer() )
+		d.append( 4 )
+		m[0] = 10
+		self.assertEqual( m.tolist(), [ 10, 2, 3 ] )
+		self.assertEqual( d, IECore.IntVectorData( [ 1, 2, 3, 4 ] ) )
+
+	def testReadWriteBufferHash( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadWriteBuffer() )
+		h = d.hash()
+
+		# Writes via the buffer aren't tracked, so a hash computed
+		# after the buffer was made is not updated by them.
+		m[0] = 10
+		self.assertEqual( d, IECore.IntVectorData( [ 10, 2, 3 ] ) )
+		self.assertEqual( d.hash(), h )
+
+		# Requesting the buffer again discards the stale hash.
+		m = memoryview( d.asReadWriteBuffer() )
+		self.assertNotEqual( d.hash(), h )
+		self.assertEqual( d.hash(), IECore.IntVectorData( [ 10, 2, 3 ] ).hash() )
+
+	def testImathTypes( self ) :
+
+		for d, shape, format in [
+			( IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ), imath.V3f( 4, 5, 6 ) ] ), ( 2, 3 ), "f" ),
+			( IECore.V2iVectorData( [ imath.V2i( 1, 2 ) ] ), ( 1, 2 ), "i" ),
+			( IECore.Color4fVectorData( [ imath.Color4f( 1 ) ] * 3 ), ( 3, 4 ), "f" ),
+			( IECore.M44dVectorData( [ imath.M44d() ] * 2 ), ( 2, 4, 4 ), "d" ),
+			( IECore.Box3fVectorData( [ imath.Box3f() ] * 5 ), ( 5, 2, 3 ), "f" ),
+			( IECore.QuatfVectorData( [ imath.Quatf() ] ), ( 1, 4 ), "f" ),
+		] :
+			m = memoryview( d.asReadOnlyBuffer() )
+			self.assertEqual( m.shape, shape )
+			self.assertEqual( m.format, format )
+			self.assertEqual( m.nbytes, len( d.toString() ) )
+
+	def testConstructFromBuffer( self ) :
+
+		f = IECore.FloatVectorData( [ 1, 2, 3, 4, 5, 6 ] )
+
+		self.assertEqual( IECore.FloatVectorData( f.asReadOnlyBuffer() ), f )
+
+		v = IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ), imath.V3f( 4, 5, 6 ) ] )
+		self.assertEqual( IECore.V3fVectorData( v.asReadOnlyBuffer() ), v )
+
+		# Flat buffers are not reinterpreted as vectors.
+		self.assertRaises( Exception, IECore.V3fVectorData, f.asReadOnlyBuffer() )
+		self.assertRaises( Exception, IECore.FloatVectorData, v.asReadOnlyBuffer() )
+
+		# Mismatched types fall back to element-by-element conversion.
+		self.assertEqual(
+			IECore.DoubleVectorData( memoryview( f.asReadOnlyBuffer() ) ),
+			IECore.DoubleVectorData( [ 1, 2, 3, 4, 5, 6 ] )
+		)
+
 class TestVectorDataHashOptimisation( unittest.TestCase ) :
 
 	@unittest.skipIf( os.environ.get("TRAVIS", False), "'TRAVIS' env var defined - skipping unreliable test" )
@@ -270,6 +270,58 @@ class MeshPrimitiveTest( unittest.TestCase ) :
 
 		self.assertEqual( IECoreImage.ImageDiffOp()( imageA = expectedImage, imageB = actualImage, maxError = 0.05 ).value, False )
 
+	def testWelding( self ) :
+
+		# Smooth plane with indexed UVs. Every face-vertex sharing a vertex
+		# has identical values, so they should all be welded together.
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		m["N"] = IECoreScene.MeshAlgo.calculateNormals( m )
+
+		glMesh = IECoreGL.ToGLMeshConverter( m ).convert()
+		ids = glMesh.vertexIds()
+		self.assertEqual( len( ids ), 10 * 10 * 2 * 3 )
+		self.assertEqual( len( set( ids ) ), m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) )
+		self.assertEqual( max( ids ), len( set( ids ) ) - 1 )
+
+		# Box with faceted normals. Face-vertices can only be shared
+		# within a face.
+
+		m = IECoreScene.MeshPrimitive.createBox( imath.Box3f( imath.V3f( -1 ), imath.V3f( 1 ) ) )
+		ids = IECoreGL.ToGLMeshConverter( m ).convert().vertexIds()
+		self.assertEqual( len( ids ), 6 * 2 * 3 )
+		self.assertEqual( len( set( ids ) ), 24 )
+
+		# Face-varying data without indices should be welded by value.
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 2 ) )
+		m["N"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.V3fVectorData( [ imath.V3f( 0, 0, 1 ) ] * 16 )
+		)
+		m["uv"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying, m["uv"].expandedData() )
+		ids = IECoreGL.ToGLMeshConverter( m ).convert().vertexIds()
+		self.assertEqual( len( set( ids ) ), 9 )
+
+	def testDeformingMeshWelding( self ) :
+
+		# Welding depends only on topology, so deforming the mesh
+		# must not change the vertex ids, even for the normals which
+		# are computed from P.
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		ids = IECoreGL.ToGLMeshConverter( m ).convert().vertexIds()
+		self.assertEqual( len( set( ids ) ), 10 * 10 * 4 )
+
+		m2 = m.copy()
+		m2["P"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ p + imath.V3f( 0, 0, p.x * p.y ) for p in m["P"].data ], IECore.GeometricData.Interpretation.Point )
+		)
+		glMesh = IECoreGL.ToGLMeshConverter( m2 ).convert()
+		self.assertEqual( glMesh.vertexIds(), ids )
+		self.assertEqual( glMesh.bound(), m2.bound() )
+
 	def setUp( self ) :
 
 		if not os.path.isdir( "test/IECoreGL/output" ) :
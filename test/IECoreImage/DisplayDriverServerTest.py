@@ -33,6 +33,8 @@
 ##########################################################################
 
 import unittest
+import threading
+import imath
 
 import IECore
 import IECoreImage
@@ -58,6 +60,58 @@ class DisplayDriverServerTest( unittest.TestCase ) :
 		self.assertNotEqual( s4.portNumber(), 0 )
 		self.assertNotEqual( s4.portNumber(), s3.portNumber() )
 
+	def testNumThreads( self ) :
+
+		s = IECoreImage.DisplayDriverServer()
+		self.assertEqual( s.numThreads(), 1 )
+
+		s = IECoreImage.DisplayDriverServer( 0, 4 )
+		self.assertEqual( s.numThreads(), 4 )
+
+		s = IECoreImage.DisplayDriverServer( numThreads = 0 )
+		self.assertGreaterEqual( s.numThreads(), 1 )
+
+	def testConcurrentSessions( self ) :
+
+		IECore.initThreads()
+
+		server = IECoreImage.DisplayDriverServer( 0, 4 )
+		window = imath.Box2i( imath.V2i( 0 ), imath.V2i( 63 ) )
+
+		def sendImage( index ) :
+
+			driver = IECoreImage.ClientDisplayDriver(
+				window, window,
+				[ "Y" ],
+				IECore.CompoundData( {
+					"displayHost" : "localhost",
+					"displayPort" : str( server.portNumber() ),
+					"remoteDisplayType" : "ImageDisplayDriver",
+					"handle" : "concurrentSession%d" % index,
+				} )
+			)
+
+			for y in range( 0, 64 ) :
+				driver.imageData(
+					imath.Box2i( imath.V2i( 0, y ), imath.V2i( 63, y ) ),
+					IECore.FloatVectorData( [ index + y ] * 64 )
+				)
+
+			driver.imageClose()
+
+		threads = [ threading.Thread( target = sendImage, args = ( i, ) ) for i in range( 0, 8 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		for i in range( 0, 8 ) :
+			image = IECoreImage.ImageDisplayDriver.removeStoredImage( "concurrentSession%d" % i )
+			expected = IECore.FloatVectorData()
+			for y in range( 0, 64 ) :
+				expected.extend( [ i + y ] * 64 )
+			self.assertEqual( image["Y"], expected )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -327,6 +327,53 @@ class CurveLineariserTest( unittest.TestCase ) :
 
 		self.runTest( c )
 
+	def testManyCurvesWithPrimitiveVariables( self ) :
+
+		verticesPerCurve = IECore.IntVectorData()
+		p = IECore.V3fVectorData()
+		for i in range( 0, 200 ) :
+			numVertices = 4 + i % 5
+			verticesPerCurve.append( numVertices )
+			for j in range( 0, numVertices ) :
+				p.append( imath.V3f( i, j, ( i * j ) % 3 ) )
+
+		for periodic in ( False, True ) :
+
+			c = IECoreScene.CurvesPrimitive( verticesPerCurve, IECore.CubicBasisf.catmullRom(), periodic, p )
+			c["Cs"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+				IECore.Color3fVectorData( [ imath.Color3f( x[1], x[0], x[2] ) for x in p ] )
+			)
+			c["f"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Varying,
+				IECore.FloatVectorData( [ float( x ) for x in range( 0, c.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Varying ) ) ] )
+			)
+			c["u"] = IECoreScene.PrimitiveVariable(
+				IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+				IECore.IntVectorData( range( 0, c.numCurves() ) )
+			)
+
+			c2 = IECoreScene.CurveLineariser()( input=c, verticesPerSegment=4 )
+			self.assertTrue( c2.arePrimitiveVariablesValid() )
+			self.assertEqual( c2["P"].data.getInterpretation(), IECore.GeometricData.Interpretation.Point )
+			self.assertEqual( c2["u"], c["u"] )
+
+			# Each new vertex should be the original curve evaluated at the
+			# appropriate parameter.
+
+			e = IECoreScene.CurvesPrimitiveEvaluator( c )
+			r = e.createResult()
+			vertexIndex = 0
+			for curveIndex in range( 0, c.numCurves() ) :
+				numVertices = c2.verticesPerCurve()[curveIndex]
+				vStep = 1.0 / numVertices if periodic else 1.0 / ( numVertices - 1 )
+				for i in range( 0, numVertices ) :
+					self.assertTrue( e.pointAtV( curveIndex, min( i * vStep, 1.0 ), r ) )
+					self.assertTrue( c2["P"].data[vertexIndex].equalWithAbsError( r.point(), 0.0001 ) )
+					self.assertTrue( c2["Cs"].data[vertexIndex].equalWithAbsError( r.colorPrimVar( c["Cs"] ), 0.0001 ) )
+					self.assertAlmostEqual( c2["f"].data[vertexIndex], r.floatPrimVar( c["f"] ), 4 )
+					vertexIndex += 1
+
 if __name__ == "__main__":
 	unittest.main()
 
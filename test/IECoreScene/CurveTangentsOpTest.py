@@ -61,5 +61,33 @@ class CurveTangentsOpTest( unittest.TestCase ) :
 		for v in curves["myTangent"].data :
 			self.assertTrue( v.equalWithAbsError( imath.V3f( 1, 0, 0 ), 0.000001 ) )
 
+	def testManyCurves( self ) :
+
+		verticesPerCurve = IECore.IntVectorData()
+		p = IECore.V3fVectorData()
+		for i in range( 0, 200 ) :
+			numVertices = 4 + i % 5
+			verticesPerCurve.append( numVertices )
+			for j in range( 0, numVertices ) :
+				p.append( imath.V3f( i + math.sin( j ), j, math.cos( i * j ) ) )
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bSpline() ) :
+			for periodic in ( False, True ) :
+
+				c = IECoreScene.CurvesPrimitive( verticesPerCurve, basis, periodic, p )
+				curves = IECoreScene.CurveTangentsOp()( input = c )
+				tangents = curves["vTangent"].data
+				self.assertEqual( len( tangents ), len( p ) )
+
+				e = IECoreScene.CurvesPrimitiveEvaluator( c )
+				r = e.createResult()
+				vertexIndex = 0
+				for curveIndex in range( 0, c.numCurves() ) :
+					numVertices = verticesPerCurve[curveIndex]
+					for i in range( 0, numVertices ) :
+						self.assertTrue( e.pointAtV( curveIndex, min( 1.0, i * ( 1.0 / numVertices ) ), r ) )
+						self.assertTrue( tangents[vertexIndex].equalWithAbsError( r.vTangent().normalized(), 0.0001 ) )
+						vertexIndex += 1
+
 if __name__ == "__main__":
     unittest.main()
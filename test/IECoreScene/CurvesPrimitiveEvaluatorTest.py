@@ -1238,6 +1238,50 @@ class CurvesPrimitiveEvaluatorTest( unittest.TestCase ) :
 
 		self.assertTrue( isinstance( e, IECoreScene.CurvesPrimitiveEvaluator ) )
 
+	def testBatchClosestPoint( self ) :
+
+		rand = imath.Rand32()
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bSpline(), IECore.CubicBasisf.catmullRom() ) :
+
+			p = IECore.V3fVectorData()
+			vertsPerCurve = IECore.IntVectorData()
+			for c in range( 0, 20 ) :
+				numVerts = 4 + basis.step * int( rand.nextf( 0, 5 ) )
+				vertsPerCurve.append( numVerts )
+				for i in range( 0, numVerts ) :
+					p.append( imath.V3f( rand.nextf(), rand.nextf(), rand.nextf() ) + imath.V3f( c * 0.2 ) )
+
+			curves = IECoreScene.CurvesPrimitive( vertsPerCurve, basis, False, p )
+			e = IECoreScene.CurvesPrimitiveEvaluator( curves )
+			r = e.createResult()
+
+			points = IECore.V3fVectorData( [ imath.V3f( rand.nextf( -1, 5 ), rand.nextf( -1, 5 ), rand.nextf( -1, 5 ) ) for i in range( 0, 1000 ) ] )
+			curveIndices, v, positions = e.batchClosestPoint( points )
+			self.assertEqual( len( curveIndices ), len( points ) )
+
+			for i, point in enumerate( points ) :
+				self.assertTrue( e.closestPoint( point, r ) )
+				self.assertEqual( curveIndices[i], r.curveIndex() )
+				self.assertEqual( v[i], r.uv()[1] )
+				self.assertEqual( positions[i], r.point() )
+
+			# Limited distance
+
+			curveIndices, v, positions = e.batchClosestPoint( points, maxDistance = 0.5 )
+			for i, point in enumerate( points ) :
+				e.closestPoint( point, r )
+				if ( r.point() - point ).length() < 0.45 :
+					self.assertEqual( curveIndices[i], r.curveIndex() )
+				elif ( r.point() - point ).length() > 0.55 :
+					self.assertEqual( curveIndices[i], -1 )
+
+		# Empty curves
+
+		curves = IECoreScene.CurvesPrimitive( IECore.IntVectorData(), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData() )
+		curveIndices, v, positions = IECoreScene.CurvesPrimitiveEvaluator( curves ).batchClosestPoint( points )
+		self.assertEqual( curveIndices, IECore.IntVectorData( [ -1 ] * len( points ) ) )
+
 	def testParallelResultCreation( self ) :
 
 		IECoreScene.testCurvesPrimitiveEvaluatorParallelResultCreation()
@@ -176,6 +176,27 @@ class MeshAlgoDistributePointsTest( unittest.TestCase ) :
 
 		self.assertEqual( p, p2 )
 
+	def testThreadCountIndependence( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+		m["density"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( [ ( p.x + 1 ) / 2 for p in m["P"].data ] )
+		)
+
+		with IECore.tbb_task_scheduler_init( 1 ) :
+			p = IECoreScene.MeshAlgo.distributePoints( mesh = m, density = 10000 )
+
+		for threads in ( 2, 8 ) :
+			with IECore.tbb_task_scheduler_init( threads ) :
+				self.assertEqual( IECoreScene.MeshAlgo.distributePoints( mesh = m, density = 10000 ), p )
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testPerformance( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 1000 ) )
+		IECoreScene.MeshAlgo.distributePoints( mesh = m, density = 10000000 )
+
 	def setUp( self ) :
 
 		os.environ["CORTEX_POINTDISTRIBUTION_TILESET"] = "test/IECore/data/pointDistributions/pointDistributionTileSet2048.dat"
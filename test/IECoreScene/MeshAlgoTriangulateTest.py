@@ -32,8 +32,10 @@
 #
 ##########################################################################
 
+import multiprocessing
 import os
 import random
+import threading
 import unittest
 import imath
 
@@ -284,6 +286,59 @@ class MeshAlgoTriangulateTest( unittest.TestCase ) :
 		self.assertEqual( m2.creaseIds(), m.creaseIds() )
 		self.assertEqual( m2.creaseSharpnesses(), m.creaseSharpnesses() )
 
+	def testThreading( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+		expected = IECoreScene.MeshAlgo.triangulate( mesh )
+
+		results = [ None ] * 8
+		def f( i ) :
+			results[i] = IECoreScene.MeshAlgo.triangulate( mesh )
+
+		threads = [ threading.Thread( target = f, args = ( i, ) ) for i in range( 0, len( results ) ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		for r in results :
+			self.assertEqual( r, expected )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testThreadingPerformance( self ) :
+
+		# The GIL is released during triangulation, so work
+		# shared between Python threads should run in parallel.
+
+		numThreads = max( min( multiprocessing.cpu_count(), 4 ), 2 )
+
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 1000 ) )
+		numTriangulations = numThreads * 4
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		for i in range( 0, numTriangulations ) :
+			IECoreScene.MeshAlgo.triangulate( mesh )
+		serialTime = timer.stop()
+
+		def f() :
+			for i in range( 0, numTriangulations // numThreads ) :
+				IECoreScene.MeshAlgo.triangulate( mesh )
+
+		threads = [ threading.Thread( target = f ) for i in range( 0, numThreads ) ]
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+		threadedTime = timer.stop()
+
+		# Triangulation is already parallel internally, so the speedup
+		# depends heavily on the machine and its load. We report the
+		# timings rather than asserting a particular ratio.
+		print( "serial time: {0}s".format( serialTime ) )
+		print( "threaded time ({0} threads): {1}s".format( numThreads, threadedTime ) )
+
 	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
 	def testTriangulatePerformance( self ):
 
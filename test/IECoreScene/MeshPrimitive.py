@@ -530,6 +530,32 @@ class TestMeshPrimitive( unittest.TestCase ) :
 		m2 = IECore.Object.load( io, "test" )
 		self.assertEqual( m, m2 )
 
+	def testLazyLoading( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ), imath.V2i( 200 ) )
+		m["Cs"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.Color3fVectorData( [ imath.Color3f( i ) for i in range( 0, m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) ) ] )
+		)
+
+		self.addCleanup( IECore.Data.setLazyLoading, IECore.Data.getLazyLoading() )
+		IECore.Data.setLazyLoading( True )
+
+		io = IECore.FileIndexedIO( "test/IECore/mesh.fio", [], IECore.IndexedIO.OpenMode.Write )
+		m.save( io, "test" )
+		del io
+
+		io = IECore.FileIndexedIO( "test/IECore/mesh.fio", [], IECore.IndexedIO.OpenMode.Read )
+		m2 = IECore.Object.load( io, "test" )
+		self.assertLess( m2.memoryUsage(), m.memoryUsage() )
+		self.assertEqual( m2.hash(), m.hash() )
+
+		# Accessing P doesn't load Cs.
+		self.assertEqual( m2.bound(), m.bound() )
+		self.assertLess( m2.memoryUsage(), m.memoryUsage() )
+
+		self.assertEqual( m2, m )
+
 	def tearDown( self ) :
 
 		for f in (
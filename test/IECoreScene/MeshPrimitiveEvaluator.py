@@ -370,6 +370,84 @@ class TestMeshPrimitiveEvaluator( unittest.TestCase ) :
 					hits = mpe.intersectionPoints( origin, direction )
 					self.assertFalse( hits )
 
+	def testBatchClosestPoint( self ) :
+
+		m = IECore.Reader.create( "test/IECore/data/cobFiles/pSphereShape1.cob" ).read()
+		mpe = IECoreScene.MeshPrimitiveEvaluator( m )
+		r = mpe.createResult()
+
+		random.seed( 2 )
+		points = IECore.V3fVectorData( [
+			imath.V3f( random.uniform( -3, 3 ), random.uniform( -3, 3 ), random.uniform( -3, 3 ) )
+			for i in range( 0, 1000 )
+		] )
+
+		triangleIndices, barycentricCoordinates, positions = mpe.batchClosestPoint( points )
+		self.assertEqual( len( triangleIndices ), len( points ) )
+
+		for i, p in enumerate( points ) :
+
+			self.assertTrue( mpe.closestPoint( p, r ) )
+			self.assertAlmostEqual( ( positions[i] - p ).length(), ( r.point() - p ).length(), 5 )
+
+			self.assertTrue( mpe.barycentricPosition( triangleIndices[i], barycentricCoordinates[i], r ) )
+			self.assertTrue( r.point().equalWithAbsError( positions[i], 0.00001 ) )
+
+		# Limited distance
+
+		triangleIndices, barycentricCoordinates, positions = mpe.batchClosestPoint( points, maxDistance = 0.5 )
+		for i, p in enumerate( points ) :
+
+			mpe.closestPoint( p, r )
+			if ( r.point() - p ).length() < 0.49 :
+				self.assertNotEqual( triangleIndices[i], -1 )
+			elif ( r.point() - p ).length() > 0.51 :
+				self.assertEqual( triangleIndices[i], -1 )
+
+		# Empty mesh
+
+		m = IECoreScene.MeshPrimitive()
+		m["P"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.V3fVectorData() )
+		triangleIndices, barycentricCoordinates, positions = IECoreScene.MeshPrimitiveEvaluator( m ).batchClosestPoint( points )
+		self.assertEqual( triangleIndices, IECore.IntVectorData( [ -1 ] * len( points ) ) )
+
+	def testBatchIntersectionPoint( self ) :
+
+		m = IECore.Reader.create( "test/IECore/data/cobFiles/pSphereShape1.cob" ).read()
+		mpe = IECoreScene.MeshPrimitiveEvaluator( m )
+		r = mpe.createResult()
+
+		random.seed( 3 )
+		rand = imath.Rand48( 3 )
+		origins = IECore.V3fVectorData()
+		directions = IECore.V3fVectorData()
+		for i in range( 0, 1000 ) :
+			origins.append( imath.V3f( random.uniform( -3, 3 ), random.uniform( -3, 3 ), random.uniform( -3, 3 ) ) )
+			directions.append( rand.nextHollowSphere( imath.V3f() ) * random.uniform( 0.1, 10 ) )
+
+		triangleIndices, barycentricCoordinates, positions = mpe.batchIntersectionPoint( origins, directions )
+		self.assertEqual( len( triangleIndices ), len( origins ) )
+
+		for i in range( 0, len( origins ) ) :
+
+			hit = mpe.intersectionPoint( origins[i], directions[i], r )
+			self.assertEqual( hit, triangleIndices[i] != -1 )
+			if not hit :
+				continue
+
+			self.assertTrue( r.point().equalWithAbsError( positions[i], 0.0001 ) )
+			self.assertTrue( mpe.barycentricPosition( triangleIndices[i], barycentricCoordinates[i], r ) )
+			self.assertTrue( r.point().equalWithAbsError( positions[i], 0.0001 ) )
+
+		# Limited distance
+
+		triangleIndices, barycentricCoordinates, positions = mpe.batchIntersectionPoint( origins, directions, maxDistance = 1 )
+		for i in range( 0, len( origins ) ) :
+			if triangleIndices[i] != -1 :
+				self.assertLess( ( positions[i] - origins[i] ).length(), 1 )
+
+		self.assertRaises( Exception, mpe.batchIntersectionPoint, origins, IECore.V3fVectorData() )
+
 	def testEvaluateIndexedPrimitiveVariables( self ) :
 
 		m = IECoreScene.MeshPrimitive(
@@ -32,8 +32,11 @@
 #
 ##########################################################################
 
+import os
 import unittest
 import sys
+import time
+import imath
 import IECore
 import IECoreScene
 
@@ -97,6 +100,109 @@ class TestOBJReader( unittest.TestCase ) :
 		self.assertTrue( mesh.isInstanceOf( IECoreScene.MeshPrimitive.staticTypeId() ) )
 		self.assertTrue( mesh.arePrimitiveVariablesValid() )
 
+	def testSkipNormalsAndTextureCoordinates( self ) :
+
+		r = IECore.Reader.create( 'test/IECore/data/obj/triangle_normals.obj' )
+		r["readNormals"].setTypedValue( False )
+		mesh = r.read()
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+		self.assertEqual( set( mesh.keys() ), { "P", "s", "t" } )
+
+		r["readNormals"].setTypedValue( True )
+		r["readTextureCoordinates"].setTypedValue( False )
+		mesh = r.read()
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+		self.assertEqual( set( mesh.keys() ), { "P", "N" } )
+
+	def testValues( self ) :
+
+		mesh = IECore.Reader.create( 'test/IECore/data/obj/triangle_normals.obj' ).read()
+
+		self.assertEqual( mesh.verticesPerFace, IECore.IntVectorData( [ 3 ] ) )
+		self.assertEqual( mesh.vertexIds, IECore.IntVectorData( [ 0, 1, 2 ] ) )
+		self.assertEqual( list( mesh["P"].data ), [ imath.V3f( 0 ), imath.V3f( 2, 0, 0 ), imath.V3f( 2, 0, 2 ) ] )
+		self.assertEqual( mesh["s"].data, IECore.FloatVectorData( [ 0, 1, 1 ] ) )
+		self.assertEqual( mesh["t"].data, IECore.FloatVectorData( [ 0, 0, 1 ] ) )
+		self.assertEqual( list( mesh["N"].data ), [ imath.V3f( 1, 0, 0 ), imath.V3f( 0, 1, 0 ), imath.V3f( 0, 1, 0 ) ] )
+
+		mesh = IECore.Reader.create( 'test/IECore/data/obj/groups.obj' ).read()
+		self.assertEqual( mesh.vertexIds, IECore.IntVectorData( range( 0, 9 ) ) )
+
+	def __writeGrid( self, fileName, divisions ) :
+
+		with open( fileName, "w" ) as f :
+			for y in range( 0, divisions + 1 ) :
+				for x in range( 0, divisions + 1 ) :
+					f.write( "v %f %f 0.5\nvt %f %f\n" % ( x, y, x / float( divisions ), y / float( divisions ) ) )
+			f.write( "vn 0 0 1\n" )
+			for y in range( 0, divisions ) :
+				for x in range( 0, divisions ) :
+					i = y * ( divisions + 1 ) + x + 1
+					j = i + divisions + 1
+					if ( x + y ) % 2 :
+						f.write( "f %d/%d/1 %d/%d/1 %d/%d/1 %d/%d/1\n" % ( i, i, i + 1, i + 1, j + 1, j + 1, j, j ) )
+					else :
+						# Relative indices, which must be resolved relative to
+						# all vertices read so far, not just those in the
+						# current chunk of the file.
+						n = ( divisions + 1 ) * ( divisions + 1 ) + 1
+						f.write( "f %d/%d/-1 %d/%d/-1 %d/%d/-1 %d/%d/-1\n" % ( i - n, i - n, i + 1 - n, i + 1 - n, j + 1 - n, j + 1 - n, j - n, j - n ) )
+
+	def testLargeFile( self ) :
+
+		# Large enough to be split into several chunks.
+		self.__writeGrid( "test/OBJReaderTest.obj", 200 )
+
+		mesh = IECore.Reader.create( "test/OBJReaderTest.obj" ).read()
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+		self.assertEqual( mesh.numFaces(), 200 * 200 )
+		self.assertEqual( mesh.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ), 201 * 201 )
+
+		P = mesh["P"].data
+		s = mesh["s"].data
+		t = mesh["t"].data
+		N = mesh["N"].data
+		for i, vertexId in enumerate( mesh.vertexIds ) :
+			self.assertAlmostEqual( s[i], P[vertexId][0] / 200, 5 )
+			self.assertAlmostEqual( t[i], P[vertexId][1] / 200, 5 )
+			self.assertEqual( N[i], imath.V3f( 0, 0, 1 ) )
+
+		self.assertEqual( mesh.bound(), imath.Box3f( imath.V3f( 0, 0, 0.5 ), imath.V3f( 200, 200, 0.5 ) ) )
+
+	def testMissingFile( self ) :
+
+		r = IECoreScene.OBJReader( "test/IECore/data/obj/nonexistent.obj" )
+		self.assertRaises( RuntimeError, r.read )
+
+	def testZeroIndex( self ) :
+
+		for face in ( "f 0 1 2", "f 1/0 2/1 3/1", "f 1//0 2//1 3//1" ) :
+			with open( "test/OBJReaderTest.obj", "w" ) as f :
+				f.write( "v 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\nvn 0 0 1\n%s\n" % face )
+			self.assertRaises( RuntimeError, IECore.Reader.create( "test/OBJReaderTest.obj" ).read )
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testPerformance( self ) :
+
+		self.__writeGrid( "test/OBJReaderTest.obj", 2000 )
+
+		for readNormals, readTextureCoordinates in ( ( True, True ), ( False, False ) ) :
+
+			r = IECore.Reader.create( "test/OBJReaderTest.obj" )
+			r["readNormals"].setTypedValue( readNormals )
+			r["readTextureCoordinates"].setTypedValue( readTextureCoordinates )
+
+			t = time.time()
+			mesh = r.read()
+			t = time.time() - t
+			self.assertEqual( mesh.numFaces(), 2000 * 2000 )
+			print( "normals {0}, uvs {1}, time: {2}s".format( readNormals, readTextureCoordinates, t ) )
+
+	def tearDown( self ) :
+
+		if os.path.isfile( "test/OBJReaderTest.obj" ) :
+			os.remove( "test/OBJReaderTest.obj" )
+
 if __name__ == "__main__":
 
 	unittest.main()
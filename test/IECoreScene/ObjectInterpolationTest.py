@@ -134,5 +134,65 @@ class ObjectInterpolationTest( unittest.TestCase ) :
 		self.assertTrue( "v" in m3 )
 		self.assertEqual( m3["v"], m1["v"])
 
+	def testInterpolationOfLargeArrays( self ) :
+
+		m1 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 200 ) )
+		m2 = m1.copy()
+		m2["P"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ p * 2 + imath.V3f( 1 ) for p in m1["P"].data ], IECore.GeometricData.Interpretation.Point )
+		)
+		m1["f"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( [ i for i in range( 0, m1.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) ) ] ) )
+		m2["f"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( [ -i for i in range( 0, m1.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) ) ] ) )
+
+		m3 = IECore.linearObjectInterpolation( m1, m2, 0.25 )
+		self.assertEqual( m3.verticesPerFace, m1.verticesPerFace )
+		self.assertEqual( m3.vertexIds, m1.vertexIds )
+		self.assertEqual( m3["P"].data.getInterpretation(), IECore.GeometricData.Interpretation.Point )
+		for i in range( 0, len( m3["P"].data ), 997 ) :
+			self.assertEqual( m3["P"].data[i], m1["P"].data[i] + ( m2["P"].data[i] - m1["P"].data[i] ) * 0.25 )
+			self.assertAlmostEqual( m3["f"].data[i], i * 0.5 )
+
+	def testInterpolationIntoExistingPrimitive( self ) :
+
+		m1 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		m1["s"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Constant, IECore.StringData( "hi" ) )
+		m1.blindData()["a"] = IECore.FloatData( 10 )
+		m2 = IECoreScene.TransformOp()( input=m1, primVarsToModify = IECore.StringVectorData( [ "P" ] ), matrix = IECore.M44fData( imath.M44f().scale( imath.V3f( 2 ) ) ) )
+		m2.blindData()["a"] = IECore.FloatData( 20 )
+
+		# Start with a primitive that has nothing in common with the inputs,
+		# then interpolate into it repeatedly, as we would for each shutter sample.
+		result = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		result["extra"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Constant, IECore.IntData( 1 ) )
+
+		for x in ( 0, 0.25, 0.5, 1 ) :
+			self.assertTrue( IECoreScene.linearPrimitiveInterpolation( m1, m2, x, result ) )
+			self.assertEqual( result, IECore.linearObjectInterpolation( m1, m2, x ) )
+			self.assertEqual( result, IECoreScene.linearPrimitiveInterpolation( m1, m2, x ) )
+
+		self.assertFalse( "extra" in result )
+		self.assertEqual( result.blindData()["a"], IECore.FloatData( 20 ) )
+
+		# Data we've been given must never be modified.
+		p = result["P"].data
+		pCopy = p.copy()
+		self.assertTrue( IECoreScene.linearPrimitiveInterpolation( m1, m2, 0.5, result ) )
+		self.assertEqual( p, pCopy )
+		self.assertNotEqual( result["P"].data, pCopy )
+
+	def testInterpolationIntoExistingPrimitiveErrors( self ) :
+
+		m1 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		m2 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 2 ) )
+
+		result = IECoreScene.MeshPrimitive()
+		resultCopy = result.copy()
+		self.assertFalse( IECoreScene.linearPrimitiveInterpolation( m1, m2, 0.5, result ) )
+		self.assertEqual( result, resultCopy )
+
+		self.assertRaises( RuntimeError, IECoreScene.linearPrimitiveInterpolation, m1, m1, 0.5, m1 )
+		self.assertRaises( RuntimeError, IECoreScene.linearPrimitiveInterpolation, m1, m1, 0.5, IECoreScene.PointsPrimitive( 4 ) )
+
 if __name__ == "__main__":
     unittest.main()
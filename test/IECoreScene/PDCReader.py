@@ -38,6 +38,8 @@ import unittest
 import sys
 import os
 
+import imath
+
 import IECore
 import IECoreScene
 
@@ -338,6 +340,43 @@ class TestPDCReader( unittest.TestCase ) :
 		self.assertEqual( len( c.messages ), 1 )
 		self.assertEqual( c.messages[0].level, IECore.Msg.Level.Warning )
 
+	def testReadAttributeMatchesRead( self ) :
+
+		# Large enough that each attribute is read by several tasks.
+		numPoints = 100000
+		p = IECoreScene.PointsPrimitive( IECore.V3dVectorData( [ imath.V3d( i, -i, i * 0.5 ) for i in range( 0, numPoints ) ] ) )
+		p["particleId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( range( 0, numPoints ) ) )
+		p["mass"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.DoubleVectorData( [ i * 0.25 for i in range( 0, numPoints ) ] ) )
+		p["constant"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Constant, IECore.DoubleData( 10 ) )
+		IECore.Writer.create( p, "test/particleShape1.250.pdc" ).write()
+
+		r = IECoreScene.PDCParticleReader( "test/particleShape1.250.pdc" )
+		r["realType"].setValue( "native" )
+		r["convertPrimVarNames"].setTypedValue( False )
+		c = r.read()
+
+		self.assertEqual( c.numPoints, numPoints )
+		for name in [ "P", "particleId", "mass", "constant" ] :
+			self.assertEqual( c[name].data, r.readAttribute( name ) )
+
+		self.assertEqual( list( c["P"].data ), list( p["P"].data ) )
+		self.assertEqual( c["particleId"].data, p["particleId"].data )
+		self.assertEqual( c["mass"].data, p["mass"].data )
+		self.assertEqual( c["constant"].data, p["constant"].data )
+
+		r["attributes"].setValue( IECore.StringVectorData( [ "mass" ] ) )
+		c = r.read()
+		self.assertEqual( c.keys(), [ "mass" ] )
+		self.assertEqual( c["mass"].data, p["mass"].data )
+
+		r["attributes"].setValue( IECore.StringVectorData( [ "mass", "P" ] ) )
+		r["percentage"].setTypedValue( 50 )
+		c = r.read()
+		self.assertEqual( c["mass"].data, r.readAttribute( "mass" ) )
+		self.assertEqual( c["P"].data, r.readAttribute( "P" ) )
+		self.assertEqual( len( c["mass"].data ), len( c["P"].data ) )
+		self.assertLess( len( c["mass"].data ), numPoints )
+
 	def tearDown( self ) :
 
 		if os.path.isfile( "test/particleShape1.250.pdc" ) :
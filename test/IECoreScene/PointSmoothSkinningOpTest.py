@@ -33,6 +33,8 @@
 #
 ##########################################################################
 
+import os
+import math
 import unittest
 import imath
 import IECore
@@ -220,6 +222,101 @@ class PointSmoothSkinningOpTest( unittest.TestCase ) :
 		o(input=pts, positionVar="bob", copyInput=False, deformationPose = self.myDP(), smoothSkinningData = self.mySSD( ))
 		self.assertNotEqual(pts["bob"].data , self.myP())
 
+	def twoJointSSD( self, weights ) :
+
+		# two joints at the origin, with each point influenced by both using the given weights for the second joint
+		numPoints = len( weights )
+		return IECoreScene.SmoothSkinningData(
+			IECore.StringVectorData( [ "joint1", "joint2" ] ),
+			IECore.M44fVectorData( [ imath.M44f(), imath.M44f() ] ),
+			IECore.IntVectorData( [ i * 2 for i in range( 0, numPoints ) ] ),
+			IECore.IntVectorData( [ 2 ] * numPoints ),
+			IECore.IntVectorData( [ 0, 1 ] * numPoints ),
+			IECore.FloatVectorData( sum( [ [ 1 - w, w ] for w in weights ], [] ) ),
+		)
+
+	def testDualQuaternionRigidDeformation( self ) :
+
+		# with a single influence per point, linear and dual quaternion blending
+		# should both apply the influence's transform exactly
+
+		pts = self.myPP()
+		pose = IECore.M44fVectorData( [
+			imath.M44f(),
+			imath.M44f().rotate( imath.V3f( 0.3, 0.2, 1.1 ) ).translate( imath.V3f( 1, 2, 3 ) ),
+		] )
+		ssd = self.twoJointSSD( [ 1 ] * len( pts["P"].data ) )
+
+		o = IECoreScene.PointSmoothSkinningOp()
+		linear = o( input = pts, deformationPose = pose, smoothSkinningData = ssd, deformNormals = True, blend = IECoreScene.PointSmoothSkinningOp.Blend.Linear )
+		dualQuaternion = o( input = pts, deformationPose = pose, smoothSkinningData = ssd, deformNormals = True, blend = IECoreScene.PointSmoothSkinningOp.Blend.DualQuaternion )
+
+		for i in range( 0, len( pts["P"].data ) ) :
+			expectedP = pts["P"].data[i] * pose[1]
+			expectedN = pose[1].multDirMatrix( pts["N"].data[i] )
+			self.assertTrue( linear["P"].data[i].equalWithAbsError( expectedP, 0.0001 ) )
+			self.assertTrue( dualQuaternion["P"].data[i].equalWithAbsError( expectedP, 0.0001 ) )
+			self.assertTrue( linear["N"].data[i].equalWithAbsError( expectedN, 0.0001 ) )
+			self.assertTrue( dualQuaternion["N"].data[i].equalWithAbsError( expectedN, 0.0001 ) )
+
+	def testDualQuaternionPreservesVolume( self ) :
+
+		# blending halfway to a 90 degree twist should rotate by 45 degrees
+		# rather than pulling the point towards the axis
+
+		pts = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( 1, 0, 0 ), imath.V3f( 0, 1, 5 ) ] ) )
+		pose = IECore.M44fVectorData( [ imath.M44f(), imath.M44f().rotate( imath.V3f( 0, 0, math.pi / 2 ) ) ] )
+		ssd = self.twoJointSSD( [ 0.5, 0.5 ] )
+
+		o = IECoreScene.PointSmoothSkinningOp()
+		linear = o( input = pts, deformationPose = pose, smoothSkinningData = ssd, blend = IECoreScene.PointSmoothSkinningOp.Blend.Linear )
+		dualQuaternion = o( input = pts, deformationPose = pose, smoothSkinningData = ssd, blend = IECoreScene.PointSmoothSkinningOp.Blend.DualQuaternion )
+
+		h = math.sqrt( 0.5 )
+		self.assertTrue( linear["P"].data[0].equalWithAbsError( imath.V3f( 0.5, 0.5, 0 ), 0.0001 ) )
+		self.assertTrue( dualQuaternion["P"].data[0].equalWithAbsError( imath.V3f( h, h, 0 ), 0.0001 ) )
+		self.assertTrue( dualQuaternion["P"].data[1].equalWithAbsError( imath.V3f( -h, h, 5 ), 0.0001 ) )
+
+	def testRepeatedDeformation( self ) :
+
+		# the op keeps the rearranged weights between calls, so check that
+		# changes to the skinning data and reference indices are still respected
+
+		pose = IECore.M44fVectorData( [ imath.M44f(), imath.M44f().translate( imath.V3f( 0, 1, 0 ) ) ] )
+		ssd = self.twoJointSSD( [ 0, 0.5, 1 ] )
+		pts = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( i, 0, 0 ) for i in range( 0, 3 ) ] ) )
+
+		o = IECoreScene.PointSmoothSkinningOp()
+		for i in range( 0, 2 ) :
+			result = o( input = pts, deformationPose = pose, smoothSkinningData = ssd )
+			self.assertEqual( result["P"].data, IECore.V3fVectorData( [ imath.V3f( 0, 0, 0 ), imath.V3f( 1, 0.5, 0 ), imath.V3f( 2, 1, 0 ) ] ) )
+
+		ssd.pointInfluenceWeights()[0] = 0.75
+		ssd.pointInfluenceWeights()[1] = 0.25
+		result = o( input = pts, deformationPose = pose, smoothSkinningData = ssd )
+		self.assertEqual( result["P"].data, IECore.V3fVectorData( [ imath.V3f( 0, 0.25, 0 ), imath.V3f( 1, 0.5, 0 ), imath.V3f( 2, 1, 0 ) ] ) )
+
+		result = o( input = pts, deformationPose = pose, smoothSkinningData = ssd, referenceIndices = IECore.IntVectorData( [ 2, 2, 0 ] ) )
+		self.assertEqual( result["P"].data, IECore.V3fVectorData( [ imath.V3f( 0, 1, 0 ), imath.V3f( 1, 1, 0 ), imath.V3f( 2, 0.25, 0 ) ] ) )
+
+		self.assertRaises(
+			RuntimeError, o, input = pts, deformationPose = pose, smoothSkinningData = ssd,
+			referenceIndices = IECore.IntVectorData( [ 0, 1, 3 ] )
+		)
+
+	@unittest.skipUnless( os.environ.get( "CORTEX_PERFORMANCE_TEST", False ), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testPerformance( self ) :
+
+		numPoints = 1000000
+		pts = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( i, 0, 0 ) for i in range( 0, numPoints ) ] ) )
+		ssd = self.twoJointSSD( [ float( i ) / numPoints for i in range( 0, numPoints ) ] )
+
+		o = IECoreScene.PointSmoothSkinningOp()
+		for blend in IECoreScene.PointSmoothSkinningOp.Blend.values.values() :
+			for i in range( 0, 10 ) :
+				pose = IECore.M44fVectorData( [ imath.M44f(), imath.M44f().rotate( imath.V3f( 0, 0, i * 0.1 ) ) ] )
+				o( input = pts, deformationPose = pose, smoothSkinningData = ssd, blend = blend )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -77,6 +77,29 @@ class PointsPrimitiveEvaluatorTest( unittest.TestCase ) :
 		self.assertEqual( r.colorPrimVar( p["Cs"] ), imath.Color3f( 5, 0, 0 ) )
 		self.assertEqual( r.stringPrimVar( p["names"] ), "a" )
 
+	def testBatchQueries( self ) :
+
+		p = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, 10 ) ] ) )
+		e = IECoreScene.PointsPrimitiveEvaluator( p )
+
+		queries = IECore.V3fVectorData( [ imath.V3f( 0.1, 0, 0 ), imath.V3f( 5.4, 1, 0 ), imath.V3f( 100, 0, 0 ) ] )
+
+		offsets, indices, distances = e.batchNearestNNeighbours( queries, 2 )
+		self.assertEqual( offsets, IECore.IntVectorData( [ 0, 2, 4, 6 ] ) )
+		self.assertEqual( indices, IECore.IntVectorData( [ 0, 1, 5, 6, 9, 8 ] ) )
+		for i, d in enumerate( [ 0.1, 0.9, ( 0.4 ** 2 + 1 ) ** 0.5, ( 0.6 ** 2 + 1 ) ** 0.5, 91, 92 ] ) :
+			self.assertAlmostEqual( distances[i], d, 5 )
+
+		offsets, indices, distances = e.batchPointsInRadius( queries, 1.5 )
+		self.assertEqual( offsets, IECore.IntVectorData( [ 0, 2, 4, 4 ] ) )
+		self.assertEqual( set( indices[0:2] ), { 0, 1 } )
+		self.assertEqual( set( indices[2:4] ), { 5, 6 } )
+
+		e = IECoreScene.PointsPrimitiveEvaluator( IECoreScene.PointsPrimitive( IECore.V3fVectorData() ) )
+		offsets, indices, distances = e.batchNearestNNeighbours( queries, 2 )
+		self.assertEqual( offsets, IECore.IntVectorData( [ 0, 0, 0, 0 ] ) )
+		self.assertEqual( len( indices ), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
 
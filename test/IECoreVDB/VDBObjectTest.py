@@ -38,6 +38,7 @@ import os
 import imath
 
 import IECore
+import IECoreScene
 import IECoreVDB
 from VDBTestCase import VDBTestCase
 
@@ -260,6 +261,73 @@ class VDBObjectTest( VDBTestCase ) :
 		emptyVDB = IECoreVDB.VDBObject()
 		self.assertEqual( emptyVDB.fileName(), "" )
 
+	def testTopologyHash( self ) :
+		sourcePath = os.path.join( self.dataDir, "smoke.vdb" )
+		smoke = IECoreVDB.VDBObject( sourcePath )
+
+		smoke2 = smoke.copy()
+		d = smoke2.findGrid( "density" )
+
+		def incValue( value ) :
+			return value + 1
+
+		d.mapAll( incValue )
+		smoke2.insertGrid( d )
+
+		self.assertNotEqual( smoke.hash(), smoke2.hash() )
+		self.assertEqual( smoke.topologyHash(), smoke2.topologyHash() )
+
+		smoke2.removeGrid( "density" )
+		self.assertNotEqual( smoke.topologyHash(), smoke2.topologyHash() )
+
+	def testSaveAndLoad( self ) :
+		sourcePath = os.path.join( self.dataDir, "smoke.vdb" )
+		smoke = IECoreVDB.VDBObject( sourcePath )
+
+		saveIO = IECore.MemoryIndexedIO( IECore.CharVectorData(), IECore.IndexedIO.OpenMode.Write )
+		smoke.save( saveIO, "smoke" )
+
+		loadIO = IECore.MemoryIndexedIO( saveIO.buffer(), IECore.IndexedIO.OpenMode.Read )
+		smoke2 = IECore.Object.load( loadIO, "smoke" )
+
+		self.assertEqual( smoke2.gridNames(), [ "density" ] )
+		self.assertEqual( smoke2.bound(), smoke.bound() )
+		self.assertEqual( smoke2.topologyHash(), smoke.topologyHash() )
+		self.assertEqual( smoke2, smoke )
+
+		self.assertEqual( smoke2.findGrid( "density" ).leafCount(), 3117 )
+		self.assertEqual( smoke2.bound(), smoke.bound() )
+
+	def testSceneCache( self ) :
+		sourcePath = os.path.join( self.dataDir, "smoke.vdb" )
+		smoke = IECoreVDB.VDBObject( sourcePath )
+
+		scene = IECoreScene.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		scene.createChild( "vdb" ).writeObject( smoke, 0.0 )
+		del scene
+
+		scene = IECoreScene.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Read )
+		smoke2 = scene.child( "vdb" ).readObject( 0.0 )
+
+		# bounds and hashes are available without reading the voxel data.
+		self.assertEqual( smoke2.bound(), smoke.bound() )
+		self.assertEqual( smoke2.topologyHash(), smoke.topologyHash() )
+		self.assertLess( smoke2.memoryUsage(), smoke.memoryUsage() )
+
+		# saving an unloaded grid copies it without reading it.
+		saveIO = IECore.MemoryIndexedIO( IECore.CharVectorData(), IECore.IndexedIO.OpenMode.Write )
+		smoke2.save( saveIO, "smoke" )
+		loadIO = IECore.MemoryIndexedIO( saveIO.buffer(), IECore.IndexedIO.OpenMode.Read )
+		smoke3 = IECore.Object.load( loadIO, "smoke" )
+
+		for vdb in ( smoke2, smoke3 ) :
+			self.assertEqual( vdb, smoke )
+			self.assertEqual( vdb.findGrid( "density" ).leafCount(), 3117 )
+
+	def tearDown( self ) :
+
+		if os.path.exists( "/tmp/test.scc" ) :
+			os.remove( "/tmp/test.scc" )
 
 if __name__ == "__main__":
 	unittest.main()